@@ -0,0 +1,300 @@
+/*
+ * Tabelanın Modbus register düzeni.
+ *
+ * src/main.cpp (cihaz) ve src/host/ altındaki simülasyon araçları aynı
+ * haritayı kullanır; adresler ve aralıklar sadece burada tanımlanır.
+ * Register anlamları için src/main.cpp başındaki açıklamaya bakınız.
+ */
+
+#ifndef SIGN_REGISTERS_H
+#define SIGN_REGISTERS_H
+
+#include "Arena.h"
+#include "DisplayVm.h"
+#include "RegisterMap.h"
+#include "RtuSlave.h"
+#include "TextFormat.h"
+
+// Modbus RTU yapılandırması
+#define MODBUS_SLAVE_ID 1
+#define MODBUS_BAUD 9600
+
+// Program ve yazı slotu register blokları
+#define REG_PROGRAM_LENGTH 10
+#define REG_PROGRAM_STATUS 11
+#define REG_PROGRAM_BASE   16
+#define REG_TEXT_BASE      80
+#define TEXT_SLOTS         4
+#define TEXT_SLOT_REGS     16
+
+// Dosya aktarımı kontrol register'ları
+#define REG_FILE_NUMBER    144
+#define REG_FILE_SIZE      145
+#define REG_FILE_CRC       147
+#define REG_FILE_COMMAND   148
+#define REG_FILE_STATUS    149
+#define REG_FILE_RECEIVED  150
+
+#define FILE_CMD_BEGIN  1
+#define FILE_CMD_COMMIT 2
+#define FILE_CMD_ABORT  3
+
+// Trafik kaydı (FC20 ile RECORDER_FILE dosyasından okunur)
+#define REG_RECORDER_CONTROL 152
+#define REG_RECORDER_SIZE    153
+#define RECORDER_FILE        100
+
+#define RECORDER_STOP   0
+#define RECORDER_RUN    1
+#define RECORDER_CLEAR  2
+
+// Hat çözümleyici (bkz. BusAnalyzer.h)
+#define REG_ANALYZER_CONTROL 154
+#define REG_ANALYZER_SLAVE   155
+#define REG_ANALYZER_TIMEOUT 156  // yanıt sınırı (ms), master'ın zaman aşımı
+
+#define ANALYZER_OFF    0
+#define ANALYZER_RUN    1
+#define ANALYZER_RESET  2
+
+// Haber bandı (bkz. TickerFeed.h): yazı ve süre yazılır, sonra komut
+#define REG_FEED_COMMAND   157
+#define REG_FEED_TTL       158  // s, 0 = süresiz
+#define REG_FEED_COUNT     159
+#define REG_FEED_TEXT      160
+#define FEED_TEXT_REGS     16
+#define FEED_ITEMS         8
+
+#define FEED_CMD_APPEND  1
+#define FEED_CMD_EXPIRE  2  // en eski mesajı çıkar
+#define FEED_CMD_CLEAR   3
+
+// Slave'in yanıt sınırı (ms, 0 = sınırsız): kuyrukta bundan uzun bekleyen
+// isteğe yanıt verilmez. Master'ın zaman aşımından (SignClient 100 ms)
+// biraz kısa tutulur; yanıtın hatta geçmesi de sürer.
+#define REG_RESPONSE_LIMIT 176
+
+// 32 bitlik sabit noktalı fiyat (üst kelime önce) ve biçimi
+#define REG_PRICE_VALUE    208
+#define REG_PRICE_DECIMALS 210
+#define REG_PRICE_FORMAT   211
+#define REG_PRICE_GRAPH    212
+#define PRICE_MAX_DECIMALS 4
+
+#define PRICE_GROUPING    0x01  // binlik ayırıcı
+#define PRICE_PLUS        0x02  // pozitif değerlerde '+'
+#define PRICE_DOT_DECIMAL 0x04  // "1,499.90" (varsayılan "1.499,90")
+
+// Mod 2'de fiyat geçmişi grafiği (alt bant)
+#define PRICE_GRAPH_OFF   0
+#define PRICE_GRAPH_BARS  1
+#define PRICE_GRAPH_LINE  2
+#define PRICE_HISTORY     32
+
+// Mod 3 geri sayımı: toplam süre (s, 0 = sabit "XXXX sn")
+#define REG_TIME_TOTAL     213
+
+// Dikkat çekme efekti (tüm panel; bölge modunda bölgenin kendi efekti
+// önceliklidir): 0 = yok, 1 = yanıp sönme, 2 = ters, 3 = ters/normal, 4 = flaş
+#define REG_EFFECT         214
+#define REG_EFFECT_PERIOD  215  // ms, 0 = 500
+#define EFFECT_MAX         4
+
+// Fiyat panosu ürün tablosu: girdi başına ad, fiyat, birim, bekleme (s)
+#define REG_BOARD_BASE    216
+#define BOARD_ENTRIES     8
+#define BOARD_ENTRY_REGS  5
+#define BOARD_NAME        0  // 0 = yok, 1.. hazır adlar, 100-103 = yazı slotu
+#define BOARD_PRICE       1  // 32 bit işaretli, üst kelime önce (HR208-209 gibi)
+#define BOARD_UNIT        3  // 0 = yok, 1 = TL, 2 = TL/L, 3 = TL/KG, 4 = TL/AD
+#define BOARD_DWELL       4  // 0 = girdi gösterilmez
+
+// Program modundan okunabilen register'lar (BREQ/BRNE)
+#define VM_REGISTER_COUNT  16
+
+// Program modu: içerik ekran programı tarafından seçilir
+#define MODE_PROGRAM 4
+
+// Bölge modu: her bölge kendi slave adresinden yönetilir
+#define MODE_ZONES 5
+#define ZONE_COUNT 2
+#define ZONE_SLAVE_BASE (MODBUS_SLAVE_ID + 1)
+
+// Haber bandı modu: kuyruktaki mesajlar tek akışta kayar
+#define MODE_FEED 6
+
+// Fiyat panosu modu: ürün tablosundaki girdiler sırayla gösterilir
+#define MODE_BOARD 7
+
+// Bölge bankası register'ları
+#define ZREG_CONTENT    0
+#define ZREG_VALUE      1
+#define ZREG_TEXT       2
+#define ZONE_TEXT_REGS  8
+#define ZREG_EFFECT     (ZREG_TEXT + ZONE_TEXT_REGS)
+#define ZREG_EFFECT_PERIOD (ZREG_EFFECT + 1)
+#define ZREG_SPEED      (ZREG_EFFECT_PERIOD + 1)
+#define ZONE_REG_COUNT  (ZREG_SPEED + 1)
+
+// Bölge içeriği: kayan yazı (ZREG_SPEED = adım aralığı, ms)
+#define ZONE_CONTENT_SCROLL 4
+
+// Bellek havuzu istatistikleri (input register). Adresler sabit kalsın diye
+// 4 sınıflık yer ayrılır; olmayan sınıfların register'ları 0 okunur.
+#define IREG_ARENA_BASE     0
+#define IREG_ARENA_CLASSES  4
+#define IREG_ARENA_FAILURES (IREG_ARENA_BASE + IREG_ARENA_CLASSES * 2)
+static_assert(Arena::CLASS_COUNT <= IREG_ARENA_CLASSES, "Havuz sinif sayisi register alanini asiyor");
+
+// RS485 port sayaçları (input register)
+#define IREG_RX_OVERRUNS      (IREG_ARENA_FAILURES + 1)
+#define IREG_RX_FRAMING       (IREG_RX_OVERRUNS + 1)
+#define IREG_TURNAROUND       (IREG_RX_FRAMING + 1)
+#define IREG_TURNAROUND_MAX   (IREG_TURNAROUND + 1)
+#define IREG_DE_RELEASE_MAX   (IREG_TURNAROUND_MAX + 1)
+
+// İstek sınıfı başına kuyruk gecikmesi (son, en büyük; 0.1 ms)
+#define IREG_QUEUE_DELAY      (IREG_DE_RELEASE_MAX + 1)
+
+// Hat çözümleyici: pencere ve hat geneli, sonra REG_ANALYZER_SLAVE'in sayaçları
+#define IREG_BUS_UTILIZATION  (IREG_QUEUE_DELAY + RtuSlave::CLASS_COUNT * 2)  // binde
+#define IREG_BUS_FRAMES       (IREG_BUS_UTILIZATION + 1)  // pencerede
+#define IREG_BUS_GAP_MAX      (IREG_BUS_FRAMES + 1)       // pencerede, 0.1 ms
+#define IREG_BUS_GAP_AVG      (IREG_BUS_GAP_MAX + 1)      // 0.1 ms
+#define IREG_BUS_CRC_ERRORS   (IREG_BUS_GAP_AVG + 1)
+#define IREG_BUS_SLAVES       (IREG_BUS_CRC_ERRORS + 1)
+#define IREG_SLAVE_BASE       (IREG_BUS_SLAVES + 1)
+#define SLAVE_REQUESTS        0
+#define SLAVE_RESPONSES       1
+#define SLAVE_TIMEOUTS        2
+#define SLAVE_RETRIES         3
+#define SLAVE_EXCEPTIONS      4
+#define SLAVE_RESPONSE_LAST   5   // 0.1 ms
+#define SLAVE_RESPONSE_AVG    6
+#define SLAVE_RESPONSE_MAX    7
+#define SLAVE_LATE            8
+#define SLAVE_REG_COUNT       9
+
+// Register yazılınca tetiklenen eylemler (RegisterTable::applyWrite bitleri)
+enum RegisterAction : uint8_t {
+    ACT_NONE = 0,
+    ACT_DISPLAY,       // ekran parametreleri
+    ACT_PROGRAM,       // program yükle
+    ACT_TEXTS,         // yazı slotlarını çöz
+    ACT_FILE_COMMAND,  // dosya komutunu uygula
+    ACT_RECORDER,      // trafik kaydını başlat / durdur
+    ACT_ANALYZER,      // hat çözümleyiciyi aç / kapat
+    ACT_FEED,          // haber bandı komutu
+    ACT_BOARD,         // ürün tablosu girdisi
+    ACT_PRICE,         // tek register'lık fiyat: 32 bitlik fiyata aktar
+    ACT_PRICE_FORMAT,  // fiyat biçimi: fiyatlar yeniden çizilir
+    ACT_TIME,          // zaman: geri sayım baştan başlar
+    ACT_EFFECT,        // efekt: sadece tarama ayarlanır, çizim yok
+    ACT_RESPONSE_LIMIT // slave'in yanıt sınırı
+};
+
+// Register haritası: banka boyutları, aralık kırpma ve yazma dağıtımı bu
+// tablodan derleme zamanında üretilir (bkz. RegisterMap.h)
+inline constexpr RegisterDef SIGN_REGISTERS[] = {
+    // adres, adet, tür, min, max, eylem, başlangıç[, 0 serbest]
+    { 0, 1, REG_HOLDING, 0, MODE_BOARD, ACT_DISPLAY, 1 },           // mod
+    { 1, 1, REG_HOLDING, 50, 500, ACT_DISPLAY, 100 },               // kayma hızı (ms)
+    { 2, 1, REG_HOLDING, -32768, 32767, ACT_PRICE, 1500 },          // fiyat (TL)
+    { 3, 1, REG_HOLDING, -32768, 32767, ACT_TIME, 60 },             // zaman (sn)
+    { 4, 1, REG_HOLDING, 0, 64, ACT_DISPLAY, 16 },                  // kayma boşluğu (piksel)
+    { REG_PROGRAM_LENGTH, 1, REG_HOLDING, 0, 0xFFFF, ACT_PROGRAM, 0 },
+    { REG_PROGRAM_STATUS, 1, REG_HOLDING, 0, 0xFFFF, ACT_NONE, 0 },
+    { REG_PROGRAM_BASE, DisplayVm::MAX_WORDS, REG_HOLDING, 0, 0xFFFF, ACT_NONE, 0 },
+    { REG_TEXT_BASE, TEXT_SLOTS * TEXT_SLOT_REGS, REG_HOLDING, 0, 0xFFFF, ACT_TEXTS, 0 },
+    { REG_FILE_NUMBER, 1, REG_HOLDING, 0, 0xFFFF, ACT_NONE, 0 },
+    { REG_FILE_SIZE, 2, REG_HOLDING, 0, 0xFFFF, ACT_NONE, 0 },
+    { REG_FILE_CRC, 1, REG_HOLDING, 0, 0xFFFF, ACT_NONE, 0 },
+    { REG_FILE_COMMAND, 1, REG_HOLDING, 0, FILE_CMD_ABORT, ACT_FILE_COMMAND, 0 },
+    { REG_FILE_STATUS, 1, REG_HOLDING, 0, 0xFFFF, ACT_NONE, 0 },
+    { REG_FILE_RECEIVED, 2, REG_HOLDING, 0, 0xFFFF, ACT_NONE, 0 },
+    { REG_RECORDER_CONTROL, 1, REG_HOLDING, 0, RECORDER_CLEAR, ACT_RECORDER, 0 },
+    { REG_RECORDER_SIZE, 1, REG_HOLDING, 0, 0xFFFF, ACT_NONE, 0 },
+    { REG_ANALYZER_CONTROL, 1, REG_HOLDING, 0, ANALYZER_RESET, ACT_ANALYZER, 0 },
+    { REG_ANALYZER_SLAVE, 1, REG_HOLDING, 0, 247, ACT_NONE, 0 },
+    { REG_ANALYZER_TIMEOUT, 1, REG_HOLDING, 10, 10000, ACT_ANALYZER, 1000 },
+    { REG_FEED_COMMAND, 1, REG_HOLDING, 0, FEED_CMD_CLEAR, ACT_FEED, 0 },
+    { REG_FEED_TTL, 1, REG_HOLDING, 0, 0xFFFF, ACT_NONE, 0 },
+    { REG_FEED_COUNT, 1, REG_HOLDING, 0, 0xFFFF, ACT_NONE, 0 },
+    { REG_FEED_TEXT, FEED_TEXT_REGS, REG_HOLDING, 0, 0xFFFF, ACT_NONE, 0 },
+    { REG_RESPONSE_LIMIT, 1, REG_HOLDING, 0, 10000, ACT_RESPONSE_LIMIT, 80 },
+    { REG_PRICE_VALUE, 1, REG_HOLDING, 0, 0xFFFF, ACT_DISPLAY, 0 },           // fiyat, üst kelime
+    { REG_PRICE_VALUE + 1, 1, REG_HOLDING, 0, 0xFFFF, ACT_DISPLAY, 1500 },    // fiyat, alt kelime
+    { REG_PRICE_DECIMALS, 1, REG_HOLDING, 0, PRICE_MAX_DECIMALS, ACT_PRICE_FORMAT, 0 },
+    { REG_PRICE_FORMAT, 1, REG_HOLDING, 0, 0x07, ACT_PRICE_FORMAT, 0 },
+    { REG_PRICE_GRAPH, 1, REG_HOLDING, 0, PRICE_GRAPH_LINE, ACT_DISPLAY, PRICE_GRAPH_OFF },
+    { REG_TIME_TOTAL, 1, REG_HOLDING, 0, 32767, ACT_DISPLAY, 0 },
+    { REG_EFFECT, 1, REG_HOLDING, 0, EFFECT_MAX, ACT_EFFECT, 0 },
+    { REG_EFFECT_PERIOD, 1, REG_HOLDING, 0, 10000, ACT_EFFECT, 0 },
+    { REG_BOARD_BASE, BOARD_ENTRIES * BOARD_ENTRY_REGS, REG_HOLDING, 0, 0xFFFF, ACT_BOARD, 0 },
+    { IREG_ARENA_BASE, IREG_ARENA_CLASSES * 2, REG_INPUT, 0, 0xFFFF, ACT_NONE, 0 },
+    { IREG_ARENA_FAILURES, 1, REG_INPUT, 0, 0xFFFF, ACT_NONE, 0 },
+    { IREG_RX_OVERRUNS, 1, REG_INPUT, 0, 0xFFFF, ACT_NONE, 0 },
+    { IREG_RX_FRAMING, 1, REG_INPUT, 0, 0xFFFF, ACT_NONE, 0 },
+    { IREG_TURNAROUND, 1, REG_INPUT, 0, 0xFFFF, ACT_NONE, 0 },      // us
+    { IREG_TURNAROUND_MAX, 1, REG_INPUT, 0, 0xFFFF, ACT_NONE, 0 },  // us
+    { IREG_DE_RELEASE_MAX, 1, REG_INPUT, 0, 0xFFFF, ACT_NONE, 0 },  // us
+    { IREG_QUEUE_DELAY, RtuSlave::CLASS_COUNT * 2, REG_INPUT, 0, 0xFFFF, ACT_NONE, 0 },
+    { IREG_BUS_UTILIZATION, IREG_SLAVE_BASE - IREG_BUS_UTILIZATION, REG_INPUT, 0, 0xFFFF, ACT_NONE, 0 },
+    { IREG_SLAVE_BASE, SLAVE_REG_COUNT, REG_INPUT, 0, 0xFFFF, ACT_NONE, 0 },
+};
+
+typedef RegisterTable<SIGN_REGISTERS, sizeof(SIGN_REGISTERS) / sizeof(SIGN_REGISTERS[0])> SignRegisters;
+
+// Bölge bankası (her bölge slave'inin kendi tablosu)
+inline constexpr RegisterDef ZONE_REGISTERS[] = {
+    // adres, adet, tür, min, max, eylem, başlangıç[, 0 serbest]
+    { ZREG_CONTENT, 1, REG_HOLDING, 0, ZONE_CONTENT_SCROLL, ACT_DISPLAY, 0 },
+    { ZREG_VALUE, 1, REG_HOLDING, -32768, 32767, ACT_DISPLAY, 0 },       // fiyat (TL) / zaman (sn)
+    { ZREG_TEXT, ZONE_TEXT_REGS, REG_HOLDING, 0, 0xFFFF, ACT_DISPLAY, 0 },
+    { ZREG_EFFECT, 1, REG_HOLDING, 0, EFFECT_MAX, ACT_EFFECT, 0 },       // 0 = ana slave'inki
+    { ZREG_EFFECT_PERIOD, 1, REG_HOLDING, 0, 10000, ACT_EFFECT, 0 },     // ms, 0 = 500
+    { ZREG_SPEED, 1, REG_HOLDING, 20, 1000, ACT_DISPLAY, 0, true },      // ms, 0 = ana slave'in HR1'i
+};
+
+typedef RegisterTable<ZONE_REGISTERS, sizeof(ZONE_REGISTERS) / sizeof(ZONE_REGISTERS[0])> ZoneRegisters;
+static_assert(ZoneRegisters::HOLDING_COUNT == ZONE_REG_COUNT, "Bolge tablosu ZREG_* duzeniyle uyusmuyor");
+
+// 32 bitlik fiyat (HR208-209)
+inline int32_t fixedPrice(const SignRegisters &regs) {
+    return (int32_t)(((uint32_t)regs.holding[REG_PRICE_VALUE] << 16) | regs.holding[REG_PRICE_VALUE + 1]);
+}
+
+// Ürün tablosu girdisinin fiyatı ('entry' girdinin ilk register'ı)
+inline int32_t boardPrice(const uint16_t *entry) {
+    return (int32_t)(((uint32_t)entry[BOARD_PRICE] << 16) | entry[BOARD_PRICE + 1]);
+}
+
+// HR2 tam TL'dir; HR208-209'a ondalık basamak sayısına göre ölçeklenerek
+// aktarılır (tek register yazan master'lar için)
+inline int32_t legacyPrice(const SignRegisters &regs) {
+    int32_t value = regs.value(2);
+    for (int32_t d = regs.value(REG_PRICE_DECIMALS); d > 0; d--) {
+        value *= 10;
+    }
+    return value;
+}
+
+// Fiyat biçimi (HR210-211)
+inline FixedFormat priceFormat(const SignRegisters &regs) {
+    uint16_t flags = regs.holding[REG_PRICE_FORMAT];
+    FixedFormat f;
+    f.decimals = regs.holding[REG_PRICE_DECIMALS];
+    f.decimalMark = flags & PRICE_DOT_DECIMAL ? '.' : ',';
+    f.groupMark = flags & PRICE_GROUPING ? (flags & PRICE_DOT_DECIMAL ? ',' : '.') : '\0';
+    f.plusSign = flags & PRICE_PLUS;
+    return f;
+}
+
+// Ürün tablosunun hazır adları ve birimleri (register değeri = indeks)
+inline constexpr const char *PRODUCT_NAMES[] = {
+    "", "BENZIN", "DIZEL", "LPG", "EKMEK", "SUT", "SEKER", "UN", "YAG"
+};
+inline constexpr const char *PRODUCT_UNITS[] = { "", " TL", " TL/L", " TL/KG", " TL/AD" };
+#define PRODUCT_NAME_SLOT 100
+
+#endif
@@ -0,0 +1,101 @@
+#include "Arena.h"
+
+alignas(4) static uint8_t storage[Arena::totalBytes()];
+
+Arena arena;
+
+Arena::Arena() : failCount(0), badFreeCount(0) {
+    static_assert(countsFit(), "Sinif blok sayisi MAX_BLOCKS'u asiyor");
+    for (uint8_t c = 0; c < CLASS_COUNT; c++) {
+        freeTop[c] = BLOCK_COUNTS[c];
+        highWater[c] = 0;
+        inUse[c] = 0;
+        for (uint8_t i = 0; i < BLOCK_COUNTS[c]; i++) {
+            // Düşük indeksler önce verilsin diye ters sırada
+            freeStack[c][i] = BLOCK_COUNTS[c] - 1 - i;
+        }
+    }
+}
+
+uint8_t *Arena::classBase(uint8_t cls) const {
+    uint8_t *base = storage;
+    for (uint8_t c = 0; c < cls; c++) {
+        base += (size_t)BLOCK_SIZES[c] * BLOCK_COUNTS[c];
+    }
+    return base;
+}
+
+int8_t Arena::classOf(const void *p) const {
+    const uint8_t *ptr = (const uint8_t *)p;
+    const uint8_t *base = storage;
+    for (uint8_t c = 0; c < CLASS_COUNT; c++) {
+        const uint8_t *end = base + (size_t)BLOCK_SIZES[c] * BLOCK_COUNTS[c];
+        if (ptr >= base && ptr < end) {
+            return c;
+        }
+        base = end;
+    }
+    return -1;
+}
+
+void *Arena::alloc(size_t size) {
+    uint8_t first = 0;
+    while (first < CLASS_COUNT && size > BLOCK_SIZES[first]) {
+        first++;
+    }
+    // Sınıf doluysa en fazla bir büyüğüne taşar
+    for (uint8_t c = first; c < CLASS_COUNT && c <= first + 1; c++) {
+        if (freeTop[c] == 0) {
+            continue;
+        }
+        uint8_t idx = freeStack[c][--freeTop[c]];
+        inUse[c] |= 1U << idx;
+        uint8_t used = BLOCK_COUNTS[c] - freeTop[c];
+        if (used > highWater[c]) {
+            highWater[c] = used;
+        }
+        return classBase(c) + (size_t)idx * BLOCK_SIZES[c];
+    }
+    failCount++;
+    return nullptr;
+}
+
+void Arena::free(void *p) {
+    int8_t c = classOf(p);
+    if (c < 0) {
+        return;
+    }
+    size_t offset = (uint8_t *)p - classBase(c);
+    uint8_t idx = offset / BLOCK_SIZES[c];
+    // Aynı blok yığına iki kez girerse iki sahibe verilir
+    if (offset % BLOCK_SIZES[c] != 0 || !(inUse[c] & (1U << idx))) {
+        badFreeCount++;
+        return;
+    }
+    inUse[c] &= ~(1U << idx);
+    freeStack[c][freeTop[c]++] = idx;
+}
+
+size_t Arena::capacity(const void *p) const {
+    int8_t c = classOf(p);
+    return c < 0 ? 0 : BLOCK_SIZES[c];
+}
+
+Arena::ClassStats Arena::stats(uint8_t cls) const {
+    ClassStats s = { 0, 0, 0, 0 };
+    if (cls < CLASS_COUNT) {
+        s.blockSize = BLOCK_SIZES[cls];
+        s.blocks = BLOCK_COUNTS[cls];
+        s.used = BLOCK_COUNTS[cls] - freeTop[cls];
+        s.highWater = highWater[cls];
+    }
+    return s;
+}
+
+size_t Arena::bytesUsed() const {
+    size_t total = 0;
+    for (uint8_t c = 0; c < CLASS_COUNT; c++) {
+        total += (size_t)BLOCK_SIZES[c] * (BLOCK_COUNTS[c] - freeTop[c]);
+    }
+    return total;
+}
@@ -0,0 +1,88 @@
+/*
+ * Sabit boyut sınıflı statik bellek havuzu.
+ *
+ * Yazı slotları için kullanılır (kayan yazı şeritleri ve glif tamponları
+ * kendi nesnelerinde statik dizilerdir). Tüm bellek derleme zamanında ayrılır;
+ * içerik ne kadar değişirse değişsin sistem heap'i parçalanmaz. Her sınıf
+ * kendi boş blok yığınını tutar, alloc() ve free() O(1)'dir. Kullanımdaki
+ * bloklar bit maskesiyle izlenir; iki kez ya da blok ortasından
+ * serbest bırakma reddedilir.
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+class Arena {
+public:
+    static const uint8_t CLASS_COUNT = 2;
+    static const uint8_t MAX_BLOCKS = 16;
+
+    struct ClassStats {
+        uint16_t blockSize;
+        uint8_t blocks;
+        uint8_t used;
+        uint8_t highWater;
+    };
+
+    Arena();
+
+    // 'size' baytı alan en küçük sınıftan blok verir; yer yoksa nullptr
+    void *alloc(size_t size);
+
+    // nullptr ve havuz dışı işaretçiler yok sayılır; boş bloğu ya da blok
+    // ortasını gösteren işaretçi reddedilir (badFrees() sayar)
+    void free(void *p);
+
+    // Bloğun gerçek kapasitesi (havuz dışı için 0)
+    size_t capacity(const void *p) const;
+
+    ClassStats stats(uint8_t cls) const;
+    uint16_t failures() const { return failCount; }
+    uint16_t badFrees() const { return badFreeCount; }
+    size_t bytesUsed() const;
+
+    // Havuzun toplam boyutu (bayt), sınıf tablolarından
+    static constexpr size_t totalBytes() {
+        size_t total = 0;
+        for (uint8_t c = 0; c < CLASS_COUNT; c++) {
+            total += (size_t)BLOCK_SIZES[c] * BLOCK_COUNTS[c];
+        }
+        return total;
+    }
+
+private:
+    // Boyut sınıfları: kısa yazılar (31 karaktere kadar), uzun yazılar (32
+    // karakterlik slot + sonlandırıcı). loadTexts() eski bloğu yenisini
+    // aldıktan sonra bırakır; 4 slot için en fazla 5 blok aynı anda
+    // kullanılır, sınıf başına 5 blok yeter.
+    static constexpr uint16_t BLOCK_SIZES[CLASS_COUNT] = { 32, 64 };
+    static constexpr uint8_t BLOCK_COUNTS[CLASS_COUNT] = { 5, 5 };
+
+    static constexpr bool countsFit() {
+        for (uint8_t c = 0; c < CLASS_COUNT; c++) {
+            if (BLOCK_COUNTS[c] > MAX_BLOCKS) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Sınıf başına boş blok indeksleri (yığın)
+    uint8_t freeStack[CLASS_COUNT][MAX_BLOCKS];
+    uint8_t freeTop[CLASS_COUNT];
+    uint8_t highWater[CLASS_COUNT];
+    uint16_t inUse[CLASS_COUNT];  // blok başına bir bit (MAX_BLOCKS <= 16)
+    uint16_t failCount;
+    uint16_t badFreeCount;
+
+    int8_t classOf(const void *p) const;
+    uint8_t *classBase(uint8_t cls) const;
+};
+
+// Projedeki tek havuz
+extern Arena arena;
+
+#endif
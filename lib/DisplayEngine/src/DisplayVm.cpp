@@ -0,0 +1,185 @@
+#include "DisplayVm.h"
+
+const DisplayVm::OpInfo DisplayVm::OPS[OP_COUNT] = {
+    { &DisplayVm::opHalt, 0 },
+    { &DisplayVm::opShow, 0 },
+    { &DisplayVm::opScroll, 1 },
+    { &DisplayVm::opWait, 1 },
+    { &DisplayVm::opBranchEq, 2 },
+    { &DisplayVm::opBranchNe, 2 },
+    { &DisplayVm::opJump, 1 },
+    { &DisplayVm::opBright, 0 },
+    { &DisplayVm::opMode, 0 },
+};
+
+DisplayVm::DisplayVm(DisplayVmHost &host, uint8_t textSlots, uint8_t registerCount)
+    : host(host), textSlots(textSlots), registerCount(registerCount),
+      length(0), pc(0), waitStart(0), waitMs(0), now(0) {}
+
+// 'b' ilk ek kelimedir (yoksa 0)
+bool DisplayVm::validOperand(uint8_t op, uint8_t a, uint16_t b) const {
+    switch (op) {
+        case OP_SHOW:
+            return a < textSlots;
+        case OP_SCROLL:
+            return a < textSlots && b >= SCROLL_MIN_MS && b <= SCROLL_MAX_MS;
+        case OP_BREQ:
+        case OP_BRNE:
+            return a < registerCount;
+        case OP_MODE:
+            return a <= 3;
+        default:
+            return true;
+    }
+}
+
+DisplayVm::LoadStatus DisplayVm::load(const uint16_t *words, uint8_t count, uint8_t *errorAddr) {
+    // Kelime adresi -> komut indeksi (komut ortasına atlamayı yakalamak için)
+    uint8_t indexOf[MAX_WORDS];
+    uint8_t n = 0;
+    uint8_t addr = 0;
+
+    unload();
+    if (errorAddr) {
+        *errorAddr = 0;
+    }
+    if (count == 0) {
+        return LOAD_EMPTY;
+    }
+    if (count > MAX_WORDS) {
+        return LOAD_TOO_LONG;
+    }
+
+    // 1. geçiş: opcode, operand ve uzunluk kontrolü
+    while (addr < count) {
+        uint8_t op = words[addr] >> 8;
+        uint8_t a = words[addr] & 0xFF;
+        LoadStatus err = LOAD_OK;
+
+        if (op >= OP_COUNT) {
+            err = LOAD_BAD_OPCODE;
+        } else if (addr + 1 + OPS[op].extraWords > count) {
+            err = LOAD_TRUNCATED;
+        } else if (!validOperand(op, a, OPS[op].extraWords > 0 ? words[addr + 1] : 0)) {
+            err = LOAD_BAD_OPERAND;
+        }
+        if (err != LOAD_OK) {
+            if (errorAddr) {
+                *errorAddr = addr;
+            }
+            return err;
+        }
+
+        Instr &ins = code[n];
+        ins.fn = OPS[op].fn;
+        ins.a = a;
+        ins.b = OPS[op].extraWords > 0 ? words[addr + 1] : 0;
+        ins.c = OPS[op].extraWords > 1 ? words[addr + 2] : 0;
+        if (op == OP_JUMP) {
+            ins.c = ins.b;
+        }
+
+        for (uint8_t i = 0; i <= OPS[op].extraWords; i++) {
+            indexOf[addr + i] = (i == 0) ? n : 0xFF;
+        }
+        addr += 1 + OPS[op].extraWords;
+        n++;
+    }
+
+    // 2. geçiş: atlama hedeflerini komut indeksine çevir
+    addr = 0;
+    for (uint8_t i = 0; i < n; i++) {
+        uint8_t op = words[addr] >> 8;
+        if (op == OP_BREQ || op == OP_BRNE || op == OP_JUMP) {
+            uint16_t target = code[i].c;
+            if (target >= count || indexOf[target] == 0xFF) {
+                if (errorAddr) {
+                    *errorAddr = addr;
+                }
+                return LOAD_BAD_TARGET;
+            }
+            code[i].c = indexOf[target];
+        }
+        addr += 1 + OPS[op].extraWords;
+    }
+
+    length = n;
+    pc = 0;
+    waitMs = 0;
+    return LOAD_OK;
+}
+
+void DisplayVm::unload() {
+    length = 0;
+    pc = 0;
+    waitMs = 0;
+}
+
+void DisplayVm::restart(uint32_t t) {
+    pc = 0;
+    waitMs = 0;
+    waitStart = t;
+}
+
+void DisplayVm::run(uint32_t t) {
+    now = t;
+    if (waitMs > 0) {
+        if (now - waitStart < waitMs) {
+            return;
+        }
+        waitMs = 0;
+    }
+
+    for (uint8_t steps = 0; steps < STEP_BUDGET && pc < length; steps++) {
+        const Instr &ins = code[pc];
+        pc = (this->*ins.fn)(ins);
+        if (waitMs > 0) {
+            break;
+        }
+    }
+}
+
+// Handler'lar bir sonraki komut indeksini döndürür; 'this->pc' hâlâ
+// çalışan komutu gösterir.
+
+uint8_t DisplayVm::opHalt(const Instr &) {
+    return length;
+}
+
+uint8_t DisplayVm::opShow(const Instr &ins) {
+    host.vmShowText(ins.a);
+    return pc + 1;
+}
+
+uint8_t DisplayVm::opScroll(const Instr &ins) {
+    host.vmScrollText(ins.a, ins.b);
+    return pc + 1;
+}
+
+uint8_t DisplayVm::opWait(const Instr &ins) {
+    waitStart = now;
+    waitMs = ins.b;
+    return pc + 1;
+}
+
+uint8_t DisplayVm::opBranchEq(const Instr &ins) {
+    return host.vmReadRegister(ins.a) == ins.b ? ins.c : pc + 1;
+}
+
+uint8_t DisplayVm::opBranchNe(const Instr &ins) {
+    return host.vmReadRegister(ins.a) != ins.b ? ins.c : pc + 1;
+}
+
+uint8_t DisplayVm::opJump(const Instr &ins) {
+    return ins.c;
+}
+
+uint8_t DisplayVm::opBright(const Instr &ins) {
+    host.vmSetBrightness(ins.a);
+    return pc + 1;
+}
+
+uint8_t DisplayVm::opMode(const Instr &ins) {
+    host.vmShowMode(ins.a);
+    return pc + 1;
+}
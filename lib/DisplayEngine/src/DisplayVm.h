@@ -0,0 +1,133 @@
+/*
+ * Ekran programları için küçük bytecode yorumlayıcı.
+ *
+ * Program 16 bitlik kelimelerden oluşur (Modbus register bloğuna birebir
+ * yazılır). İlk kelimenin üst baytı opcode, alt baytı 8 bitlik A
+ * operandıdır; opcode'a göre 0-2 ek kelime gelir:
+ *
+ *   0x00 HALT                       programı durdur
+ *   0x01 SHOW    A=slot             yazı slotunu sabit göster
+ *   0x02 SCROLL  A=slot, hız(ms)    yazı slotunu kaydır (hız 50-500, HR1 gibi)
+ *   0x03 WAIT    süre(ms)           bekle
+ *   0x04 BREQ    A=reg, değer, hedef  register == değer ise atla
+ *   0x05 BRNE    A=reg, değer, hedef  register != değer ise atla
+ *   0x06 JUMP    hedef              koşulsuz atla
+ *   0x07 BRIGHT  A=parlaklık        parlaklığı ayarla
+ *   0x08 MODE    A=mod              hazır modu göster (0-3)
+ *
+ * Hedefler kelime adresidir. load() programı bir kez doğrular ve her
+ * komutu handler işaretçisi + çözülmüş operandlara dönüştürür; çalışma
+ * sırasında opcode çözümü veya sınır kontrolü yapılmaz.
+ */
+
+#ifndef DISPLAY_VM_H
+#define DISPLAY_VM_H
+
+#include <stdint.h>
+
+// Programın ekrana ve register'lara eriştiği arayüz (sketch tarafından sağlanır)
+class DisplayVmHost {
+public:
+    virtual void vmShowText(uint8_t slot) = 0;
+    virtual void vmScrollText(uint8_t slot, uint16_t speedMs) = 0;
+    virtual void vmShowMode(uint8_t mode) = 0;
+    virtual void vmSetBrightness(uint8_t level) = 0;
+    virtual uint16_t vmReadRegister(uint8_t reg) = 0;
+};
+
+class DisplayVm {
+public:
+    static const uint8_t MAX_WORDS = 64;
+    static const uint8_t MAX_INSTRUCTIONS = 64;
+
+    // Bir run() çağrısında en fazla çalıştırılacak komut (WAIT'siz döngülere karşı)
+    static const uint8_t STEP_BUDGET = 32;
+
+    // SCROLL hız aralığı (ms), ana slave'in HR1'i ile aynı
+    static const uint16_t SCROLL_MIN_MS = 50;
+    static const uint16_t SCROLL_MAX_MS = 500;
+
+    enum Opcode {
+        OP_HALT = 0x00,
+        OP_SHOW = 0x01,
+        OP_SCROLL = 0x02,
+        OP_WAIT = 0x03,
+        OP_BREQ = 0x04,
+        OP_BRNE = 0x05,
+        OP_JUMP = 0x06,
+        OP_BRIGHT = 0x07,
+        OP_MODE = 0x08,
+        OP_COUNT
+    };
+
+    enum LoadStatus {
+        LOAD_OK = 0,
+        LOAD_EMPTY = 1,
+        LOAD_TOO_LONG = 2,
+        LOAD_BAD_OPCODE = 3,
+        LOAD_TRUNCATED = 4,
+        LOAD_BAD_TARGET = 5,
+        LOAD_BAD_OPERAND = 6
+    };
+
+    DisplayVm(DisplayVmHost &host, uint8_t textSlots, uint8_t registerCount);
+
+    // Programı doğrula ve çöz. Hata varsa eski program silinir.
+    // errorAddr hatalı kelimenin adresini döndürür.
+    LoadStatus load(const uint16_t *words, uint8_t count, uint8_t *errorAddr = nullptr);
+
+    void unload();
+
+    // Programı baştan başlat
+    void restart(uint32_t now);
+
+    // Bekleme bitmişse bir sonraki bekleme/HALT'a kadar çalıştır
+    void run(uint32_t now);
+
+    bool loaded() const { return length > 0; }
+    bool halted() const { return pc >= length; }
+
+private:
+    struct Instr;
+    typedef uint8_t (DisplayVm::*Handler)(const Instr &ins);
+
+    struct Instr {
+        Handler fn;
+        uint8_t a;
+        uint16_t b;
+        uint16_t c;  // atlama komutlarında çözülmüş komut indeksi
+    };
+
+    struct OpInfo {
+        Handler fn;
+        uint8_t extraWords;
+    };
+
+    static const OpInfo OPS[OP_COUNT];
+
+    DisplayVmHost &host;
+    uint8_t textSlots;
+    uint8_t registerCount;
+
+    Instr code[MAX_INSTRUCTIONS];
+    uint8_t length;
+    uint8_t pc;
+
+    uint32_t waitStart;
+    uint16_t waitMs;
+    uint32_t now;
+
+    uint8_t opHalt(const Instr &ins);
+    uint8_t opShow(const Instr &ins);
+    uint8_t opScroll(const Instr &ins);
+    uint8_t opWait(const Instr &ins);
+    uint8_t opBranchEq(const Instr &ins);
+    uint8_t opBranchNe(const Instr &ins);
+    uint8_t opJump(const Instr &ins);
+    uint8_t opBright(const Instr &ins);
+    uint8_t opMode(const Instr &ins);
+
+    bool validOperand(uint8_t op, uint8_t a, uint16_t b) const;
+};
+
+#endif
@@ -0,0 +1,217 @@
+/*
+ * Kesintisiz kayan yazı.
+ *
+ * Metin bir kez, ardından 'gap' piksel boşlukla dairesel bir şeride çizilir
+ * (satır başına bit dizisi, bit 1 = LED yanık). Her adımda ekran şeridin
+ * 'offset'ten başlayan penceresiyle doldurulur; pencere şeridin sonuna
+ * taşarsa baştan devam eder, yani kuyruğu boşluk ve hemen ardından yazının
+ * başı izler. Glyph çözümlemesi sadece metin değişince yapılır, kopyalama
+ * bayt bayttır (PanelFrame::drawBits).
+ *
+ * Her şeridin kendi adım aralığı vardır; birden çok şerit (ör. bölge başına
+ * bir tane) tek bir Scheduler görevinden update() ile sürülür, zamanı gelen
+ * şerit kendi bandına çizilir. Aralık 0 ise adımı çağıran advance() ile
+ * atar.
+ *
+ * Şerit sabit boyutludur: MAX_COLUMNS'a sığmayan karakterler kesilir.
+ */
+
+#ifndef MARQUEE_H
+#define MARQUEE_H
+
+#include <stdint.h>
+#include <string.h>
+
+// Satır başına bit dizisi olarak tutulan dairesel şerit (Marquee, TickerFeed)
+template <uint16_t MAX_COLUMNS, uint8_t ROWS>
+class BitStrip {
+public:
+    BitStrip() {
+        clear();
+    }
+
+    void clear() {
+        memset(bits, 0, sizeof(bits));
+    }
+
+    // Sütunu maskeyle değiştir (bit k = satır k)
+    void setColumn(uint16_t x, uint32_t column) {
+        uint8_t mask = 0x80 >> (x & 7);
+        for (uint8_t r = 0; r < ROWS; r++) {
+            uint8_t &b = bits[r][x >> 3];
+            if (column & (1UL << r)) {
+                b |= mask;
+            } else {
+                b &= ~mask;
+            }
+        }
+    }
+
+    // Şeridin ilk 'width' sütununu 'offset'ten başlayarak (x, y)'ye 'w'
+    // piksel çiz; width 0 ise bant söndürülür
+    template <class Frame>
+    void draw(Frame &frame, int x, int y, int w, uint16_t offset, uint16_t width) const {
+        for (uint8_t r = 0; r < ROWS; r++) {
+            uint16_t p = offset;
+            for (int dx = 0; dx < w; dx += 8) {
+                uint8_t count = w - dx < 8 ? w - dx : 8;
+                frame.drawBits(x + dx, y + r, width ? bits8(r, p, width) : 0, count);
+                if (width) {
+                    p = (p + 8) % width;
+                }
+            }
+        }
+    }
+
+private:
+    // +1 bayt: hizasız 8 bitlik okuma satır sonunu aşabilir
+    static constexpr uint16_t ROW_BYTES = (MAX_COLUMNS + 7) / 8 + 1;
+
+    uint8_t bits[ROWS][ROW_BYTES];
+
+    // 'p'den başlayan 8 sütun, MSB = en soldaki
+    uint8_t bits8(uint8_t r, uint16_t p, uint16_t width) const {
+        const uint8_t *row = bits[r];
+        if (p + 8 <= width) {
+            uint8_t shift = p & 7;
+            const uint8_t *b = row + (p >> 3);
+            return shift ? (uint8_t)((b[0] << shift) | (b[1] >> (8 - shift))) : b[0];
+        }
+        // Şeridin sonu: kalan sütunlar baştan devam eder
+        uint8_t out = 0;
+        for (uint8_t i = 0; i < 8; i++) {
+            out = (out << 1) | ((row[p >> 3] >> (7 - (p & 7))) & 1);
+            if (++p == width) {
+                p = 0;
+            }
+        }
+        return out;
+    }
+};
+
+// Adım zamanlaması: her şerit kendi aralığında, ortak görevden sorulur
+class StepTimer {
+public:
+    StepTimer() : intervalMs(0), nextMs(0), synced(false) {}
+
+    void setInterval(uint16_t ms) {
+        intervalMs = ms;
+    }
+
+    // Sonraki due() çağrısı saati eşitler (şerit yeniden başlarken)
+    void restart() {
+        synced = false;
+    }
+
+    // Zamanı gelen adım sayısı (kaçırılanlar dahil); aralık 0 ise hep 0
+    uint32_t due(uint32_t nowMs) {
+        if (intervalMs == 0) {
+            return 0;
+        }
+        if (!synced) {
+            synced = true;
+            nextMs = nowMs + intervalMs;
+            return 0;
+        }
+        uint32_t late = nowMs - nextMs;
+        if ((int32_t)late < 0) {
+            return 0;
+        }
+        uint32_t steps = late / intervalMs + 1;
+        nextMs += steps * intervalMs;
+        return steps;
+    }
+
+private:
+    uint16_t intervalMs;
+    uint32_t nextMs;
+    bool synced;
+};
+
+template <uint16_t MAX_COLUMNS, uint8_t ROWS>
+class Marquee {
+public:
+    static constexpr uint8_t MAX_GLYPH_WIDTH = 32;
+
+    Marquee() : width(0), offset(0), gap(0), step(1), running(false) {}
+
+    // Metni şeride çiz ve baştan başlat; ilk karede yazı sol kenardadır
+    template <class Font>
+    void start(const Font &font, const char *text, uint16_t newGap, uint8_t newStep = 1) {
+        strip.clear();
+        uint32_t columns[MAX_GLYPH_WIDTH];
+        uint16_t x = 0;
+        for (; *text; text++) {
+            int w = font.glyphColumns(*text, columns, MAX_GLYPH_WIDTH);
+            if (w == 0) {
+                continue;
+            }
+            if (x + w > MAX_COLUMNS) {
+                break;
+            }
+            for (int j = 0; j < w && j < MAX_GLYPH_WIDTH; j++) {
+                strip.setColumn(x + j, columns[j]);
+            }
+            x += w + 1;
+        }
+        // Son karakterin ardındaki 1 piksel aralık boşluğa sayılmaz (stringWidth ile aynı)
+        uint16_t textColumns = x > 0 ? x - 1 : 0;
+        width = textColumns + newGap < MAX_COLUMNS ? textColumns + newGap : MAX_COLUMNS;
+        offset = 0;
+        gap = newGap;
+        step = newStep;
+        running = width > 0;
+        timer.restart();
+    }
+
+    void setInterval(uint16_t ms) {
+        timer.setInterval(ms);
+    }
+
+    void stop() {
+        running = false;
+    }
+
+    bool active() const { return running; }
+    uint16_t stripWidth() const { return width; }
+    uint16_t position() const { return offset; }
+    uint16_t gapColumns() const { return gap; }
+
+    // Bir adım ilerlet; şeridin sonundan başına özel durum olmadan geçilir
+    void advance() {
+        if (running) {
+            offset = (offset + step) % width;
+        }
+    }
+
+    // Adım zamanı geldiyse ilerlet (kaçırılan adımlar birlikte); yeniden
+    // çizilmesi gerekiyorsa true döner. İlk çağrı sadece saati eşitler.
+    bool update(uint32_t nowMs) {
+        if (!running) {
+            return false;
+        }
+        uint32_t steps = timer.due(nowMs);
+        if (steps == 0) {
+            return false;
+        }
+        offset = (offset + steps % width * step) % width;
+        return true;
+    }
+
+    // Pencereyi (x, y)'den başlayan 'w' piksel genişliğe çiz (ROWS satır)
+    template <class Frame>
+    void draw(Frame &frame, int x, int y, int w) const {
+        strip.draw(frame, x, y, w, offset, running ? width : 0);
+    }
+
+private:
+    BitStrip<MAX_COLUMNS, ROWS> strip;
+    uint16_t width;   // yazı + boşluk
+    uint16_t offset;  // ekranın sol kenarındaki şerit sütunu
+    uint16_t gap;
+    uint8_t step;
+    bool running;
+    StepTimer timer;
+};
+
+#endif
@@ -0,0 +1,254 @@
+/*
+ * P10 panel sürücüsü: PanelFrame + SPI tarama.
+ *
+ * DMD2'deki SPIDMD yerine geçer. Geometri şablon parametresi olduğundan
+ * tarama satırı ofsetleri ve SPI tampon boyutu derleme zamanında bellidir.
+ *
+ * ESP8266'da tarama timer0 kesmesiyle yapılır (timer1 analogWrite/PWM için
+ * boş kalır). Parlaklık, her tarama adımında OE'nin açık kalma süresi ile
+ * ayarlanır: önce satır açılır, 'onCycles' sonra kapatılır.
+ *
+ * Dikkat çekme efektleri (yanıp sönme, ters çevirme) satır bandı başına
+ * tarama sırasında SPI'ye giden bayta uygulanır (XOR ve maske); framebuffer
+ * değişmez, efekt için yeniden çizim yapılmaz. OE kullanılmaz: bir tarama
+ * adımı iki bölgenin satırlarını birlikte sürer.
+ */
+
+#ifndef PANEL_DRIVER_H
+#define PANEL_DRIVER_H
+
+#include <Arduino.h>
+#include <SPI.h>
+
+#include "PanelFrame.h"
+
+// Varsayılan pinler (bağlantı şemasındaki tablo ile aynı)
+#define PANEL_PIN_NOE  4   // D2 - Output Enable
+#define PANEL_PIN_A    16  // D0 - Row Address A
+#define PANEL_PIN_B    5   // D1 - Row Address B
+#define PANEL_PIN_STB  12  // D6 - Strobe/Latch
+
+#ifndef IRAM_ATTR
+#define IRAM_ATTR
+#endif
+
+enum PanelEffect : uint8_t {
+    EFFECT_NONE = 0,
+    EFFECT_BLINK,   // yarı periyot görünür, yarı periyot sönük
+    EFFECT_INVERT,  // sürekli ters
+    EFFECT_FLASH,   // yarı periyot normal, yarı periyot ters
+    EFFECT_STROBE,  // periyodun sadece dörtte biri görünür
+    EFFECT_COUNT
+};
+
+template <class Geometry>
+class PanelDriver : public PanelFrame<Geometry> {
+public:
+    // Bir tarama adımının süresi: 4 satır x 1 ms = 250 Hz yenileme
+    static constexpr uint32_t SCAN_PERIOD_US = 1000;
+
+    PanelDriver(uint8_t pinNoe = PANEL_PIN_NOE, uint8_t pinA = PANEL_PIN_A,
+                uint8_t pinB = PANEL_PIN_B, uint8_t pinStb = PANEL_PIN_STB)
+        : pinNoe(pinNoe), pinA(pinA), pinB(pinB), pinStb(pinStb),
+          scanRow(0), brightness(255), outputOn(false), frameCount(0), effectRows(0) {
+        for (int y = 0; y < Geometry::HEIGHT; y++) {
+            rowEffect[y] = EFFECT_NONE;
+            rowPeriod[y] = 1;
+            rowXor[y] = 0;
+            rowMask[y] = 0xFF;
+        }
+    }
+
+    void begin() {
+        pinMode(pinNoe, OUTPUT);
+        pinMode(pinA, OUTPUT);
+        pinMode(pinB, OUTPUT);
+        pinMode(pinStb, OUTPUT);
+        digitalWrite(pinNoe, LOW);
+
+        SPI.begin();
+        SPI.setBitOrder(MSBFIRST);
+        SPI.setDataMode(SPI_MODE0);
+#if defined(ESP8266)
+        SPI.setFrequency(4000000);
+#else
+        SPI.setClockDivider(SPI_CLOCK_DIV4);
+#endif
+
+        active = this;
+#if defined(ESP8266)
+        noInterrupts();
+        timer0_isr_init();
+        timer0_attachInterrupt(timerIsr);
+        timer0_write(ESP.getCycleCount() + usToCycles(SCAN_PERIOD_US));
+        interrupts();
+#endif
+    }
+
+    // Flash silme/yazma sırasında taramayı durdur: önbellek kapalıyken
+    // kesme flash'taki koda (SPI) dallanmamalı
+    void pause() {
+#if defined(ESP8266)
+        timer0_detachInterrupt();
+#endif
+        digitalWrite(pinNoe, LOW);
+        outputOn = false;
+    }
+
+    void resume() {
+#if defined(ESP8266)
+        timer0_attachInterrupt(timerIsr);
+        timer0_write(ESP.getCycleCount() + usToCycles(SCAN_PERIOD_US));
+#endif
+    }
+
+    void setBrightness(uint8_t level) {
+        brightness = level;
+    }
+
+    // [y, y+h) satırlarına efekt uygula; periyot ms (0 = 500 ms). Bir sonraki
+    // tam taramadan itibaren geçerlidir, aynı periyottaki bantlar birlikte
+    // yanıp söner.
+    void setEffect(int y, int h, PanelEffect effect, uint16_t periodMs) {
+        if (effect >= EFFECT_COUNT) {
+            effect = EFFECT_NONE;
+        }
+        uint32_t frames = (periodMs ? periodMs : 500) * 1000UL / (SCAN_PERIOD_US * Geometry::SCAN);
+        uint16_t period = frames < 2 ? 2 : frames > 0xFFFF ? 0xFFFF : frames;
+        for (int r = y < 0 ? 0 : y; r < y + h && r < Geometry::HEIGHT; r++) {
+            rowEffect[r] = effect;
+            rowPeriod[r] = period;
+        }
+        uint8_t rows = 0;
+        for (int r = 0; r < Geometry::HEIGHT; r++) {
+            rows += rowEffect[r] != EFFECT_NONE;
+        }
+        effectRows = rows;
+    }
+
+    // Bir tarama adımı: 4 satırı kaydır, kilitle, satır adresini seç.
+    // Zamanlayıcı yoksa loop() içinden düzenli çağrılmalıdır.
+    void IRAM_ATTR scanDisplay() {
+        uint8_t out[Geometry::SCAN_BYTES];
+        const uint8_t *bmp = this->bitmap;
+        uint16_t n = 0;
+
+        if (scanRow == 0) {
+            updateEffects();
+        }
+        if (effectRows == 0) {
+            this->scanBytes(scanRow, out);
+        } else {
+            // Sıra scanBytes() ile aynı, bayta efekt uygulanır
+            for (uint16_t i = 0; i < Geometry::ROW_BYTES; i++) {
+                // Zincirde alt paneller aynı satır baytlarının devamındadır
+                uint8_t band = i / (Geometry::WIDTH / 8) * Geometry::PANEL_HEIGHT;
+                for (uint8_t k = Geometry::ROWS_PER_SCAN; k-- > 0;) {
+                    uint8_t y = band + scanRow + k * Geometry::SCAN;
+                    uint8_t b = bmp[Geometry::scanRowOffset(scanRow, k) + i];
+                    out[n++] = ~((b ^ rowXor[y]) & rowMask[y]);
+                }
+            }
+        }
+        SPI.transfer(out, Geometry::SCAN_BYTES);
+
+        digitalWrite(pinNoe, LOW);
+        digitalWrite(pinStb, HIGH);  // Shift register çıkışını kilitle
+        digitalWrite(pinStb, LOW);
+        digitalWrite(pinA, scanRow & 0x01);
+        digitalWrite(pinB, scanRow & 0x02);
+        scanRow = (scanRow + 1) % Geometry::SCAN;
+
+        outputOn = brightness > 0;
+        if (outputOn) {
+            digitalWrite(pinNoe, HIGH);
+        }
+    }
+
+private:
+    uint8_t pinNoe, pinA, pinB, pinStb;
+    volatile uint8_t scanRow;
+    volatile uint8_t brightness;
+    volatile bool outputOn;
+
+    // Efektler: satır başına tür ve periyot (tam tarama sayısı); XOR ve
+    // maske her tam taramanın başında hesaplanır
+    uint32_t frameCount;
+    volatile uint8_t effectRows;
+    volatile uint8_t rowEffect[Geometry::HEIGHT];
+    volatile uint16_t rowPeriod[Geometry::HEIGHT];
+    uint8_t rowXor[Geometry::HEIGHT];
+    uint8_t rowMask[Geometry::HEIGHT];
+
+    void IRAM_ATTR updateEffects() {
+        frameCount++;
+        if (effectRows == 0) {
+            return;
+        }
+        for (int y = 0; y < Geometry::HEIGHT; y++) {
+            uint16_t period = rowPeriod[y];
+            uint16_t phase = frameCount % period;
+            bool first = phase < period / 2;
+            uint8_t x = 0, mask = 0xFF;
+            switch (rowEffect[y]) {
+                case EFFECT_BLINK:
+                    mask = first ? 0xFF : 0;
+                    break;
+                case EFFECT_INVERT:
+                    x = 0xFF;
+                    break;
+                case EFFECT_FLASH:
+                    x = first ? 0 : 0xFF;
+                    break;
+                case EFFECT_STROBE:
+                    mask = phase < period / 4 ? 0xFF : 0;
+                    break;
+                default:
+                    break;
+            }
+            rowXor[y] = x;
+            rowMask[y] = mask;
+        }
+    }
+
+    static PanelDriver *active;
+
+    static constexpr uint32_t usToCycles(uint32_t us) {
+        return us * (F_CPU / 1000000UL);
+    }
+
+#if defined(ESP8266)
+    static void IRAM_ATTR timerIsr() {
+        PanelDriver *d = active;
+        uint32_t next;
+        if (d->outputOn && d->brightness < 255) {
+            // Parlaklık fazı bitti, OE kapat ve adımın kalanını bekle
+            digitalWrite(d->pinNoe, LOW);
+            d->outputOn = false;
+            next = usToCycles(SCAN_PERIOD_US) - onCycles(d->brightness);
+        } else {
+            d->scanDisplay();
+            next = d->outputOn && d->brightness < 255 ? onCycles(d->brightness) : usToCycles(SCAN_PERIOD_US);
+        }
+        timer0_write(ESP.getCycleCount() + next);
+    }
+
+    // Çok kısa fazlar CCOMPARE'ı kaçırabilir, iki faz da en az 20 us sürer
+    static uint32_t IRAM_ATTR onCycles(uint8_t level) {
+        const uint32_t minCycles = usToCycles(20);
+        uint32_t c = usToCycles(SCAN_PERIOD_US) / 255 * level;
+        if (c < minCycles) {
+            return minCycles;
+        }
+        if (c > usToCycles(SCAN_PERIOD_US) - minCycles) {
+            return usToCycles(SCAN_PERIOD_US) - minCycles;
+        }
+        return c;
+    }
+#endif
+};
+
+template <class Geometry>
+PanelDriver<Geometry> *PanelDriver<Geometry>::active = nullptr;
+
+#endif
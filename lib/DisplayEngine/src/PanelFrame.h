@@ -0,0 +1,284 @@
+/*
+ * Sabit geometrili framebuffer ve metin çizimi.
+ *
+ * Bitmap boyutu Geometry::FRAME_BYTES ile derleme zamanında bellidir,
+ * heap kullanılmaz. Bit 1 = LED yanık; panelin ters mantığı tarama
+ * aşamasında uygulanır (bkz. PanelDriver).
+ *
+ * Fontlar DMD2 / FontCreator formatındadır:
+ *   [0..1] boyut (0 = sabit genişlik), [2] genişlik, [3] yükseklik,
+ *   [4] ilk karakter, [5] karakter sayısı, [6..] genişlik tablosu + veri
+ */
+
+#ifndef PANEL_FRAME_H
+#define PANEL_FRAME_H
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#else
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#endif
+
+#ifndef IRAM_ATTR
+#define IRAM_ATTR
+#endif
+
+#include "PanelGeometry.h"
+
+template <class Geometry>
+class PanelFrame {
+public:
+    typedef Geometry Geo;
+
+    static constexpr int width() { return Geometry::WIDTH; }
+    static constexpr int height() { return Geometry::HEIGHT; }
+
+    PanelFrame() : font(nullptr) {
+        clearScreen();
+    }
+
+    void clearScreen() {
+        memset(bitmap, 0, Geometry::FRAME_BYTES);
+    }
+
+    void fillScreen() {
+        memset(bitmap, 0xFF, Geometry::FRAME_BYTES);
+    }
+
+    // Önceden çizilmiş bir kareyi olduğu gibi al (bkz. SlideDeck.h)
+    void copyFrom(const PanelFrame &other) {
+        memcpy(bitmap, other.bitmap, Geometry::FRAME_BYTES);
+    }
+
+    // Dikdörtgen bölgeyi söndür (ekran bölgeleri için)
+    void clearRect(int x, int y, int w, int h) {
+        for (int j = y; j < y + h; j++) {
+            for (int i = x; i < x + w; i++) {
+                setPixel(i, j, false);
+            }
+        }
+    }
+
+    void setPixel(int x, int y, bool on = true) {
+        if ((unsigned)x >= (unsigned)Geometry::WIDTH || (unsigned)y >= (unsigned)Geometry::HEIGHT) {
+            return;
+        }
+        uint8_t &b = bitmap[Geometry::byteIndex(x, y)];
+        if (on) {
+            b |= Geometry::bitMask(x);
+        } else {
+            b &= ~Geometry::bitMask(x);
+        }
+    }
+
+    bool getPixel(int x, int y) const {
+        if ((unsigned)x >= (unsigned)Geometry::WIDTH || (unsigned)y >= (unsigned)Geometry::HEIGHT) {
+            return false;
+        }
+        return bitmap[Geometry::byteIndex(x, y)] & Geometry::bitMask(x);
+    }
+
+    void selectFont(const uint8_t *newFont) {
+        font = newFont;
+    }
+
+    int fontHeight() const {
+        return font ? fontByte(3) : 0;
+    }
+
+    int charWidth(char c) const {
+        if (!font) {
+            return 0;
+        }
+        uint8_t first = fontByte(4);
+        uint8_t count = fontByte(5);
+        uint8_t code = (uint8_t)c;
+        if (code < first || code >= first + count) {
+            return 0;
+        }
+        if (isFixedWidth()) {
+            return fontByte(2);
+        }
+        return fontByte(6 + code - first);
+    }
+
+    // Karakterler arasında 1 piksel boşluk bırakılır (DMD2 ile aynı)
+    int stringWidth(const char *str) const {
+        int w = 0;
+        for (; *str; str++) {
+            w += charWidth(*str) + 1;
+        }
+        return w > 0 ? w - 1 : 0;
+    }
+
+    int drawChar(int x, int y, char c) {
+        int w = charWidth(c);
+        if (w == 0) {
+            return 0;
+        }
+        // Ekran dışındaki karakterleri hiç çözümleme (kayan yazıda çoğunluk)
+        if (x >= Geometry::WIDTH || x + w <= 0) {
+            return w;
+        }
+
+        uint8_t h = fontByte(3);
+        uint16_t index = glyphOffset((uint8_t)c, (h + 7) / 8);
+
+        for (int j = 0; j < w; j++) {
+            int px = x + j;
+            if ((unsigned)px >= (unsigned)Geometry::WIDTH) {
+                continue;
+            }
+            uint32_t column = glyphColumn(index, w, h, j);
+            for (uint8_t row = 0; row < h; row++) {
+                setPixel(px, y + row, column & (1UL << row));
+            }
+        }
+        return w;
+    }
+
+    // Karakteri sütun maskelerine çöz (bit k = satır k), en fazla 'max'
+    // sütun yazılır; karakter genişliği döner (bkz. Marquee.h)
+    int glyphColumns(char c, uint32_t *columns, int max) const {
+        int w = charWidth(c);
+        if (w == 0) {
+            return 0;
+        }
+        uint8_t h = fontByte(3);
+        uint16_t index = glyphOffset((uint8_t)c, (h + 7) / 8);
+        for (int j = 0; j < w && j < max; j++) {
+            columns[j] = glyphColumn(index, w, h, j);
+        }
+        return w;
+    }
+
+    // 'x'ten başlayan 'count' pikseli 'bits'in üst bitlerinden yaz; hizalı
+    // x'te tek bayt, değilse iki bayt güncellenir (şerit kopyalama)
+    void drawBits(int x, int y, uint8_t bits, uint8_t count = 8) {
+        if ((unsigned)y >= (unsigned)Geometry::HEIGHT || x >= Geometry::WIDTH || x <= -8) {
+            return;
+        }
+        uint8_t mask = (uint8_t)(0xFF << (8 - count));
+        if (x < 0) {
+            mask <<= -x;
+            bits <<= -x;
+            x = 0;
+        }
+        if (x + 8 > Geometry::WIDTH) {
+            mask &= (uint8_t)(0xFF << (x + 8 - Geometry::WIDTH));
+        }
+        bits &= mask;
+
+        uint8_t shift = x & 7;
+        uint8_t &b0 = bitmap[Geometry::byteIndex(x, y)];
+        b0 = (b0 & ~(mask >> shift)) | (bits >> shift);
+        if (shift && x - shift + 8 < Geometry::WIDTH) {
+            uint8_t &b1 = bitmap[Geometry::byteIndex(x - shift + 8, y)];
+            b1 = (b1 & ~(uint8_t)(mask << (8 - shift))) | (uint8_t)(bits << (8 - shift));
+        }
+    }
+
+    // Bölgeyi bir sütun sola kaydır, en sağ sütun söndürülür; bayt bayt
+    // kopyalanır (bkz. Sparkline.h)
+    void shiftLeft(int x, int y, int w, int h) {
+        for (int j = y; j < y + h; j++) {
+            for (int dx = 0; dx < w; dx += 8) {
+                uint8_t count = w - dx < 8 ? w - dx : 8;
+                drawBits(x + dx, j, readBits(x + dx + 1, j), count);
+            }
+            setPixel(x + w - 1, j, false);
+        }
+    }
+
+    int drawString(int x, int y, const char *str) {
+        for (; *str; str++) {
+            if (x >= Geometry::WIDTH) {
+                break;
+            }
+            x += drawChar(x, y, *str) + 1;
+        }
+        return x;
+    }
+
+    const uint8_t *frameBuffer() const { return bitmap; }
+
+    // Tarama adımı 'scanRow'da SPI'ye gidecek baytlar (SCAN_BYTES). Satırlar
+    // panele sondan başa doğru iç içe gönderilir; panel mantığı ters
+    // olduğundan bitler çevrilir (0 = LED yanık). Tarama kesmesinden
+    // çağrıldığı için IRAM'dedir.
+    void IRAM_ATTR scanBytes(uint8_t scanRow, uint8_t *out) const {
+        for (uint16_t i = 0; i < Geometry::ROW_BYTES; i++) {
+            // -O2/-Os kendiliğinden açmıyor
+#pragma GCC unroll 4
+            for (uint8_t k = 0; k < Geometry::ROWS_PER_SCAN; k++) {
+                out[i * Geometry::ROWS_PER_SCAN + Geometry::ROWS_PER_SCAN - 1 - k] =
+                    ~bitmap[Geometry::scanRowOffset(scanRow, k) + i];
+            }
+        }
+    }
+
+protected:
+    uint8_t bitmap[Geometry::FRAME_BYTES];
+    const uint8_t *font;
+
+    uint8_t fontByte(uint16_t i) const {
+        return pgm_read_byte(font + i);
+    }
+
+    // 'x'ten başlayan 8 piksel, MSB = en soldaki; ekran dışı 0
+    uint8_t readBits(int x, int y) const {
+        if ((unsigned)y >= (unsigned)Geometry::HEIGHT || (unsigned)x >= (unsigned)Geometry::WIDTH) {
+            return 0;
+        }
+        uint8_t shift = x & 7;
+        uint8_t b0 = bitmap[Geometry::byteIndex(x, y)];
+        if (shift == 0) {
+            return b0;
+        }
+        uint8_t b1 = x - shift + 8 < Geometry::WIDTH ? bitmap[Geometry::byteIndex(x - shift + 8, y)] : 0;
+        return (uint8_t)((b0 << shift) | (b1 >> (8 - shift)));
+    }
+
+    bool isFixedWidth() const {
+        return fontByte(0) == 0 && fontByte(1) == 0;
+    }
+
+    // Glyph'in j. sütunu; son bant alta hizalıdır (DMD2 font düzeni)
+    uint32_t glyphColumn(uint16_t index, int w, uint8_t h, int j) const {
+        uint8_t bands = (h + 7) / 8;
+        uint32_t column = 0;
+        for (uint8_t i = 0; i < bands; i++) {
+            uint8_t data = fontByte(index + j + i * w);
+            int offset = (i == bands - 1 && bands > 1) ? h - 8 : i * 8;
+            for (uint8_t k = 0; k < 8; k++) {
+                int row = offset + k;
+                if (row < i * 8 || row >= h) {
+                    continue;
+                }
+                if (data & (1 << k)) {
+                    column |= 1UL << row;
+                }
+            }
+        }
+        return column;
+    }
+
+    uint16_t glyphOffset(uint8_t code, uint8_t bands) const {
+        uint8_t first = fontByte(4);
+        uint8_t idx = code - first;
+        if (isFixedWidth()) {
+            return 6 + (uint16_t)idx * bands * fontByte(2);
+        }
+        uint8_t count = fontByte(5);
+        uint16_t index = 6 + count;
+        for (uint8_t i = 0; i < idx; i++) {
+            index += (uint16_t)fontByte(6 + i) * bands;
+        }
+        return index;
+    }
+};
+
+#endif
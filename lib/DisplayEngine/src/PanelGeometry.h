@@ -0,0 +1,61 @@
+/*
+ * P10 panel zinciri için derleme zamanı geometri tanımı.
+ *
+ * Genişlik, yükseklik ve tarama deseni şablon parametresi olduğu için
+ * framebuffer boyutu, satır adımı ve tarama tabloları constexpr olur;
+ * 1x1 ve 2x1 derlemelerde temizleme/çizim/tarama döngüleri açılır (unroll).
+ *
+ * Bellek düzeni DMD2 ile aynıdır: birden fazla panel yüksekliği varsa
+ * paneller tek bir yatay zincirmiş gibi ("unified") dizilir.
+ */
+
+#ifndef PANEL_GEOMETRY_H
+#define PANEL_GEOMETRY_H
+
+#include <stdint.h>
+
+template <uint8_t PANELS_WIDE, uint8_t PANELS_HIGH, uint8_t SCAN_ROWS = 4>
+struct PanelGeometry {
+    // Tek P10 panel = 32x16 piksel
+    static constexpr uint8_t PANEL_WIDTH = 32;
+    static constexpr uint8_t PANEL_HEIGHT = 16;
+
+    // Mantıksal ekran boyutu (piksel)
+    static constexpr int WIDTH = PANELS_WIDE * PANEL_WIDTH;
+    static constexpr int HEIGHT = PANELS_HIGH * PANEL_HEIGHT;
+
+    // Tarama deseni: P10 için 1/4 tarama, her adımda 4 satır birlikte sürülür
+    static constexpr uint8_t SCAN = SCAN_ROWS;
+    static constexpr uint8_t ROWS_PER_SCAN = PANEL_HEIGHT / SCAN_ROWS;
+
+    // Zincir boyunca bir piksel satırının bayt sayısı
+    static constexpr uint16_t ROW_BYTES = (uint16_t)WIDTH * PANELS_HIGH / 8;
+    static constexpr uint16_t FRAME_BYTES = ROW_BYTES * PANEL_HEIGHT;
+
+    // Bir tarama adımında SPI'ye gönderilen bayt sayısı
+    static constexpr uint16_t SCAN_BYTES = ROW_BYTES * ROWS_PER_SCAN;
+
+    // Tarama adımı 'scanRow' için k. sürülen satırın bitmap başlangıcı
+    // (BA 00 = 1,5,9,13 ... DMD2 ile aynı sıra)
+    static constexpr uint16_t scanRowOffset(uint8_t scanRow, uint8_t k) {
+        return (uint16_t)(scanRow + k * SCAN_ROWS) * ROW_BYTES;
+    }
+
+    // Piksel -> bitmap bayt indeksi (zincir düzeni)
+    static constexpr uint16_t byteIndex(int x, int y) {
+        return (uint16_t)((x + WIDTH * (y / PANEL_HEIGHT)) / 8 + (y % PANEL_HEIGHT) * ROW_BYTES);
+    }
+
+    static constexpr uint8_t bitMask(int x) {
+        return (uint8_t)(0x80 >> (x & 7));
+    }
+
+    static_assert(PANELS_WIDE > 0 && PANELS_HIGH > 0, "Panel sayisi sifir olamaz");
+    static_assert(PANEL_HEIGHT % SCAN_ROWS == 0, "Tarama deseni panel yuksekligini bolmeli");
+};
+
+// Projede kullanılan hazır geometriler
+typedef PanelGeometry<1, 1> P10Single;  // 32x16
+typedef PanelGeometry<2, 1> P10Double;  // 64x16
+
+#endif
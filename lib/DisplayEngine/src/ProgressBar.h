@@ -0,0 +1,84 @@
+/*
+ * Yatay ilerleme çubuğu (ör. geri sayımda kalan süre).
+ *
+ * Değer / toplam oranı kadar sütun dolu çizilir; boş sütunlarda sadece üst
+ * ve alt kenar yanar. update() yeni değerde durumu değişen sütunları
+ * çizer: çubuk bir sütun kısaldıysa tek sütun çizilir, değişmediyse hiçbir
+ * şey çizilmez. Kare başka bir içerikle çizildiyse draw() kullanılır.
+ */
+
+#ifndef PROGRESS_BAR_H
+#define PROGRESS_BAR_H
+
+#include <stdint.h>
+
+class ProgressBar {
+public:
+    ProgressBar() : total(0), filled(0), areaX(0), areaY(0), areaW(0), areaH(0) {}
+
+    void place(int x, int y, uint8_t w, uint8_t h) {
+        areaX = x;
+        areaY = y;
+        areaW = w;
+        areaH = h;
+    }
+
+    // Toplam 0 ise çubuk boş çizilir
+    void setTotal(uint32_t value) {
+        total = value;
+    }
+
+    // Tüm çubuğu çiz
+    template <class Frame>
+    void draw(Frame &frame, uint32_t value) {
+        filled = columnsFor(value);
+        for (uint8_t c = 0; c < areaW; c++) {
+            drawColumn(frame, c);
+        }
+    }
+
+    // Sadece durumu değişen sütunları çiz; bir şey çizildiyse true
+    template <class Frame>
+    bool update(Frame &frame, uint32_t value) {
+        uint8_t next = columnsFor(value);
+        if (next == filled) {
+            return false;
+        }
+        uint8_t from = next < filled ? next : filled;
+        uint8_t to = next < filled ? filled : next;
+        filled = next;
+        for (uint8_t c = from; c < to; c++) {
+            drawColumn(frame, c);
+        }
+        return true;
+    }
+
+private:
+    uint32_t total;
+    uint8_t filled;  // dolu sütun sayısı
+    int areaX;
+    int areaY;
+    uint8_t areaW;
+    uint8_t areaH;
+
+    // Yukarı yuvarlanır: sıfırdan büyük değer en az bir sütun doldurur
+    uint8_t columnsFor(uint32_t value) const {
+        if (total == 0 || value == 0) {
+            return 0;
+        }
+        if (value >= total) {
+            return areaW;
+        }
+        return (uint8_t)(((uint64_t)value * areaW + total - 1) / total);
+    }
+
+    template <class Frame>
+    void drawColumn(Frame &frame, uint8_t c) {
+        bool on = c < filled;
+        for (uint8_t r = 0; r < areaH; r++) {
+            frame.setPixel(areaX + c, areaY + r, on || r == 0 || r == areaH - 1);
+        }
+    }
+};
+
+#endif
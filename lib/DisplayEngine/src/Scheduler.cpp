@@ -0,0 +1,46 @@
+#include "Scheduler.h"
+
+int8_t Scheduler::add(TaskFn fn, uint32_t intervalMs, bool enabled) {
+    if (count >= MAX_TASKS || fn == nullptr) {
+        return -1;
+    }
+    Task &t = tasks[count];
+    t.fn = fn;
+    t.interval = intervalMs;
+    t.last = 0;
+    t.enabled = enabled;
+    t.pending = false;
+    return count++;
+}
+
+void Scheduler::setInterval(int8_t id, uint32_t intervalMs) {
+    if (id >= 0 && id < count) {
+        tasks[id].interval = intervalMs;
+    }
+}
+
+void Scheduler::setEnabled(int8_t id, bool enabled) {
+    if (id >= 0 && id < count) {
+        tasks[id].enabled = enabled;
+    }
+}
+
+void Scheduler::trigger(int8_t id) {
+    if (id >= 0 && id < count) {
+        tasks[id].pending = true;
+    }
+}
+
+void Scheduler::run(uint32_t now) {
+    for (uint8_t i = 0; i < count; i++) {
+        Task &t = tasks[i];
+        if (!t.enabled) {
+            continue;
+        }
+        if (t.pending || now - t.last >= t.interval) {
+            t.pending = false;
+            t.last = now;
+            t.fn();
+        }
+    }
+}
@@ -0,0 +1,46 @@
+/*
+ * Basit periyodik görev zamanlayıcı.
+ *
+ * loop() içinde delay() ile beklemek yerine her görev kendi aralığında
+ * çalışır. Aralık 0 olan görev her run() çağrısında çalışır.
+ * Zaman parametre olarak verilir (millis()), böylece donanımdan bağımsızdır.
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+
+class Scheduler {
+public:
+    typedef void (*TaskFn)();
+
+    static const uint8_t MAX_TASKS = 8;
+
+    Scheduler() : count(0) {}
+
+    // Görev ekler, görev numarasını döndürür (yer yoksa -1)
+    int8_t add(TaskFn fn, uint32_t intervalMs, bool enabled = true);
+
+    void setInterval(int8_t id, uint32_t intervalMs);
+    void setEnabled(int8_t id, bool enabled);
+
+    // Görevi bir sonraki run() çağrısında çalışacak şekilde işaretle
+    void trigger(int8_t id);
+
+    void run(uint32_t now);
+
+private:
+    struct Task {
+        TaskFn fn;
+        uint32_t interval;
+        uint32_t last;
+        bool enabled;
+        bool pending;
+    };
+
+    Task tasks[MAX_TASKS];
+    uint8_t count;
+};
+
+#endif
@@ -0,0 +1,123 @@
+/*
+ * Önceden çizilmiş slaytların sırayla gösterimi (ör. çok ürünlü fiyat panosu).
+ *
+ * Her slayt kendi framebuffer'ında tutulur ve sadece bozulduğunda
+ * (invalidate) yeniden çizilir; bir ürünün fiyatı değişince yalnız o slayt
+ * çizilir. Gösterim bir bitmap kopyasıdır, sırası gelen slayt için glyph
+ * çözümlenmez. Her slaydın kendi bekleme süresi vardır, süresi 0 olan
+ * slayt atlanır. Zamanlamayı Scheduler yapar (update() ile sorulur).
+ */
+
+#ifndef SLIDE_DECK_H
+#define SLIDE_DECK_H
+
+#include <stdint.h>
+
+template <class Frame, uint8_t SLIDES>
+class SlideDeck {
+public:
+    typedef void (*RenderFn)(uint8_t index, Frame &frame);
+
+    static_assert(SLIDES > 0 && SLIDES <= 32, "Slayt sayisi 1-32 olmali");
+
+    SlideDeck() : dirty(0xFFFFFFFFUL), current(0), shownMs(0), fresh(true) {
+        for (uint8_t i = 0; i < SLIDES; i++) {
+            dwellMs[i] = 0;
+        }
+    }
+
+    void selectFont(const uint8_t *font) {
+        for (uint8_t i = 0; i < SLIDES; i++) {
+            frames[i].selectFont(font);
+        }
+    }
+
+    // Bekleme süresi; 0 = slayt gösterilmez
+    void setDwell(uint8_t i, uint32_t ms) {
+        if (i < SLIDES) {
+            dwellMs[i] = ms;
+        }
+    }
+
+    void invalidate(uint8_t i) {
+        if (i < SLIDES) {
+            dirty |= 1UL << i;
+        }
+    }
+
+    void invalidateAll() {
+        dirty = 0xFFFFFFFFUL;
+    }
+
+    // Bozulan slaytları çiz; gösterilen slayt da çizildiyse true
+    bool refresh(RenderFn render) {
+        uint32_t drawn = dirty;
+        for (uint8_t i = 0; i < SLIDES; i++) {
+            if (dirty & (1UL << i)) {
+                render(i, frames[i]);
+            }
+        }
+        dirty = 0;
+        return drawn & (1UL << current);
+    }
+
+    // Sonraki update() ilk gösterilebilir slaytı açar
+    void restart() {
+        current = SLIDES - 1;
+        fresh = true;
+    }
+
+    // Süresi dolduysa sıradaki gösterilebilir slayta geç; değiştiyse true
+    bool update(uint32_t nowMs) {
+        if (!fresh && dwellMs[current] && nowMs - shownMs < dwellMs[current]) {
+            return false;
+        }
+        uint8_t before = current;
+        next(nowMs);
+        bool changed = fresh || current != before;
+        fresh = false;
+        return changed;
+    }
+
+    bool empty() const {
+        for (uint8_t i = 0; i < SLIDES; i++) {
+            if (dwellMs[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    uint8_t currentIndex() const { return current; }
+
+    // Gösterilen slaytı hedefe kopyala; gösterilecek slayt yoksa söndür
+    template <class Target>
+    void show(Target &target) const {
+        if (dwellMs[current]) {
+            target.copyFrom(frames[current]);
+        } else {
+            target.clearScreen();
+        }
+    }
+
+private:
+    Frame frames[SLIDES];
+    uint32_t dwellMs[SLIDES];
+    uint32_t dirty;
+    uint8_t current;
+    uint32_t shownMs;
+    bool fresh;
+
+    void next(uint32_t nowMs) {
+        for (uint8_t n = 1; n <= SLIDES; n++) {
+            uint8_t i = (current + n) % SLIDES;
+            if (dwellMs[i]) {
+                current = i;
+                break;
+            }
+        }
+        shownMs = nowMs;
+    }
+};
+
+#endif
@@ -0,0 +1,150 @@
+/*
+ * Son değerlerin küçük eğilim grafiği (ör. fiyat geçmişi).
+ *
+ * Değerler sabit boyutlu bir halkada tutulur; en yeni değer alanın sağ
+ * kenarındadır, her sütun bir değerdir. Ölçek görünen değerlerin en
+ * küçüğü ile en büyüğü arasıdır (en küçük değer de 1 piksel yükseklik alır).
+ *
+ * Yeni değer gelince update() ölçek değişmediyse alanı bir sütun sola
+ * kaydırıp sadece yeni sütunu çizer; ölçek değiştiyse ya da kare başka
+ * bir içerikle çizildiyse draw() ile tamamı çizilir.
+ */
+
+#ifndef SPARKLINE_H
+#define SPARKLINE_H
+
+#include <stdint.h>
+
+template <uint8_t SAMPLES>
+class Sparkline {
+public:
+    Sparkline()
+        : head(0), count(0), pending(0), drawnLow(0), drawnHigh(0), filled(true),
+          areaX(0), areaY(0), areaW(0), areaH(0) {}
+
+    // Grafik alanı; genişlik en fazla SAMPLES sütun
+    void place(int x, int y, uint8_t w, uint8_t h) {
+        areaX = x;
+        areaY = y;
+        areaW = w < SAMPLES ? w : SAMPLES;
+        areaH = h;
+    }
+
+    // true = dolu çubuk, false = sadece tepe noktası
+    void setFilled(bool on) {
+        filled = on;
+    }
+
+    void clear() {
+        head = count = pending = 0;
+    }
+
+    void push(int32_t value) {
+        values[head] = value;
+        head = (head + 1) % SAMPLES;
+        if (count < SAMPLES) {
+            count++;
+        }
+        if (pending < SAMPLES) {
+            pending++;
+        }
+    }
+
+    uint8_t size() const { return count; }
+
+    // Tüm alanı çiz
+    template <class Frame>
+    void draw(Frame &frame) {
+        range(drawnLow, drawnHigh);
+        for (uint8_t c = 0; c < areaW; c++) {
+            drawColumn(frame, c, c);
+        }
+        pending = 0;
+    }
+
+    // Son çizimden beri gelen değerleri çiz; ölçek aynıysa kaydırarak
+    template <class Frame>
+    void update(Frame &frame) {
+        if (pending == 0) {
+            return;
+        }
+        int32_t low, high;
+        range(low, high);
+        if (low != drawnLow || high != drawnHigh || pending >= areaW) {
+            draw(frame);
+            return;
+        }
+        for (; pending > 0; pending--) {
+            frame.shiftLeft(areaX, areaY, areaW, areaH);
+            // Çizilmemiş değerler eskiden yeniye sağ kenardan girer
+            drawColumn(frame, areaW - pending, areaW - 1);
+        }
+    }
+
+private:
+    int32_t values[SAMPLES];
+    uint8_t head;     // sıradaki yazma konumu
+    uint8_t count;
+    uint8_t pending;  // son çizimden beri eklenen
+    int32_t drawnLow;
+    int32_t drawnHigh;
+    bool filled;
+    int areaX;
+    int areaY;
+    uint8_t areaW;
+    uint8_t areaH;
+
+    // Sütun c'deki değer (c = areaW - 1 en yenisi); yoksa false
+    bool valueAt(uint8_t c, int32_t &value) const {
+        uint8_t age = areaW - 1 - c;
+        if (age >= count) {
+            return false;
+        }
+        value = values[(head + SAMPLES - 1 - age) % SAMPLES];
+        return true;
+    }
+
+    void range(int32_t &low, int32_t &high) const {
+        bool any = false;
+        for (uint8_t c = 0; c < areaW; c++) {
+            int32_t v;
+            if (!valueAt(c, v)) {
+                continue;
+            }
+            if (!any || v < low) {
+                low = v;
+            }
+            if (!any || v > high) {
+                high = v;
+            }
+            any = true;
+        }
+        if (!any) {
+            low = high = 0;
+        }
+    }
+
+    // Çubuk yüksekliği 1..areaH; tüm değerler eşitse yarı yükseklik
+    uint8_t level(int32_t v) const {
+        if (drawnHigh == drawnLow) {
+            return (areaH + 1) / 2;
+        }
+        uint32_t span = (uint32_t)drawnHigh - (uint32_t)drawnLow;
+        uint32_t offset = (uint32_t)v - (uint32_t)drawnLow;
+        return 1 + (uint8_t)((uint64_t)offset * (areaH - 1) / span);
+    }
+
+    // Sütun c'deki değeri 'at' sütununa çiz
+    template <class Frame>
+    void drawColumn(Frame &frame, uint8_t c, uint8_t at) {
+        int32_t v;
+        uint8_t top = valueAt(c, v) ? level(v) : 0;
+        int x = areaX + at;
+        for (uint8_t r = 0; r < areaH; r++) {
+            bool on = filled ? r < top : r + 1 == top;
+            frame.setPixel(x, areaY + areaH - 1 - r, on);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,133 @@
+#include "TextFormat.h"
+
+static size_t appendStr(char *buf, size_t size, size_t len, const char *str) {
+    while (*str && len + 1 < size) {
+        buf[len++] = *str++;
+    }
+    buf[len] = '\0';
+    return len;
+}
+
+// "00".."99": her çift bir bölmeyle iki basamak verir
+static const char DIGIT_PAIRS[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// Basamakları 'end'in soluna yaz; basamak sayısını döndür (en fazla 10)
+static uint8_t writeDigits(char *end, uint32_t value) {
+    char *p = end;
+    while (value >= 100) {
+        uint32_t q = value / 100;
+        const char *pair = &DIGIT_PAIRS[(value - q * 100) * 2];
+        *--p = pair[1];
+        *--p = pair[0];
+        value = q;
+    }
+    if (value >= 10) {
+        *--p = DIGIT_PAIRS[value * 2 + 1];
+        *--p = DIGIT_PAIRS[value * 2];
+    } else {
+        *--p = '0' + value;
+    }
+    return end - p;
+}
+
+static size_t appendChar(char *buf, size_t size, size_t len, char c) {
+    if (len + 1 < size) {
+        buf[len++] = c;
+    }
+    buf[len] = '\0';
+    return len;
+}
+
+static size_t appendUInt(char *buf, size_t size, size_t len, uint32_t value, uint8_t minDigits) {
+    char digits[10];
+    uint8_t n = writeDigits(digits + sizeof(digits), value);
+    while (n < minDigits) {
+        len = appendChar(buf, size, len, '0');
+        minDigits--;
+    }
+    const char *d = digits + sizeof(digits) - n;
+    while (n-- > 0 && len + 1 < size) {
+        buf[len++] = *d++;
+    }
+    buf[len] = '\0';
+    return len;
+}
+
+size_t formatInt(char *buf, size_t size, int32_t value, const char *suffix) {
+    if (size == 0) {
+        return 0;
+    }
+    size_t len = 0;
+    uint32_t magnitude = value < 0 ? 0UL - (uint32_t)value : (uint32_t)value;
+    if (value < 0) {
+        len = appendStr(buf, size, len, "-");
+    }
+    len = appendUInt(buf, size, len, magnitude, 1);
+    if (suffix) {
+        len = appendStr(buf, size, len, suffix);
+    }
+    return len;
+}
+
+size_t formatFixed(char *buf, size_t size, int32_t value, const FixedFormat &format,
+                   const char *suffix) {
+    if (size == 0) {
+        return 0;
+    }
+    uint8_t decimals = format.decimals < 9 ? format.decimals : 9;
+    uint32_t magnitude = value < 0 ? 0UL - (uint32_t)value : (uint32_t)value;
+    // Tam kısım en az bir basamak: 5 -> "0,05"
+    char digits[10];
+    char *end = digits + sizeof(digits);
+    uint8_t n = writeDigits(end, magnitude);
+    while (n <= decimals) {
+        end[-++n] = '0';
+    }
+    const char *d = end - n;
+
+    size_t len = 0;
+    buf[0] = '\0';
+    if (value < 0) {
+        len = appendChar(buf, size, len, '-');
+    } else if (value > 0 && format.plusSign) {
+        len = appendChar(buf, size, len, '+');
+    }
+    uint8_t whole = n - decimals;
+    for (uint8_t i = 0; i < whole; i++) {
+        if (i > 0 && format.groupMark && (whole - i) % 3 == 0) {
+            len = appendChar(buf, size, len, format.groupMark);
+        }
+        len = appendChar(buf, size, len, d[i]);
+    }
+    if (decimals) {
+        len = appendChar(buf, size, len, format.decimalMark);
+        for (uint8_t i = whole; i < n; i++) {
+            len = appendChar(buf, size, len, d[i]);
+        }
+    }
+    if (suffix) {
+        len = appendStr(buf, size, len, suffix);
+    }
+    return len;
+}
+
+size_t formatClock(char *buf, size_t size, unsigned long seconds) {
+    if (size == 0) {
+        return 0;
+    }
+    size_t len = appendUInt(buf, size, 0, (seconds / 3600) % 24, 1);
+    len = appendStr(buf, size, len, ":");
+    len = appendUInt(buf, size, len, (seconds / 60) % 60, 2);
+    len = appendStr(buf, size, len, ":");
+    return appendUInt(buf, size, len, seconds % 60, 2);
+}
@@ -0,0 +1,35 @@
+/*
+ * Yazı biçimlendirme: sayı ve saat metinlerini sabit tampona yazar.
+ *
+ * String birleştirme yerine kullanılır; heap'e dokunmaz. Dönüş değeri
+ * yazılan karakter sayısıdır, tampon her durumda '\0' ile biter.
+ *
+ * Basamaklar 00-99 tablosundan ikişer ikişer yazılır; sayı başına bölme
+ * sayısı basamak sayısının yarısıdır.
+ */
+
+#ifndef TEXT_FORMAT_H
+#define TEXT_FORMAT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// "1500 TL" gibi: tamsayı + isteğe bağlı sonek
+size_t formatInt(char *buf, size_t size, int32_t value, const char *suffix = nullptr);
+
+// Sabit noktalı sayı biçimi: değer = gösterilen * 10^decimals
+struct FixedFormat {
+    uint8_t decimals;   // 0-9
+    char decimalMark;   // ',' ya da '.'
+    char groupMark;     // binlik ayırıcı, '\0' = yok
+    bool plusSign;      // pozitif değerlerde '+'
+};
+
+// "1.499,90 TL" gibi: sabit noktalı değer + isteğe bağlı sonek
+size_t formatFixed(char *buf, size_t size, int32_t value, const FixedFormat &format,
+                   const char *suffix = nullptr);
+
+// "H:MM:SS" biçiminde saat (saat 24'e göre sarar)
+size_t formatClock(char *buf, size_t size, unsigned long seconds);
+
+#endif
@@ -0,0 +1,32 @@
+/*
+ * Metin çizim yardımcıları (PanelFrame / PanelDriver için).
+ *
+ * Her fonksiyon ekranı temizleyip tek bir metin çizer. Hizalama
+ * hesapları font ölçülerinden yapılır, "uzunluk * 6" tahmini kullanılmaz.
+ */
+
+#ifndef TEXT_RENDERER_H
+#define TEXT_RENDERER_H
+
+template <class Frame>
+void renderText(Frame &frame, int x, int y, const char *text) {
+    frame.clearScreen();
+    frame.drawString(x, y, text);
+}
+
+// Yatay ve dikey ortala; sığmayan metin soldan hizalanır
+template <class Frame>
+void renderCentered(Frame &frame, const char *text) {
+    int x = (frame.width() - frame.stringWidth(text)) / 2;
+    int y = (frame.height() - frame.fontHeight()) / 2;
+    renderText(frame, x < 0 ? 0 : x, y < 0 ? 0 : y, text);
+}
+
+// Kayan yazı şeridini tam genişlikte çiz (bkz. Marquee.h)
+template <class Frame, class Strip>
+void renderMarquee(Frame &frame, const Strip &marquee, int y) {
+    frame.clearScreen();
+    marquee.draw(frame, 0, y, frame.width());
+}
+
+#endif
@@ -0,0 +1,220 @@
+/*
+ * Haber bandı: sınırlı bir mesaj kuyruğu tek ve kesintisiz bir kayan akışta.
+ *
+ * Master mesaj ekler ya da mesajların süresi dolar; kayma konumu hiçbir
+ * zaman sıfırlanmaz. Akış dairesel bir BitStrip'e ekranın sağ kenarına
+ * kadar sütun sütun üretilir: bir mesajın glyph'leri ancak sağ kenara
+ * gelince çözümlenir, yeni mesaj sırası gelince akışa girer ve kuyruğun
+ * tamamı hiçbir zaman yeniden dizilmez. Mesajlar arasında 'gap' piksel
+ * boşluk vardır; son mesajdan sonra en eskiye dönülür, kuyruk boşsa akış
+ * boş sütun üretir.
+ *
+ * Dolu kuyruğa eklenen mesaj en eskisini düşürür. O an akışa yazılan mesaj
+ * kopyadan okunur; kuyruktan çıkarılsa da yarım kalmaz.
+ */
+
+#ifndef TICKER_FEED_H
+#define TICKER_FEED_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "Marquee.h"
+
+template <uint8_t ITEMS, uint8_t TEXT_LEN, uint16_t RING_COLUMNS, uint8_t ROWS>
+class TickerFeed {
+public:
+    static constexpr uint8_t MAX_GLYPH_WIDTH = 32;
+
+    TickerFeed()
+        : lastSeq(0), gap(16), viewWidth(0), offset(0), ahead(0), curSeq(0), charPos(0),
+          glyphWidth(0), glyphCol(0), spacing(false), gapLeft(0) {
+        clear();
+        current[0] = '\0';
+    }
+
+    // Mesajı kuyruğun sonuna ekle; ttlMs 0 = süresiz
+    void append(const char *text, uint32_t nowMs, uint32_t ttlMs) {
+        int8_t slot = -1;
+        for (uint8_t i = 0; i < ITEMS; i++) {
+            if (items[i].seq == 0) {
+                slot = i;
+                break;
+            }
+        }
+        if (slot < 0) {
+            slot = oldest();
+        }
+        Item &it = items[slot];
+        strncpy(it.text, text, TEXT_LEN);
+        it.text[TEXT_LEN] = '\0';
+        it.seq = ++lastSeq;
+        it.expiresMs = nowMs + ttlMs;
+        it.expires = ttlMs != 0;
+    }
+
+    void expireOldest() {
+        int8_t i = oldest();
+        if (i >= 0) {
+            items[i].seq = 0;
+        }
+    }
+
+    void clear() {
+        for (uint8_t i = 0; i < ITEMS; i++) {
+            items[i].seq = 0;
+        }
+    }
+
+    // Süresi dolanları çıkar, kalan mesaj sayısını döndür
+    uint8_t prune(uint32_t nowMs) {
+        uint8_t n = 0;
+        for (uint8_t i = 0; i < ITEMS; i++) {
+            Item &it = items[i];
+            if (it.seq && it.expires && (int32_t)(nowMs - it.expiresMs) >= 0) {
+                it.seq = 0;
+            }
+            n += it.seq != 0;
+        }
+        return n;
+    }
+
+    // Mesajlar arası boşluk; sıradaki mesajdan itibaren geçerli
+    void setGap(uint16_t columns) {
+        gap = columns;
+    }
+
+    void setInterval(uint16_t ms) {
+        timer.setInterval(ms);
+    }
+
+    // Akışı boş ekranla başlat; mesajlar sağ kenardan girer
+    void start(uint16_t width) {
+        viewWidth = width < RING_COLUMNS / 2 ? width : RING_COLUMNS / 2;
+        strip.clear();
+        offset = 0;
+        ahead = viewWidth;
+        timer.restart();
+    }
+
+    // Zamanı gelen adımlar kadar kaydır, sağ kenara yeni sütunları üret;
+    // yeniden çizilmesi gerekiyorsa true döner
+    template <class Font>
+    bool update(const Font &font, uint32_t nowMs) {
+        uint32_t steps = timer.due(nowMs);
+        if (steps == 0) {
+            return false;
+        }
+        // Uzun bir duraklamadan sonra en fazla bir ekran atlanır
+        if (steps > viewWidth) {
+            steps = viewWidth;
+        }
+        while (ahead < viewWidth + steps) {
+            strip.setColumn((offset + ahead) % RING_COLUMNS, nextColumn(font));
+            ahead++;
+        }
+        offset = (offset + steps) % RING_COLUMNS;
+        ahead -= steps;
+        return true;
+    }
+
+    template <class Frame>
+    void draw(Frame &frame, int x, int y, int w) const {
+        strip.draw(frame, x, y, w < viewWidth ? w : viewWidth, offset, RING_COLUMNS);
+    }
+
+private:
+    struct Item {
+        uint32_t seq;  // 0 = boş
+        uint32_t expiresMs;
+        bool expires;
+        char text[TEXT_LEN + 1];
+    };
+
+    Item items[ITEMS];
+    uint32_t lastSeq;
+    uint16_t gap;
+
+    BitStrip<RING_COLUMNS, ROWS> strip;
+    StepTimer timer;
+    uint16_t viewWidth;
+    uint16_t offset;  // ekranın sol kenarındaki halka sütunu
+    uint16_t ahead;   // offset'ten itibaren üretilmiş sütun
+
+    // Akışa yazılan mesaj ve içindeki konum
+    char current[TEXT_LEN + 1];
+    uint32_t curSeq;
+    uint8_t charPos;
+    uint32_t glyph[MAX_GLYPH_WIDTH];
+    uint8_t glyphWidth;
+    uint8_t glyphCol;
+    bool spacing;  // glyph'ten sonra 1 piksel aralık
+    uint16_t gapLeft;
+
+    int8_t oldest() const {
+        int8_t found = -1;
+        for (uint8_t i = 0; i < ITEMS; i++) {
+            if (items[i].seq && (found < 0 || items[i].seq < items[found].seq)) {
+                found = i;
+            }
+        }
+        return found;
+    }
+
+    // Sıradaki mesaj: curSeq'ten sonra eklenen ilk mesaj, yoksa en eskisi
+    bool loadNext() {
+        int8_t found = -1;
+        for (uint8_t i = 0; i < ITEMS; i++) {
+            if (items[i].seq > curSeq && (found < 0 || items[i].seq < items[found].seq)) {
+                found = i;
+            }
+        }
+        if (found < 0) {
+            found = oldest();
+        }
+        if (found < 0) {
+            return false;
+        }
+        memcpy(current, items[found].text, TEXT_LEN + 1);
+        curSeq = items[found].seq;
+        charPos = 0;
+        glyphWidth = glyphCol = 0;
+        spacing = false;
+        gapLeft = gap;
+        return true;
+    }
+
+    template <class Font>
+    uint32_t nextColumn(const Font &font) {
+        bool loaded = false;
+        for (;;) {
+            if (glyphCol < glyphWidth) {
+                uint8_t j = glyphCol++;
+                return j < MAX_GLYPH_WIDTH ? glyph[j] : 0;
+            }
+            if (spacing) {
+                spacing = false;
+                return 0;
+            }
+            if (current[charPos]) {
+                glyphWidth = font.glyphColumns(current[charPos++], glyph, MAX_GLYPH_WIDTH);
+                glyphCol = 0;
+                spacing = glyphWidth && current[charPos];
+                continue;
+            }
+            if (gapLeft) {
+                gapLeft--;
+                return 0;
+            }
+            // Mesaj bitti; boş kuyrukta ya da sütun üretmeyen mesajlarda boş sütun
+            if (loaded || !loadNext()) {
+                current[0] = '\0';
+                charPos = 0;
+                return 0;
+            }
+            loaded = true;
+        }
+    }
+};
+
+#endif
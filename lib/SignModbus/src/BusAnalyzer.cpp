@@ -0,0 +1,227 @@
+#include "BusAnalyzer.h"
+
+#include <string.h>
+
+#include "ModbusCrc.h"
+
+BusAnalyzer::BusAnalyzer(uint32_t baud, uint32_t slotUs)
+    : byteUs(10000000UL / baud), slotUs(slotUs), responseLimitUs(DEFAULT_RESPONSE_LIMIT_US) {
+    reset();
+}
+
+void BusAnalyzer::reset() {
+    memset(&stats, 0, sizeof(stats));
+    memset(slaves, 0, sizeof(slaves));
+    memset(window, 0, sizeof(window));
+    memset(unanswered, 0, sizeof(unanswered));
+    memset(responseCrc, 0, sizeof(responseCrc));
+    memset(responseEndUs, 0, sizeof(responseEndUs));
+    count = 0;
+    pending = false;
+    started = false;
+    lastEndUs = 0;
+    lastResponder = -1;
+    nowUs = 0;
+    slotHead = 0;
+    slotsFilled = 0;
+    slotStartUs = 0;
+}
+
+int8_t BusAnalyzer::indexOf(uint8_t unit, bool create) {
+    for (uint8_t i = 0; i < count; i++) {
+        if (slaves[i].unit == unit) {
+            return i;
+        }
+    }
+    if (!create || count >= MAX_SLAVES) {
+        return -1;
+    }
+    slaves[count].unit = unit;
+    return count++;
+}
+
+const BusAnalyzer::SlaveStats *BusAnalyzer::slave(uint8_t unit) const {
+    for (uint8_t i = 0; i < count; i++) {
+        if (slaves[i].unit == unit) {
+            return &slaves[i];
+        }
+    }
+    return nullptr;
+}
+
+// Yanıtsız kalan istek zaman aşımıdır; aynısı tekrar gelirse tekrar sayılır
+void BusAnalyzer::closePending() {
+    if (!pending) {
+        return;
+    }
+    pending = false;
+    int8_t i = indexOf(pendingUnit, false);
+    if (i >= 0) {
+        slaves[i].timeouts++;
+        unanswered[i] = true;
+        unansweredCrc[i] = pendingCrc;
+    }
+}
+
+void BusAnalyzer::tick(uint32_t now) {
+    if (!started || (int32_t)(now - nowUs) < 0) {
+        return;
+    }
+    nowUs = now;
+    while (nowUs - slotStartUs >= slotUs) {
+        slotStartUs += slotUs;
+        slotHead = (slotHead + 1) % WINDOW_SLOTS;
+        memset(&window[slotHead], 0, sizeof(Slot));
+        if (slotsFilled < WINDOW_SLOTS) {
+            slotsFilled++;
+        }
+    }
+}
+
+// Beklenmeyen yanıt: istek olamayacak bir okuma / istisna yanıtı ya da son
+// yanıtın tekrarı
+bool BusAnalyzer::isLate(int8_t i, int8_t previous, const uint8_t *data, uint16_t len,
+                         uint16_t crc, uint32_t startUs) const {
+    if (i < 0) {
+        return false;
+    }
+    uint8_t fc = data[1];
+    if (fc & 0x80) {
+        return true;
+    }
+    // Okuma isteği her zaman 8 bayttır (adresi 0x03xx olan istek de 5 +
+    // data[2] boyundadır); yanıtın bayt sayısı çifttir
+    if ((fc == 0x03 || fc == 0x04) && len != 8 && len == 5 + data[2] && data[2] % 2 == 0) {
+        return true;
+    }
+    // Yankı yanıtı (FC05/06/15/16) istekle aynıdır: yalnızca hemen ardından
+    // gelen kopyası geç yanıt sayılır, araya trafik girdiyse yeni istektir
+    return previous == i && responseCrc[i] == crc &&
+           startUs - responseEndUs[i] <= responseLimitUs;
+}
+
+void BusAnalyzer::record(uint8_t dir, uint32_t stampUs, const uint8_t *data, uint16_t len) {
+    // RX damgası son baytın bitişi, TX damgası gönderimin başıdır
+    uint32_t durationUs = len * byteUs;
+    uint32_t startUs = dir == DIR_TX ? stampUs : stampUs - durationUs;
+    uint32_t endUs = startUs + durationUs;
+
+    if (!started) {
+        started = true;
+        slotStartUs = startUs;
+        nowUs = startUs;
+        slotsFilled = 1;
+    }
+    tick(endUs);
+
+    Slot &slot = window[slotHead];
+    slot.busyUs += durationUs;
+    slot.frames++;
+    stats.frames++;
+    if (stats.frames > 1 && (int32_t)(startUs - lastEndUs) > 0) {
+        uint32_t gap = startUs - lastEndUs;
+        stats.gaps++;
+        stats.totalGapUs += gap;
+        if (gap > stats.maxGapUs) {
+            stats.maxGapUs = gap;
+        }
+        if (gap > slot.maxGapUs) {
+            slot.maxGapUs = gap;
+        }
+    }
+    lastEndUs = endUs;
+    int8_t previous = lastResponder;
+    lastResponder = -1;
+
+    if (len < 4 || modbusCrc(data, len) != 0) {
+        stats.crcErrors++;
+        return;
+    }
+    uint8_t unit = data[0];
+    uint8_t fc = data[1];
+    uint16_t crc = data[len - 2] | (data[len - 1] << 8);
+
+    if (pending && startUs - pendingEndUs > responseLimitUs) {
+        closePending();
+    }
+    if (pending && unit == pendingUnit && (fc & 0x7F) == pendingFc) {
+        pending = false;
+        int8_t i = indexOf(unit, false);
+        if (i >= 0) {
+            SlaveStats &s = slaves[i];
+            uint32_t rt = startUs - pendingEndUs;
+            s.responses++;
+            s.lastResponseUs = rt;
+            s.totalResponseUs += rt;
+            if (rt > s.maxResponseUs) {
+                s.maxResponseUs = rt;
+            }
+            if (fc & 0x80) {
+                s.exceptions++;
+            }
+            unanswered[i] = false;
+            responseCrc[i] = crc;
+            responseEndUs[i] = endUs;
+            lastResponder = i;
+        }
+        return;
+    }
+
+    int8_t known = indexOf(unit, false);
+    if (isLate(known, previous, data, len, crc, startUs)) {
+        slaves[known].late++;
+        return;
+    }
+    closePending();
+    if (unit == 0) {
+        stats.broadcasts++;
+        return;
+    }
+    int8_t i = indexOf(unit, true);
+    if (i < 0) {
+        stats.untracked++;
+        return;
+    }
+    SlaveStats &s = slaves[i];
+    s.requests++;
+    if (unanswered[i] && unansweredCrc[i] == crc) {
+        s.retries++;
+    }
+    unanswered[i] = false;
+    pending = true;
+    pendingUnit = unit;
+    pendingFc = fc;
+    pendingCrc = crc;
+    pendingEndUs = endUs;
+}
+
+uint32_t BusAnalyzer::windowUs() const {
+    return slotsFilled ? (slotsFilled - 1) * slotUs + (nowUs - slotStartUs) : 0;
+}
+
+uint16_t BusAnalyzer::utilizationPermille() const {
+    uint64_t busy = 0;
+    for (uint8_t i = 0; i < WINDOW_SLOTS; i++) {
+        busy += window[i].busyUs;
+    }
+    uint32_t span = windowUs();
+    return span ? (uint16_t)(busy * 1000 / span > 1000 ? 1000 : busy * 1000 / span) : 0;
+}
+
+uint32_t BusAnalyzer::windowFrames() const {
+    uint32_t n = 0;
+    for (uint8_t i = 0; i < WINDOW_SLOTS; i++) {
+        n += window[i].frames;
+    }
+    return n;
+}
+
+uint32_t BusAnalyzer::windowMaxGapUs() const {
+    uint32_t m = 0;
+    for (uint8_t i = 0; i < WINDOW_SLOTS; i++) {
+        if (window[i].maxGapUs > m) {
+            m = window[i].maxGapUs;
+        }
+    }
+    return m;
+}
@@ -0,0 +1,131 @@
+/*
+ * Pasif hat çözümleyici.
+ *
+ * TrafficSink olarak RtuSlave'e bağlanır ve hattaki tüm çerçeveleri (hangi
+ * slave'e giderse gitsin) izler. Modbus RTU çerçevelerinde yön bilgisi
+ * yoktur: bekleyen isteğin birimi ve fonksiyon koduyla (istisna dahil)
+ * yanıt sınırı içinde gelen ilk çerçeve yanıt, diğerleri istek sayılır.
+ * Yanıt sınırı master'ın zaman aşımı olmalıdır; FC06 yanıtı isteğin
+ * aynısı olduğundan tekrar ile yanıt ancak zamanla ayrılır.
+ *   yanıt süresi  isteğin bitişinden yanıtın başlamasına kadar
+ *   zaman aşımı   sınır içinde yanıt gelmeyen istek
+ *   tekrar        zaman aşımına uğrayan isteğin aynısı (aynı CRC)
+ *   geç yanıt     sınırdan sonra gelen ya da yinelenen yanıt (yavaş slave)
+ *   boşluk        iki çerçeve arasındaki sessizlik
+ * Hat doluluğu ve çerçeve sayısı WINDOW_SLOTS dilimlik kayan pencerede
+ * tutulur (varsayılan 10 x 1 s); tick() boş geçen dilimleri ilerletir.
+ * İlk görülen MAX_SLAVES slave ayrı ayrı izlenir.
+ */
+
+#ifndef BUS_ANALYZER_H
+#define BUS_ANALYZER_H
+
+#include <stdint.h>
+
+#include "TrafficRecorder.h"
+
+class BusAnalyzer : public TrafficSink {
+public:
+    static const uint8_t MAX_SLAVES = 8;
+    static const uint8_t WINDOW_SLOTS = 10;
+    static const uint32_t DEFAULT_RESPONSE_LIMIT_US = 1000000;
+
+    struct SlaveStats {
+        uint8_t unit;
+        uint32_t requests;
+        uint32_t responses;
+        uint32_t timeouts;
+        uint32_t retries;
+        uint32_t exceptions;
+        uint32_t late;
+        uint32_t lastResponseUs;
+        uint32_t maxResponseUs;
+        uint64_t totalResponseUs;
+
+        uint32_t averageResponseUs() const {
+            return responses ? totalResponseUs / responses : 0;
+        }
+    };
+
+    struct BusStats {
+        uint32_t frames;
+        uint32_t crcErrors;
+        uint32_t broadcasts;
+        uint32_t untracked;   // MAX_SLAVES dolduktan sonra görülen slave'lere
+        uint32_t gaps;
+        uint32_t maxGapUs;
+        uint64_t totalGapUs;
+
+        uint32_t averageGapUs() const {
+            return gaps ? totalGapUs / gaps : 0;
+        }
+    };
+
+    BusAnalyzer(uint32_t baud, uint32_t slotUs = 1000000);
+
+    void record(uint8_t dir, uint32_t stampUs, const uint8_t *data, uint16_t len) override;
+
+    // Pencereyi 'now'a kadar ilerlet (çerçeve gelmese de); bekleyen istek
+    // sıradaki çerçevede sonuçlanır
+    void tick(uint32_t now);
+
+    void reset();
+
+    void setResponseLimit(uint32_t us) { responseLimitUs = us; }
+
+    // Pencere: doluluk (binde), çerçeve sayısı, en uzun boşluk
+    uint16_t utilizationPermille() const;
+    uint32_t windowFrames() const;
+    uint32_t windowMaxGapUs() const;
+    uint32_t windowUs() const;
+
+    const BusStats &bus() const { return stats; }
+    uint8_t slaveCount() const { return count; }
+    const SlaveStats &slaveAt(uint8_t i) const { return slaves[i]; }
+    const SlaveStats *slave(uint8_t unit) const;
+
+private:
+    struct Slot {
+        uint32_t busyUs;
+        uint32_t frames;
+        uint32_t maxGapUs;
+    };
+
+    uint32_t byteUs;
+    uint32_t slotUs;
+    uint32_t responseLimitUs;
+
+    BusStats stats;
+    SlaveStats slaves[MAX_SLAVES];
+    uint8_t count;
+
+    // Yanıt bekleyen istek
+    bool pending;
+    uint8_t pendingUnit;
+    uint8_t pendingFc;
+    uint16_t pendingCrc;
+    uint32_t pendingEndUs;
+
+    // Slave başına son yanıtsız isteğin CRC'si (tekrar tespiti) ve son yanıt
+    uint16_t unansweredCrc[MAX_SLAVES];
+    bool unanswered[MAX_SLAVES];
+    uint16_t responseCrc[MAX_SLAVES];
+    uint32_t responseEndUs[MAX_SLAVES];
+
+    bool started;
+    uint32_t lastEndUs;
+    int8_t lastResponder;  // bir önceki çerçeve yanıtsa sahibinin sırası
+    uint32_t nowUs;      // son tick / çerçeve zamanı
+
+    Slot window[WINDOW_SLOTS];
+    uint8_t slotHead;
+    uint8_t slotsFilled;
+    uint32_t slotStartUs;
+
+    int8_t indexOf(uint8_t unit, bool create);
+    void closePending();
+    bool isLate(int8_t i, int8_t previous, const uint8_t *data, uint16_t len, uint16_t crc,
+                uint32_t startUs) const;
+};
+
+#endif
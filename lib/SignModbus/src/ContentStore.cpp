@@ -0,0 +1,193 @@
+#include "ContentStore.h"
+
+#include <string.h>
+
+#include "ModbusCrc.h"
+
+static const uint32_t HEADER_MAGIC = 0x31544E43;  // "CNT1"
+
+// Modbus istisna kodları (RtuSlave ile aynı)
+static const uint8_t EX_ILLEGAL_ADDRESS = 0x02;
+static const uint8_t EX_DEVICE_FAILURE = 0x04;
+
+ContentStore::ContentStore(FlashDevice &flash)
+    : flash(flash), files(0), state(STATUS_IDLE), transferFile(0),
+      expectedSize(0), expectedCrc(0), receivedBytes(0), flushedBytes(0),
+      bufferedSector(-1) {}
+
+void ContentStore::begin() {
+    uint32_t slots = flash.size() / ((uint32_t)SLOT_SECTORS * FlashDevice::SECTOR_SIZE);
+    files = slots > MAX_FILES ? MAX_FILES : slots;
+}
+
+uint32_t ContentStore::slotOffset(uint16_t file) const {
+    return (uint32_t)(file - 1) * SLOT_SECTORS * FlashDevice::SECTOR_SIZE;
+}
+
+ContentStore::Status ContentStore::beginTransfer(uint16_t file, uint32_t size, uint16_t crc) {
+    if (!validFile(file) || size == 0 || size > FILE_BYTES) {
+        state = STATUS_BAD_REQUEST;
+        return state;
+    }
+    transferFile = file;
+    expectedSize = size;
+    expectedCrc = crc;
+    receivedBytes = 0;
+    flushedBytes = 0;
+    bufferedSector = -1;
+
+    // Eski başlığı hemen geçersiz kıl (başlık son sektörde)
+    uint32_t headerSector = FILE_BYTES / FlashDevice::SECTOR_SIZE;
+    if (!flash.eraseSector(slotOffset(file) + headerSector * FlashDevice::SECTOR_SIZE)) {
+        state = STATUS_FLASH_ERROR;
+        return state;
+    }
+    state = STATUS_RECEIVING;
+    return state;
+}
+
+bool ContentStore::flushSector() {
+    if (bufferedSector < 0) {
+        return true;
+    }
+    uint32_t offset = slotOffset(transferFile) + (uint32_t)bufferedSector * FlashDevice::SECTOR_SIZE;
+    bool ok = flash.eraseSector(offset) && flash.write(offset, sector, FlashDevice::SECTOR_SIZE);
+    flushedBytes = (uint32_t)(bufferedSector + 1) * FlashDevice::SECTOR_SIZE;
+    bufferedSector = -1;
+    if (!ok) {
+        state = STATUS_FLASH_ERROR;
+    }
+    return ok;
+}
+
+ContentStore::Status ContentStore::commitTransfer() {
+    if (state != STATUS_RECEIVING) {
+        return state;
+    }
+    if (receivedBytes != expectedSize) {
+        state = STATUS_BAD_REQUEST;
+        return state;
+    }
+    if (!flushSector()) {
+        return state;
+    }
+
+    // CRC'yi flash'taki veriden hesapla (sektör tamponu geçici alan olarak)
+    uint32_t base = slotOffset(transferFile);
+    uint16_t crc = MODBUS_CRC_INIT;
+    for (uint32_t done = 0; done < expectedSize;) {
+        uint32_t n = expectedSize - done;
+        if (n > FlashDevice::SECTOR_SIZE) {
+            n = FlashDevice::SECTOR_SIZE;
+        }
+        if (!flash.read(base + done, sector, n)) {
+            state = STATUS_FLASH_ERROR;
+            return state;
+        }
+        crc = modbusCrc(sector, n, crc);
+        done += n;
+    }
+    if (crc != expectedCrc) {
+        state = STATUS_CRC_ERROR;
+        return state;
+    }
+
+    // Veri alanının sonrası silinmiş durumda (0xFF), başlık silmeden yazılır
+    Header h = { HEADER_MAGIC, expectedSize, crc };
+    if (!flash.write(base + FILE_BYTES, (const uint8_t *)&h, sizeof(h))) {
+        state = STATUS_FLASH_ERROR;
+        return state;
+    }
+    state = STATUS_VERIFIED;
+    return state;
+}
+
+void ContentStore::abortTransfer() {
+    bufferedSector = -1;
+    state = STATUS_IDLE;
+}
+
+bool ContentStore::fileInfo(uint16_t file, uint32_t *size, uint16_t *crc) {
+    Header h;
+    if (!validFile(file) || !flash.read(slotOffset(file) + FILE_BYTES, (uint8_t *)&h, sizeof(h))) {
+        return false;
+    }
+    if (h.magic != HEADER_MAGIC || h.size > FILE_BYTES) {
+        return false;
+    }
+    if (size) {
+        *size = h.size;
+    }
+    if (crc) {
+        *crc = h.crc;
+    }
+    return true;
+}
+
+uint8_t ContentStore::readRecords(uint16_t file, uint32_t offset, uint8_t *dst, uint16_t len) {
+    bool active = state == STATUS_RECEIVING && file == transferFile;
+    uint32_t limit = 0;
+    if (active) {
+        limit = receivedBytes;
+    } else if (!fileInfo(file, &limit, nullptr)) {
+        return EX_ILLEGAL_ADDRESS;
+    }
+    if (offset + len > limit) {
+        return EX_ILLEGAL_ADDRESS;
+    }
+    if (!flash.read(slotOffset(file) + offset, dst, len)) {
+        return EX_DEVICE_FAILURE;
+    }
+
+    // Henüz flash'a yazılmamış kısım tampondan gelir
+    if (active && bufferedSector >= 0) {
+        uint32_t secStart = (uint32_t)bufferedSector * FlashDevice::SECTOR_SIZE;
+        uint32_t secEnd = secStart + FlashDevice::SECTOR_SIZE;
+        uint32_t from = offset > secStart ? offset : secStart;
+        uint32_t to = offset + len < secEnd ? offset + len : secEnd;
+        if (from < to) {
+            memcpy(dst + (from - offset), sector + (from - secStart), to - from);
+        }
+    }
+    return 0;
+}
+
+uint8_t ContentStore::writeRecords(uint16_t file, uint32_t offset, const uint8_t *src, uint16_t len) {
+    // Sadece aktif aktarıma ve alınmış önekin içinden/sonundan yazılabilir
+    if (state != STATUS_RECEIVING || file != transferFile ||
+        offset > receivedBytes || offset + len > expectedSize) {
+        return EX_ILLEGAL_ADDRESS;
+    }
+
+    uint32_t end = offset + len;
+    // Flash'a yazılmış kısım tekrar gönderilmişse atlanır
+    if (offset < flushedBytes) {
+        uint32_t skip = (end < flushedBytes ? end : flushedBytes) - offset;
+        src += skip;
+        offset += skip;
+    }
+
+    while (offset < end) {
+        int8_t sec = offset / FlashDevice::SECTOR_SIZE;
+        if (sec != bufferedSector) {
+            if (!flushSector()) {
+                return EX_DEVICE_FAILURE;
+            }
+            memset(sector, 0xFF, FlashDevice::SECTOR_SIZE);
+            bufferedSector = sec;
+        }
+        uint32_t inSector = offset % FlashDevice::SECTOR_SIZE;
+        uint32_t n = FlashDevice::SECTOR_SIZE - inSector;
+        if (n > end - offset) {
+            n = end - offset;
+        }
+        memcpy(sector + inSector, src, n);
+        src += n;
+        offset += n;
+    }
+
+    if (end > receivedBytes) {
+        receivedBytes = end;
+    }
+    return 0;
+}
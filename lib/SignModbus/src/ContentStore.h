@@ -0,0 +1,101 @@
+/*
+ * Flash içerik deposu (fontlar, bitmapler, oynatma listeleri).
+ *
+ * Modbus dosya kayıtları (FC20/21) bu depoya okunur/yazılır. Her dosya
+ * flash'ta sabit bir yuvadır: 10000 kayıt x 2 bayt = 20000 bayt veri ve
+ * yuvanın sonunda küçük bir başlık (boyut + CRC).
+ *
+ * Yazma akışı:
+ *   beginTransfer(dosya, boyut, crc) -> kayıtlar sırayla (ya da kaldığı
+ *   yerden) yazılır -> commitTransfer() CRC'yi flash'tan doğrular.
+ * Gelen veri bir sektörlük RAM tamponunda toplanır, sektör dolunca tek
+ * seferde silinip yazılır. received() kesintisiz alınan önek uzunluğudur;
+ * bağlantı koparsa master aktarıma oradan devam eder.
+ */
+
+#ifndef CONTENT_STORE_H
+#define CONTENT_STORE_H
+
+#include <stdint.h>
+
+// Ham flash bölgesi (bölge içi ofsetlerle)
+class FlashDevice {
+public:
+    static const uint16_t SECTOR_SIZE = 4096;
+
+    virtual uint32_t size() const = 0;
+    virtual bool eraseSector(uint32_t offset) = 0;
+    virtual bool write(uint32_t offset, const uint8_t *src, uint32_t len) = 0;
+    virtual bool read(uint32_t offset, uint8_t *dst, uint32_t len) = 0;
+};
+
+// RtuSlave'in dosya kayıtlarına eriştiği arayüz. Dönüş: 0 ya da
+// Modbus istisna kodu.
+class FileRecordStore {
+public:
+    virtual uint8_t readRecords(uint16_t file, uint32_t offset, uint8_t *dst, uint16_t len) = 0;
+    virtual uint8_t writeRecords(uint16_t file, uint32_t offset, const uint8_t *src, uint16_t len) = 0;
+};
+
+class ContentStore : public FileRecordStore {
+public:
+    static const uint8_t MAX_FILES = 16;
+    static const uint16_t FILE_BYTES = 20000;
+    static const uint8_t SLOT_SECTORS = 5;
+
+    enum Status {
+        STATUS_IDLE = 0,
+        STATUS_RECEIVING = 1,
+        STATUS_VERIFIED = 2,
+        STATUS_CRC_ERROR = 3,
+        STATUS_FLASH_ERROR = 4,
+        STATUS_BAD_REQUEST = 5
+    };
+
+    explicit ContentStore(FlashDevice &flash);
+
+    // Bölgeye sığan dosya sayısını hesapla
+    void begin();
+    uint8_t fileCount() const { return files; }
+
+    Status beginTransfer(uint16_t file, uint32_t size, uint16_t crc);
+    Status commitTransfer();
+    void abortTransfer();
+
+    Status status() const { return state; }
+    uint16_t activeFile() const { return transferFile; }
+    uint32_t received() const { return receivedBytes; }
+
+    // Tamamlanmış dosyanın boyutu ve CRC'si (geçerli değilse false)
+    bool fileInfo(uint16_t file, uint32_t *size, uint16_t *crc);
+
+    uint8_t readRecords(uint16_t file, uint32_t offset, uint8_t *dst, uint16_t len) override;
+    uint8_t writeRecords(uint16_t file, uint32_t offset, const uint8_t *src, uint16_t len) override;
+
+private:
+    struct Header {
+        uint32_t magic;
+        uint32_t size;
+        uint32_t crc;
+    };
+
+    FlashDevice &flash;
+    uint8_t files;
+
+    Status state;
+    uint16_t transferFile;
+    uint32_t expectedSize;
+    uint16_t expectedCrc;
+    uint32_t receivedBytes;
+    uint32_t flushedBytes;
+
+    // Yazılmakta olan sektör (-1 = yok)
+    uint8_t sector[FlashDevice::SECTOR_SIZE];
+    int8_t bufferedSector;
+
+    uint32_t slotOffset(uint16_t file) const;
+    bool flushSector();
+    bool validFile(uint16_t file) const { return file >= 1 && file <= files; }
+};
+
+#endif
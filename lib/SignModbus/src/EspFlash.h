@@ -0,0 +1,60 @@
+/*
+ * ESP8266 flash'ında içerik deposu bölgesi.
+ *
+ * Dosya sistemi bölgesi (FS_PHYS_ADDR / FS_PHYS_SIZE) ham olarak kullanılır;
+ * proje LittleFS/SPIFFS bağlamaz. Silme/yazma sırasında önbellek kapalı
+ * olduğundan flash'taki kodu çalıştıran kesmeler durdurulmalıdır; bunun
+ * için 'guard' çağrılır (true = işlem başlıyor, false = bitti).
+ */
+
+#ifndef ESP_FLASH_H
+#define ESP_FLASH_H
+
+#if defined(ESP8266)
+
+#include <Arduino.h>
+#include <flash_hal.h>
+
+#include "ContentStore.h"
+
+class EspFlash : public FlashDevice {
+public:
+    typedef void (*Guard)(bool busy);
+
+    explicit EspFlash(Guard guard = nullptr) : guard(guard) {}
+
+    uint32_t size() const override {
+        return FS_PHYS_SIZE;
+    }
+
+    bool eraseSector(uint32_t offset) override {
+        lock(true);
+        bool ok = flash_hal_erase(FS_PHYS_ADDR + offset, SECTOR_SIZE) == FLASH_HAL_OK;
+        lock(false);
+        return ok;
+    }
+
+    bool write(uint32_t offset, const uint8_t *src, uint32_t len) override {
+        lock(true);
+        bool ok = flash_hal_write(FS_PHYS_ADDR + offset, len, src) == FLASH_HAL_OK;
+        lock(false);
+        return ok;
+    }
+
+    bool read(uint32_t offset, uint8_t *dst, uint32_t len) override {
+        return flash_hal_read(FS_PHYS_ADDR + offset, len, dst) == FLASH_HAL_OK;
+    }
+
+private:
+    Guard guard;
+
+    void lock(bool busy) {
+        if (guard) {
+            guard(busy);
+        }
+    }
+};
+
+#endif
+
+#endif
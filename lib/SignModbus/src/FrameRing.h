@@ -0,0 +1,100 @@
+/*
+ * RX halka tamponu ve kopyasız çerçeve görünümü.
+ *
+ * Gelen baytlar doğrudan halkaya yazılır. Bir çerçeve tamamlandığında
+ * FrameView halkadaki baytları yerinde gösterir: ayrıştırma ve CRC
+ * kontrolü geçici bir tampona kopyalamadan yapılır. Halkanın sonunu
+ * aşan çerçeve en fazla iki parça halindedir.
+ */
+
+#ifndef FRAME_RING_H
+#define FRAME_RING_H
+
+#include <stdint.h>
+
+#include "ModbusCrc.h"
+
+// Boyut 2'nin kuvveti olmalı (indeks maskeleme için)
+#define FRAME_RING_SIZE 512
+#define FRAME_RING_MASK (FRAME_RING_SIZE - 1)
+
+class FrameRing {
+public:
+    FrameRing() : head(0), tail(0), overruns(0) {}
+
+    // Yer yoksa bayt atılır ve taşma sayılır
+    bool push(uint8_t b) {
+        uint16_t next = (head + 1) & FRAME_RING_MASK;
+        if (next == tail) {
+            overruns++;
+            return false;
+        }
+        buf[head] = b;
+        head = next;
+        return true;
+    }
+
+    uint16_t size() const { return (head - tail) & FRAME_RING_MASK; }
+    bool empty() const { return head == tail; }
+
+    uint16_t readIndex() const { return tail; }
+    uint16_t writeIndex() const { return head; }
+
+    // İşlenen baytları serbest bırak
+    void consume(uint16_t n) { tail = (tail + n) & FRAME_RING_MASK; }
+    void clear() { tail = head; }
+
+    // Henüz işlenmemiş son baytları geri al (atılan çerçeve için)
+    void truncate(uint16_t index) { head = index & FRAME_RING_MASK; }
+
+    uint8_t at(uint16_t index) const { return buf[index & FRAME_RING_MASK]; }
+
+    // [start, start+len) aralığının CRC'si, en fazla iki parça
+    uint16_t crc(uint16_t start, uint16_t len) const {
+        start &= FRAME_RING_MASK;
+        uint16_t first = FRAME_RING_SIZE - start;
+        if (first >= len) {
+            return modbusCrc(buf + start, len);
+        }
+        return modbusCrc(buf, len - first, modbusCrc(buf + start, first));
+    }
+
+    uint32_t overrunCount() const { return overruns; }
+
+private:
+    uint8_t buf[FRAME_RING_SIZE];
+    volatile uint16_t head;
+    volatile uint16_t tail;
+    uint32_t overruns;
+};
+
+// Halkadaki bir çerçeveye kopyasız erişim
+class FrameView {
+public:
+    FrameView(const FrameRing &ring, uint16_t start, uint16_t len)
+        : ring(ring), start(start), len(len) {}
+
+    uint16_t length() const { return len; }
+    uint8_t operator[](uint16_t i) const { return ring.at(start + i); }
+
+    // Modbus sırası: üst bayt önce
+    uint16_t u16(uint16_t i) const {
+        return ((uint16_t)ring.at(start + i) << 8) | ring.at(start + i + 1);
+    }
+
+    // Son iki bayt CRC (alt bayt önce)
+    bool crcValid() const {
+        if (len < 4) {
+            return false;
+        }
+        uint16_t expected = ring.at(start + len - 2) | ((uint16_t)ring.at(start + len - 1) << 8);
+        return ring.crc(start, len - 2) == expected;
+    }
+
+private:
+    const FrameRing &ring;
+    uint16_t start;
+    uint16_t len;
+};
+
+#endif
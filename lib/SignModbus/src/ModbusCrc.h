@@ -0,0 +1,20 @@
+/*
+ * Modbus RTU CRC16 (polinom 0xA001, başlangıç 0xFFFF).
+ *
+ * Bayt başına 8 bitlik döngü yerine 256 girişlik tablo kullanılır; her
+ * bayt bir tablo okuması ve bir XOR'dur. Tablo RAM'de durur (512 bayt),
+ * flash önbellek kaçırmaları CRC süresine eklenmez.
+ */
+
+#ifndef MODBUS_CRC_H
+#define MODBUS_CRC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define MODBUS_CRC_INIT 0xFFFF
+
+// 'crc' önceki parçanın sonucu olabilir (parçalı hesap için)
+uint16_t modbusCrc(const uint8_t *data, size_t len, uint16_t crc = MODBUS_CRC_INIT);
+
+#endif
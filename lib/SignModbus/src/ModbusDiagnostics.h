@@ -0,0 +1,67 @@
+/*
+ * Modbus haberleşme sayaçları ve olay kaydı (FC08 / FC11 / FC12).
+ *
+ * Sayaçlar çerçeve yolunda birer artırma ile tutulur. Olay kaydı
+ * spesifikasyondaki 64 baytlık kayıttır (en yeni olay önce okunur):
+ *   0x80 | bayraklar  alma olayı (0x02 CRC hatası, 0x10 taşma,
+ *                     0x20 dinleme modu, 0x40 yayın)
+ *   0x40 | bayraklar  gönderme olayı (0x01 okuma istisnası 1-3,
+ *                     0x02 iptal istisnası 4, 0x04 meşgul 5-6, 0x20 dinleme modu)
+ *   0x04              dinleme moduna geçildi
+ *   0x00              haberleşme yeniden başlatıldı
+ */
+
+#ifndef MODBUS_DIAGNOSTICS_H
+#define MODBUS_DIAGNOSTICS_H
+
+#include <stdint.h>
+
+struct ModbusDiagnostics {
+    static const uint8_t EVENT_LOG_SIZE = 64;
+
+    // FC08 alt fonksiyon sayaçları (16 bit, spesifikasyon gibi sararak)
+    uint16_t busMessages;     // 0x0B: hatta görülen tüm çerçeveler
+    uint16_t crcErrors;       // 0x0C: CRC hatalı çerçeveler
+    uint16_t exceptions;      // 0x0D: gönderilen istisna yanıtları
+    uint16_t slaveMessages;   // 0x0E: bu slave'e (ve yayına) gelenler
+    uint16_t noResponses;     // 0x0F: yanıt verilmeyenler (yayın, dinleme modu)
+    uint16_t busyCount;       // 0x11: sıra dolu diye atılanlar + meşgul istisnaları
+    uint16_t overruns;        // 0x12: taşan / boyu aşan çerçeveler
+
+    // FC11: başarıyla tamamlanan mesajlar (FC11/12 hariç)
+    uint16_t eventCount;
+
+    ModbusDiagnostics() { clear(); logCount = 0; logHead = 0; }
+
+    void clear() {
+        busMessages = crcErrors = exceptions = slaveMessages = 0;
+        noResponses = busyCount = overruns = eventCount = 0;
+    }
+
+    void logEvent(uint8_t event) {
+        log[logHead] = event;
+        logHead = (logHead + 1) % EVENT_LOG_SIZE;
+        if (logCount < EVENT_LOG_SIZE) {
+            logCount++;
+        }
+    }
+
+    void clearLog() {
+        logCount = 0;
+        logHead = 0;
+    }
+
+    uint8_t logSize() const { return logCount; }
+
+    // i = 0 en yeni olay
+    uint8_t logAt(uint8_t i) const {
+        return log[(logHead + EVENT_LOG_SIZE - 1 - i) % EVENT_LOG_SIZE];
+    }
+
+private:
+    uint8_t log[EVENT_LOG_SIZE];
+    uint8_t logCount;
+    uint8_t logHead;
+};
+
+#endif
@@ -0,0 +1,176 @@
+/*
+ * Derleme zamanı register haritası.
+ *
+ * Register düzeni tek bir constexpr RegisterDef tablosunda tanımlanır.
+ * Holding / input bankalarının boyutu, adres -> tanım indeksi ve başlangıç
+ * değerleri bu tablodan derleme zamanında üretilir. Yazmadan sonra
+ * applyWrite() yazılan register'ları tanımdaki aralığa kırpar ve eylem
+ * bitlerini döndürür; çalışma zamanında arama ya da elle ayrıştırma yoktur.
+ *
+ * Örnek:
+ *   constexpr RegisterDef MAP[] = {
+ *       // adres, adet, tür, min, max, eylem, başlangıç[, 0 serbest]
+ *       { 0, 1, REG_HOLDING, 0, 5, ACT_DISPLAY, 1 },
+ *       { 1, 1, REG_HOLDING, 20, 1000, ACT_DISPLAY, 0, true },  // 0 = varsayılan
+ *       ...
+ *   };
+ *   RegisterTable<MAP, sizeof(MAP) / sizeof(MAP[0])> regs;
+ */
+
+#ifndef REGISTER_MAP_H
+#define REGISTER_MAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+enum RegisterKind : uint8_t {
+    REG_HOLDING,
+    REG_INPUT
+};
+
+struct RegisterDef {
+    uint16_t addr;
+    uint16_t count;    // blok uzunluğu (register)
+    RegisterKind kind;
+    int32_t min;       // min < 0 ise register işaretli (int16) yorumlanır
+    int32_t max;
+    uint8_t action;    // yazılınca tetiklenen eylem (0 = yok, en fazla 31)
+    uint16_t init;
+    bool zeroAllowed = false;  // 0 aralık dışında da kabul edilir ("varsayılan" / "kapalı")
+};
+
+namespace regmap {
+
+static constexpr uint8_t NO_DEF = 0xFF;
+
+// Türün kapladığı adres aralığının sonu (banka boyutu)
+constexpr uint16_t span(const RegisterDef *defs, size_t n, RegisterKind kind) {
+    uint16_t end = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (defs[i].kind == kind && defs[i].addr + defs[i].count > end) {
+            end = defs[i].addr + defs[i].count;
+        }
+    }
+    return end;
+}
+
+// Bloklar çakışmamalı, aralıklar ve eylemler geçerli olmalı
+constexpr bool valid(const RegisterDef *defs, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        const RegisterDef &a = defs[i];
+        if (a.count == 0 || a.min > a.max || a.action > 31) {
+            return false;
+        }
+        if (a.min < 0 ? (a.min < -32768 || a.max > 32767) : a.max > 0xFFFF) {
+            return false;
+        }
+        for (size_t j = i + 1; j < n; j++) {
+            const RegisterDef &b = defs[j];
+            if (a.kind == b.kind && a.addr < b.addr + b.count && b.addr < a.addr + a.count) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template <uint16_t SIZE>
+struct Index {
+    uint8_t def[SIZE > 0 ? SIZE : 1];
+};
+
+// Adres -> tanım indeksi tablosu (tanımsız adres = NO_DEF)
+template <uint16_t SIZE>
+constexpr Index<SIZE> buildIndex(const RegisterDef *defs, size_t n, RegisterKind kind) {
+    Index<SIZE> idx{};
+    for (uint16_t a = 0; a < SIZE; a++) {
+        idx.def[a] = NO_DEF;
+    }
+    for (size_t i = 0; i < n; i++) {
+        if (defs[i].kind != kind) {
+            continue;
+        }
+        for (uint16_t k = 0; k < defs[i].count; k++) {
+            idx.def[defs[i].addr + k] = (uint8_t)i;
+        }
+    }
+    return idx;
+}
+
+}  // namespace regmap
+
+template <const RegisterDef *MAP, size_t N>
+class RegisterTable {
+public:
+    static constexpr uint16_t HOLDING_COUNT = regmap::span(MAP, N, REG_HOLDING);
+    static constexpr uint16_t INPUT_COUNT = regmap::span(MAP, N, REG_INPUT);
+
+    static_assert(N < regmap::NO_DEF, "Register tablosu cok uzun");
+    static_assert(regmap::valid(MAP, N), "Register tanimlari cakisiyor ya da aralik hatali");
+
+    uint16_t holding[HOLDING_COUNT > 0 ? HOLDING_COUNT : 1];
+    uint16_t input[INPUT_COUNT > 0 ? INPUT_COUNT : 1];
+
+    // Tüm register'ları tablodaki başlangıç değerlerine döndür
+    void reset() {
+        for (uint16_t a = 0; a < HOLDING_COUNT; a++) {
+            holding[a] = initial(holdingIndex.def[a]);
+        }
+        for (uint16_t a = 0; a < INPUT_COUNT; a++) {
+            input[a] = initial(inputIndex.def[a]);
+        }
+    }
+
+    // Yazılmış [start, start+count) aralığını kırp; eylem bitlerini döndür
+    // (bit n = eylem n). Tanımsız adresler olduğu gibi kalır.
+    uint32_t applyWrite(uint16_t start, uint16_t count) {
+        uint32_t actions = 0;
+        for (uint16_t a = start; a < start + count && a < HOLDING_COUNT; a++) {
+            uint8_t i = holdingIndex.def[a];
+            if (i == regmap::NO_DEF) {
+                continue;
+            }
+            const RegisterDef &d = MAP[i];
+            holding[a] = clamp(d, holding[a]);
+            if (d.action) {
+                actions |= 1UL << d.action;
+            }
+        }
+        return actions;
+    }
+
+    // Holding register değeri (işaretli tanımlarda int16)
+    int32_t value(uint16_t addr) const {
+        uint8_t i = holdingIndex.def[addr];
+        return i == regmap::NO_DEF ? holding[addr] : signedValue(MAP[i], holding[addr]);
+    }
+
+    static const RegisterDef *holdingDef(uint16_t addr) {
+        uint8_t i = addr < HOLDING_COUNT ? holdingIndex.def[addr] : regmap::NO_DEF;
+        return i == regmap::NO_DEF ? nullptr : &MAP[i];
+    }
+
+private:
+    static constexpr regmap::Index<HOLDING_COUNT> holdingIndex =
+        regmap::buildIndex<HOLDING_COUNT>(MAP, N, REG_HOLDING);
+    static constexpr regmap::Index<INPUT_COUNT> inputIndex =
+        regmap::buildIndex<INPUT_COUNT>(MAP, N, REG_INPUT);
+
+    static uint16_t initial(uint8_t i) {
+        return i == regmap::NO_DEF ? 0 : MAP[i].init;
+    }
+
+    static int32_t signedValue(const RegisterDef &d, uint16_t raw) {
+        return d.min < 0 ? (int32_t)(int16_t)raw : (int32_t)raw;
+    }
+
+    static uint16_t clamp(const RegisterDef &d, uint16_t raw) {
+        int32_t v = signedValue(d, raw);
+        if (v == 0 && d.zeroAllowed) {
+            return raw;
+        }
+        return (uint16_t)(v < d.min ? d.min : v > d.max ? d.max : v);
+    }
+};
+
+#endif
@@ -0,0 +1,46 @@
+#include "ResponseCache.h"
+
+#include <string.h>
+
+const uint8_t *ResponseCache::lookup(uint8_t bank, uint8_t fc, uint16_t start, uint16_t count, uint16_t *len) {
+    for (uint8_t i = 0; i < ENTRIES; i++) {
+        const Entry &e = entries[i];
+        if (e.fc == fc && e.bank == bank && e.start == start && e.count == count) {
+            hitCount++;
+            *len = e.len;
+            return e.frame;
+        }
+    }
+    missCount++;
+    return nullptr;
+}
+
+void ResponseCache::store(uint8_t bank, uint8_t fc, uint16_t start, uint16_t count, const uint8_t *frame, uint16_t len) {
+    if (len > MAX_FRAME) {
+        return;
+    }
+    // Sırayla üzerine yaz (en eski kayıt gider)
+    Entry &e = entries[next];
+    next = (next + 1) % ENTRIES;
+    e.fc = fc;
+    e.bank = bank;
+    e.start = start;
+    e.count = count;
+    e.len = len;
+    memcpy(e.frame, frame, len);
+}
+
+void ResponseCache::invalidate(uint8_t bank, uint8_t fc, uint16_t start, uint16_t count) {
+    for (uint8_t i = 0; i < ENTRIES; i++) {
+        Entry &e = entries[i];
+        if (e.fc == fc && e.bank == bank && e.start < start + count && start < e.start + e.count) {
+            e.fc = 0;
+        }
+    }
+}
+
+void ResponseCache::clear() {
+    for (uint8_t i = 0; i < ENTRIES; i++) {
+        entries[i].fc = 0;
+    }
+}
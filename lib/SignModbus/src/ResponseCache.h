@@ -0,0 +1,54 @@
+/*
+ * Değişmeyen register okumaları için hazır yanıt önbelleği.
+ *
+ * Master her döngüde aynı aralıkları sorar. İlk okumada kurulan yanıt
+ * çerçevesi (CRC dahil) (banka, fonksiyon, başlangıç, adet) anahtarıyla saklanır;
+ * tekrar eden okuma register serileştirmesi ve CRC hesabı yapılmadan
+ * doğrudan gönderilir. Aralığa dokunan her yazma kaydı geçersiz kılar.
+ */
+
+#ifndef RESPONSE_CACHE_H
+#define RESPONSE_CACHE_H
+
+#include <stdint.h>
+
+class ResponseCache {
+public:
+    static const uint8_t ENTRIES = 4;
+
+    // En fazla 29 register'lık okuma önbelleğe alınır (3 + 58 + 2 bayt)
+    static const uint8_t MAX_FRAME = 64;
+
+    ResponseCache() : next(0), hitCount(0), missCount(0) { clear(); }
+
+    // Önbellekte varsa çerçeveyi döndürür, yoksa nullptr
+    const uint8_t *lookup(uint8_t bank, uint8_t fc, uint16_t start, uint16_t count, uint16_t *len);
+
+    // Yeni kurulan yanıtı sakla (sığmıyorsa yok sayılır)
+    void store(uint8_t bank, uint8_t fc, uint16_t start, uint16_t count, const uint8_t *frame, uint16_t len);
+
+    // 'bank' içinde 'fc' okumasıyla dönen dizide [start, start+count) değişti
+    void invalidate(uint8_t bank, uint8_t fc, uint16_t start, uint16_t count);
+
+    void clear();
+
+    uint32_t hits() const { return hitCount; }
+    uint32_t misses() const { return missCount; }
+
+private:
+    struct Entry {
+        uint8_t fc;  // 0 = boş
+        uint8_t bank;
+        uint8_t len;
+        uint16_t start;
+        uint16_t count;
+        uint8_t frame[MAX_FRAME];
+    };
+
+    Entry entries[ENTRIES];
+    uint8_t next;
+    uint32_t hitCount;
+    uint32_t missCount;
+};
+
+#endif
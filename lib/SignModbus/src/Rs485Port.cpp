@@ -0,0 +1,160 @@
+#include "Rs485Port.h"
+
+#if defined(ESP8266)
+
+#include <ets_sys.h>
+
+// UART0 kesme bitleri: RX FIFO dolu (eşik 1 bayt), taşma, çerçeve hatası
+static const uint32_t RX_INTS = (1 << UIFF) | (1 << UIOF) | (1 << UIFR);
+
+static inline uint8_t rxFifoCount() {
+    return (USS(0) >> USRXC) & 0xFF;
+}
+
+static inline uint8_t txFifoCount() {
+    return (USS(0) >> USTXC) & 0xFF;
+}
+
+// TX FIFO'daki bayt sayısı 'threshold'un altına inince boşalma kesmesi gelir
+static inline void setTxThreshold(uint8_t threshold) {
+    USC1(0) = (1 << UCFFT) | ((uint32_t)threshold << UCFET);
+}
+
+Rs485Port::Rs485Port(uint8_t dePin)
+    : dePin(dePin), charUs(1042), head(0), tail(0), lastRxUs(0), txLen(0), txPos(0), txStartUs(0),
+      transmitting(false), overrunCount(0), framingCount(0), turnaroundUs(0), turnaroundMaxUs(0),
+      releaseMaxUs(0) {}
+
+void Rs485Port::begin(uint32_t baud) {
+    charUs = 10000000UL / baud;
+    pinMode(dePin, OUTPUT);
+    digitalWrite(dePin, LOW);
+
+    ETS_UART_INTR_DISABLE();
+    pinMode(1, SPECIAL);
+    pinMode(3, SPECIAL);
+    USD(0) = ESP8266_CLOCK / baud;
+    USC0(0) = (3 << UCBN) | (1 << UCSBN) | (1 << UCRXRST) | (1 << UCTXRST);  // 8N1
+    USC0(0) = (3 << UCBN) | (1 << UCSBN);
+    setTxThreshold(1);
+    USIC(0) = 0xFFFF;
+    USIE(0) = RX_INTS;
+    ETS_UART_INTR_ATTACH(uartIsr, this);
+    ETS_UART_INTR_ENABLE();
+}
+
+void IRAM_ATTR Rs485Port::uartIsr(void *arg, void *frame) {
+    Rs485Port *port = (Rs485Port *)arg;
+    uint32_t status = USIS(0);
+    if (status & RX_INTS) {
+        port->onReceive(status);
+    }
+    if (status & (1 << UIFE)) {
+        port->onTxEmpty();
+    }
+    // Dolu kesmesi FIFO boşaldıktan sonra temizlenir
+    USIC(0) = status;
+}
+
+void IRAM_ATTR Rs485Port::onReceive(uint32_t status) {
+    uint32_t nowUs = micros();
+    if (status & (1 << UIFR)) {
+        framingCount++;
+    }
+    if (status & (1 << UIOF)) {
+        overrunCount++;
+    }
+    uint8_t n = rxFifoCount();
+    for (uint8_t i = 0; i < n; i++) {
+        uint8_t b = USF(0);
+        // Alıcı DE yüksekken kapalıdır; boştaki hattan gelenler atılır
+        if (transmitting) {
+            continue;
+        }
+        // FIFO'daki son bayt şimdi bitti, öncekiler birer karakter önce
+        uint32_t stamp = nowUs - (uint32_t)(n - 1 - i) * charUs;
+        lastRxUs = stamp;
+        uint16_t next = (head + 1) & (RX_SIZE - 1);
+        if (next == tail) {
+            overrunCount++;
+            continue;
+        }
+        rxData[head] = b;
+        rxStamp[head] = stamp;
+        head = next;
+    }
+}
+
+void IRAM_ATTR Rs485Port::fillTx() {
+    while (txPos < txLen && txFifoCount() < FIFO_SIZE - 1) {
+        USF(0) = txData[txPos++];
+    }
+    // Hepsi FIFO'daysa kesme FIFO tamamen boşalınca gelir
+    setTxThreshold(txPos < txLen ? TX_REFILL : 1);
+}
+
+void IRAM_ATTR Rs485Port::onTxEmpty() {
+    if (!transmitting) {
+        USIE(0) &= ~(1 << UIFE);
+        return;
+    }
+    if (txPos < txLen || txFifoCount() > 0) {
+        fillTx();
+        return;
+    }
+    // Son bayt kaydırıcıda; çerçevenin beklenen sonuna kadar beklenir
+    // (FIFO hiç boşalmadığı için baytlar arası boşluk yoktur)
+    uint32_t endUs = txStartUs + (uint32_t)txLen * charUs;
+    uint32_t waitUs = micros();
+    while ((int32_t)(micros() - endUs) < 0 && micros() - waitUs < 2 * charUs) {
+    }
+    digitalWrite(dePin, LOW);
+
+    uint32_t lateUs = micros() - endUs;
+    if ((int32_t)lateUs > 0 && lateUs > releaseMaxUs) {
+        releaseMaxUs = lateUs;
+    }
+    USIE(0) &= ~(1 << UIFE);
+    transmitting = false;
+}
+
+bool Rs485Port::read(uint8_t &b, uint32_t &stampUs) {
+    if (tail == head) {
+        return false;
+    }
+    b = rxData[tail];
+    stampUs = rxStamp[tail];
+    tail = (tail + 1) & (RX_SIZE - 1);
+    return true;
+}
+
+void Rs485Port::send(const uint8_t *data, uint16_t len) {
+    // Yarı çift yönlü hatta önceki yanıt bitmeden yenisi olmaz; yine de
+    // tampon yeniden yazılmadan önce beklenir
+    while (transmitting) {
+        yield();
+    }
+    if (len > sizeof(txData)) {
+        len = sizeof(txData);
+    }
+    memcpy(txData, data, len);
+
+    uint32_t startUs = micros();
+    turnaroundUs = startUs - lastRxUs;
+    if (turnaroundUs > turnaroundMaxUs) {
+        turnaroundMaxUs = turnaroundUs;
+    }
+
+    ETS_UART_INTR_DISABLE();
+    transmitting = true;
+    txLen = len;
+    txPos = 0;
+    digitalWrite(dePin, HIGH);
+    txStartUs = micros();
+    fillTx();
+    USIC(0) = 1 << UIFE;
+    USIE(0) |= 1 << UIFE;
+    ETS_UART_INTR_ENABLE();
+}
+
+#endif
@@ -0,0 +1,93 @@
+/*
+ * RS485 yarı çift yönlü port (ESP8266, UART0).
+ *
+ * Transceiver UART0'ın kendi pinlerine bağlıdır (GPIO3 = RX, GPIO1 = TX);
+ * bitleri UART donanımı çözer. Serial.swap() pinleri (GPIO13/15) panelin
+ * SPI MOSI'si ve DE ile çakıştığı için kullanılmaz. UART0 bu sınıfa
+ * aittir: Serial başlatılmamalı, hata ayıklama çıktısı Serial1'e (GPIO2)
+ * yazılır. USB'den yükleme sırasında transceiver'ın RO ucu ayrılmalıdır.
+ *
+ * Alım: RX FIFO'ya her bayt düştüğünde kesme gelir; kesme FIFO'yu RX
+ * halkasına boşaltır ve her baytı stop bitinin bittiği anla yazar. Kesme
+ * gecikirse (panel taraması aynı seviyededir) FIFO'da birden çok bayt
+ * birikir; son bayt kesme anında bitmiş, öncekiler birer karakter önce
+ * bitmiş sayılır. Baytlar ana döngü meşgulken (uzun çizim, flash yazma)
+ * halkada bekler; zaman damgaları hatta geldikleri ana aittir, çerçeve
+ * sınırları (t3.5) bu yüzden doğru kalır. Halka dolarsa bayt atılır ve
+ * sayılır; FIFO taşması da taşma sayılır.
+ *
+ * Gönderim: send() yanıtı kopyalar, DE/RE'yi kaldırır, TX FIFO'yu doldurur
+ * ve döner. FIFO boşalma kesmesi kalan baytları ekler; son bayt FIFO'dan
+ * kaydırıcıya geçince kesme çerçevenin beklenen bitişine kadar (en fazla
+ * bir karakter süresi) bekler ve DE'yi indirir. Son istek baytından DE'nin
+ * kalkmasına kadar geçen süre (turnaround) ve son stop bitinden DE'nin
+ * inmesine kadarki gecikme ölçülür.
+ *
+ * Bitleri UART çözdüğü için kesme gecikmesi hızı sınırlamaz; 38400 baud'a
+ * kadar uygundur.
+ */
+
+#ifndef RS485_PORT_H
+#define RS485_PORT_H
+
+#if defined(ESP8266)
+
+#include <Arduino.h>
+
+#include "RtuSlave.h"
+
+class Rs485Port : public RtuTransport {
+public:
+    // 2'nin kuvveti; 9600 baud'da ~0.5 s'lik trafik
+    static const uint16_t RX_SIZE = 512;
+    static const uint8_t FIFO_SIZE = 128;
+    // FIFO'da bu kadar bayt kalınca yenisi eklenir (9600 baud'da ~33 ms)
+    static const uint8_t TX_REFILL = 32;
+
+    explicit Rs485Port(uint8_t dePin);
+
+    void begin(uint32_t baud);
+
+    // Sıradaki bayt ve stop bitinin bittiği an (us); halka boşsa false
+    bool read(uint8_t &b, uint32_t &stampUs);
+
+    // Bloke etmez; önceki gönderim sürüyorsa onun bitmesini bekler
+    void send(const uint8_t *data, uint16_t len) override;
+
+    uint32_t overruns() const { return overrunCount; }
+    uint32_t framingErrors() const { return framingCount; }
+    uint32_t lastTurnaroundUs() const { return turnaroundUs; }
+    uint32_t maxTurnaroundUs() const { return turnaroundMaxUs; }
+    uint32_t maxReleaseUs() const { return releaseMaxUs; }
+
+private:
+    uint8_t dePin;
+    uint32_t charUs;
+
+    uint8_t rxData[RX_SIZE];
+    uint32_t rxStamp[RX_SIZE];
+    volatile uint16_t head;
+    volatile uint16_t tail;
+    volatile uint32_t lastRxUs;
+
+    uint8_t txData[RtuSlave::MAX_ADU];
+    uint16_t txLen;
+    volatile uint16_t txPos;
+    uint32_t txStartUs;
+    volatile bool transmitting;
+
+    volatile uint32_t overrunCount;
+    volatile uint32_t framingCount;
+    uint32_t turnaroundUs;
+    uint32_t turnaroundMaxUs;
+    volatile uint32_t releaseMaxUs;
+
+    static void uartIsr(void *arg, void *frame);
+    void onReceive(uint32_t status);
+    void onTxEmpty();
+    void fillTx();
+};
+
+#endif
+
+#endif
@@ -0,0 +1,587 @@
+#include "RtuSlave.h"
+
+#include <string.h>
+
+RtuSlave::RtuSlave(RtuTransport &transport,
+                   uint16_t *holding, uint16_t holdingCount,
+                   uint16_t *input, uint16_t inputCount)
+    : transport(transport), banks(1), writeHandler(nullptr), fileStore(nullptr),
+      recorder(nullptr),
+      unit(1), t35Us(1750), listenOnly(false), curUnit(1), curBank(0), frameStart(0),
+      frameLen(0), frameOpen(false), frameOverflow(false), lastByteUs(0), taskUs(0),
+      responseLimitUs(0), pendingHead(0), pendingCount(0) {
+    memset(queue, 0, sizeof(queue));
+    bank[0].holding = holding;
+    bank[0].holdingCount = holdingCount;
+    bank[0].input = input;
+    bank[0].inputCount = inputCount;
+    memset(bankOf, NO_BANK, sizeof(bankOf));
+    bankOf[0] = 0;
+    bankOf[unit] = 0;
+}
+
+void RtuSlave::begin(uint8_t unitId, uint32_t baud) {
+    if (bankOf[unit] == 0) {
+        bankOf[unit] = NO_BANK;
+    }
+    unit = unitId;
+    bankOf[unit] = 0;
+    // 3.5 karakter (11 bit); 19200 üstünde spesifikasyondaki sabit 1750 us
+    t35Us = baud > 19200 ? 1750 : 38500000UL / baud;
+}
+
+int8_t RtuSlave::addBank(uint8_t unitId, uint16_t *holding, uint16_t holdingCount,
+                         uint16_t *input, uint16_t inputCount) {
+    if (banks >= MAX_BANKS || unitId == 0 || bankOf[unitId] != NO_BANK) {
+        return -1;
+    }
+    RegisterBank &b = bank[banks];
+    b.holding = holding;
+    b.holdingCount = holdingCount;
+    b.input = input;
+    b.inputCount = inputCount;
+    bankOf[unitId] = banks;
+    return banks++;
+}
+
+void RtuSlave::receive(uint8_t b, uint32_t nowUs) {
+    // Baytlar toplu okunduğunda çerçeve arası sessizlik zaman damgasından görülür
+    if (frameOpen && nowUs - lastByteUs >= t35Us) {
+        closeFrame();
+    }
+    if (!frameOpen) {
+        frameOpen = true;
+        frameOverflow = false;
+        frameStart = ring.writeIndex();
+        frameLen = 0;
+    }
+    lastByteUs = nowUs;
+    if (frameLen >= MAX_ADU || !ring.push(b)) {
+        frameOverflow = true;
+        return;
+    }
+    frameLen++;
+}
+
+void RtuSlave::closeFrame() {
+    frameOpen = false;
+    if (recorder) {
+        // Halkada iki parçaya bölünmüş olabilir
+        uint8_t copy[MAX_ADU];
+        for (uint16_t i = 0; i < frameLen; i++) {
+            copy[i] = ring.at(frameStart + i);
+        }
+        recorder->record(TrafficSink::DIR_RX, lastByteUs, copy, frameLen);
+    }
+    if (frameOverflow) {
+        // Çerçeve atılır: halka yazma indeksini çerçeve başına geri al
+        ring.truncate(frameStart);
+        diag.overruns++;
+        diag.logEvent(EVENT_RECEIVE | EVENT_RX_OVERRUN);
+        return;
+    }
+    if (pendingCount >= MAX_PENDING) {
+        // İşlenmeyi bekleyen çerçeve sırası dolu (ör. task() bir flash
+        // sektörü yazılırken bekledi): çerçeve meşgul sayılıp atılır
+        ring.truncate(frameStart);
+        diag.busyCount++;
+        return;
+    }
+    PendingFrame &f = pending[(pendingHead + pendingCount) % MAX_PENDING];
+    f.start = frameStart;
+    f.len = frameLen;
+    f.cls = classify(frameLen >= 2 ? ring.at(frameStart + 1) : 0);
+    f.endUs = lastByteUs;
+    pendingCount++;
+}
+
+uint8_t RtuSlave::classify(uint8_t fc) {
+    switch (fc) {
+        case FC_WRITE_SINGLE:
+        case FC_WRITE_MULTIPLE:
+        case FC_WRITE_FILE_RECORD:
+            return CLASS_WRITE;
+        default:
+            return CLASS_READ;
+    }
+}
+
+void RtuSlave::task(uint32_t nowUs) {
+    if (frameOpen && nowUs - lastByteUs >= t35Us) {
+        closeFrame();
+    }
+    if (pendingCount == 0) {
+        return;
+    }
+    taskUs = nowUs;
+
+    // Sınıf sırasıyla, sınıf içinde geliş sırasıyla işle. Çerçeveler halkada
+    // yerinde durduğu için halka hepsi işlendikten sonra bir kerede boşaltılır.
+    uint16_t consumed = 0;
+    for (uint8_t cls = 0; cls < CLASS_COUNT; cls++) {
+        for (uint8_t i = 0; i < pendingCount; i++) {
+            const PendingFrame &f = pending[(pendingHead + i) % MAX_PENDING];
+            if (f.cls != cls) {
+                continue;
+            }
+            QueueStats &q = queue[cls];
+            q.frames++;
+            q.lastDelayUs = nowUs - f.endUs;
+            if (q.lastDelayUs > q.maxDelayUs) {
+                q.maxDelayUs = q.lastDelayUs;
+            }
+            bool late = responseLimitUs && q.lastDelayUs > responseLimitUs;
+            process(FrameView(ring, f.start, f.len), late);
+            consumed += f.len;
+        }
+    }
+    ring.consume(consumed);
+    pendingHead = (pendingHead + pendingCount) % MAX_PENDING;
+    pendingCount = 0;
+}
+
+void RtuSlave::process(const FrameView &req, bool late) {
+    if (req.length() < 4) {
+        return;
+    }
+    // Bus sayaçları için CRC her çerçevede (başka slave'lere gidenlerde de) kontrol edilir
+    diag.busMessages++;
+    uint8_t dst = req[0];
+    if (!req.crcValid()) {
+        diag.crcErrors++;
+        if (dst != 0 && bankOf[dst] != NO_BANK) {
+            diag.logEvent(EVENT_RECEIVE | EVENT_RX_COMM_ERROR);
+        }
+        return;
+    }
+    curBank = bankOf[dst];
+    if (curBank == NO_BANK) {
+        return;
+    }
+    curUnit = dst;
+
+    diag.slaveMessages++;
+    diag.logEvent(EVENT_RECEIVE | (dst == 0 ? EVENT_RX_BROADCAST : 0) | (listenOnly ? EVENT_LISTEN_ONLY : 0));
+
+    // Dinleme modunda sadece "haberleşmeyi yeniden başlat" işlenir
+    if (listenOnly && !(req[1] == FC_DIAGNOSTICS && req.length() == 8 && req.u16(2) == DIAG_RESTART)) {
+        diag.noResponses++;
+        return;
+    }
+
+    // Yayın çerçevelerine ve sınırı aşmış isteklere yanıt verilmez
+    bool reply = dst != 0 && !late;
+    if (dst != 0 && late) {
+        queue[classify(req[1])].late++;
+    }
+    if (!reply) {
+        diag.noResponses++;
+    }
+    switch (req[1]) {
+        case FC_READ_HOLDING:
+            readRegisters(req, bank[curBank].holding, bank[curBank].holdingCount, reply);
+            break;
+        case FC_READ_INPUT:
+            readRegisters(req, bank[curBank].input, bank[curBank].inputCount, reply);
+            break;
+        case FC_WRITE_SINGLE:
+            writeSingle(req, reply);
+            break;
+        case FC_WRITE_MULTIPLE:
+            writeMultiple(req, reply);
+            break;
+        case FC_READ_FILE_RECORD:
+            readFileRecord(req, reply);
+            break;
+        case FC_WRITE_FILE_RECORD:
+            writeFileRecord(req, reply);
+            break;
+        case FC_DIAGNOSTICS:
+            diagnostics(req, reply);
+            break;
+        case FC_COMM_EVENT_COUNTER:
+            commEventCounter(req, reply);
+            break;
+        case FC_COMM_EVENT_LOG:
+            commEventLog(req, reply);
+            break;
+        default:
+            sendException(req, EX_ILLEGAL_FUNCTION, reply);
+            break;
+    }
+}
+
+void RtuSlave::readRegisters(const FrameView &req, const uint16_t *regs, uint16_t count, bool reply) {
+    if (req.length() != 8) {
+        sendException(req, EX_ILLEGAL_VALUE, reply);
+        return;
+    }
+    uint16_t start = req.u16(2);
+    uint16_t n = req.u16(4);
+    if (n == 0 || n > 125) {
+        sendException(req, EX_ILLEGAL_VALUE, reply);
+        return;
+    }
+    if ((uint32_t)start + n > count) {
+        sendException(req, EX_ILLEGAL_ADDRESS, reply);
+        return;
+    }
+    if (!reply) {
+        return;
+    }
+
+    uint8_t fc = req[1];
+    uint16_t len = 0;
+    const uint8_t *cached = cache.lookup(curBank, fc, start, n, &len);
+    if (cached) {
+        transmit(cached, len);
+        return;
+    }
+
+    tx[0] = curUnit;
+    tx[1] = fc;
+    tx[2] = n * 2;
+    uint8_t *p = tx + 3;
+    for (uint16_t i = 0; i < n; i++) {
+        uint16_t v = regs[start + i];
+        *p++ = v >> 8;
+        *p++ = v & 0xFF;
+    }
+    len = sendResponse(3 + n * 2);
+    cache.store(curBank, fc, start, n, tx, len);
+}
+
+void RtuSlave::writeSingle(const FrameView &req, bool reply) {
+    if (req.length() != 8) {
+        sendException(req, EX_ILLEGAL_VALUE, reply);
+        return;
+    }
+    uint16_t addr = req.u16(2);
+    RegisterBank &b = bank[curBank];
+    if (addr >= b.holdingCount) {
+        sendException(req, EX_ILLEGAL_ADDRESS, reply);
+        return;
+    }
+    b.holding[addr] = req.u16(4);
+    holdingChanged(addr, 1, curBank);
+    if (writeHandler) {
+        writeHandler(curBank, addr, 1);
+    }
+    if (!reply) {
+        return;
+    }
+    // Yanıt isteğin aynısıdır
+    for (uint8_t i = 0; i < 6; i++) {
+        tx[i] = req[i];
+    }
+    sendResponse(6);
+}
+
+void RtuSlave::writeMultiple(const FrameView &req, bool reply) {
+    if (req.length() < 9) {
+        sendException(req, EX_ILLEGAL_VALUE, reply);
+        return;
+    }
+    uint16_t start = req.u16(2);
+    uint16_t n = req.u16(4);
+    uint8_t byteCount = req[6];
+    if (n == 0 || n > 123 || byteCount != n * 2 || req.length() != 9 + byteCount) {
+        sendException(req, EX_ILLEGAL_VALUE, reply);
+        return;
+    }
+    RegisterBank &b = bank[curBank];
+    if ((uint32_t)start + n > b.holdingCount) {
+        sendException(req, EX_ILLEGAL_ADDRESS, reply);
+        return;
+    }
+    for (uint16_t i = 0; i < n; i++) {
+        b.holding[start + i] = req.u16(7 + i * 2);
+    }
+    holdingChanged(start, n, curBank);
+    if (writeHandler) {
+        writeHandler(curBank, start, n);
+    }
+    if (!reply) {
+        return;
+    }
+    for (uint8_t i = 0; i < 6; i++) {
+        tx[i] = req[i];
+    }
+    sendResponse(6);
+}
+
+// Dosya kaydı alt isteği: referans tipi 6, dosya, kayıt no, kayıt adedi.
+// Kayıt 2 bayttır; dosya içi ofset = kayıt no * 2.
+static const uint8_t FILE_REF_TYPE = 6;
+static const uint16_t MAX_RECORD = 9999;
+
+void RtuSlave::readFileRecord(const FrameView &req, bool reply) {
+    uint8_t byteCount = req.length() >= 5 ? req[2] : 0;
+    if (!fileStore) {
+        sendException(req, EX_ILLEGAL_FUNCTION, reply);
+        return;
+    }
+    if (byteCount < 7 || byteCount > 0xF5 || byteCount % 7 != 0 || req.length() != 5 + byteCount) {
+        sendException(req, EX_ILLEGAL_VALUE, reply);
+        return;
+    }
+
+    // Yanıt: [birim][fc][veri uzunluğu] + her alt istek için [uzunluk][6][veri]
+    uint16_t out = 3;
+    for (uint16_t i = 3; i < 3 + byteCount; i += 7) {
+        uint16_t file = req.u16(i + 1);
+        uint16_t record = req.u16(i + 3);
+        uint16_t count = req.u16(i + 5);
+        if (req[i] != FILE_REF_TYPE || file == 0 || record > MAX_RECORD || count == 0 ||
+            record + count > MAX_RECORD + 1) {
+            sendException(req, EX_ILLEGAL_ADDRESS, reply);
+            return;
+        }
+        if (out + 2 + count * 2 + 2 > MAX_ADU) {
+            sendException(req, EX_ILLEGAL_VALUE, reply);
+            return;
+        }
+        tx[out] = 1 + count * 2;
+        tx[out + 1] = FILE_REF_TYPE;
+        uint8_t err = fileStore->readRecords(file, (uint32_t)record * 2, tx + out + 2, count * 2);
+        if (err) {
+            sendException(req, err, reply);
+            return;
+        }
+        out += 2 + count * 2;
+    }
+    if (!reply) {
+        return;
+    }
+    tx[0] = curUnit;
+    tx[1] = req[1];
+    tx[2] = out - 3;
+    sendResponse(out);
+}
+
+void RtuSlave::writeFileRecord(const FrameView &req, bool reply) {
+    uint8_t byteCount = req.length() >= 5 ? req[2] : 0;
+    if (!fileStore) {
+        sendException(req, EX_ILLEGAL_FUNCTION, reply);
+        return;
+    }
+    if (byteCount < 9 || byteCount > 0xFB || req.length() != 5 + byteCount) {
+        sendException(req, EX_ILLEGAL_VALUE, reply);
+        return;
+    }
+
+    uint16_t end = 3 + byteCount;
+    for (uint16_t i = 3; i < end;) {
+        if (i + 7 > end) {
+            sendException(req, EX_ILLEGAL_VALUE, reply);
+            return;
+        }
+        uint16_t file = req.u16(i + 1);
+        uint16_t record = req.u16(i + 3);
+        uint16_t count = req.u16(i + 5);
+        if (i + 7 + count * 2 > end) {
+            sendException(req, EX_ILLEGAL_VALUE, reply);
+            return;
+        }
+        if (req[i] != FILE_REF_TYPE || file == 0 || record > MAX_RECORD || count == 0 ||
+            record + count > MAX_RECORD + 1) {
+            sendException(req, EX_ILLEGAL_ADDRESS, reply);
+            return;
+        }
+
+        // Veri halkada iki parçaya bölünmüş olabilir; küçük parçalar halinde aktar
+        uint32_t offset = (uint32_t)record * 2;
+        uint16_t data = i + 7;
+        for (uint16_t left = count * 2; left > 0;) {
+            uint8_t chunk[32];
+            uint8_t n = left > sizeof(chunk) ? sizeof(chunk) : left;
+            for (uint8_t k = 0; k < n; k++) {
+                chunk[k] = req[data + k];
+            }
+            uint8_t err = fileStore->writeRecords(file, offset, chunk, n);
+            if (err) {
+                sendException(req, err, reply);
+                return;
+            }
+            offset += n;
+            data += n;
+            left -= n;
+        }
+        i += 7 + count * 2;
+    }
+    if (!reply) {
+        return;
+    }
+
+    // Yanıt isteğin aynısıdır (CRC hariç)
+    for (uint16_t i = 0; i < end; i++) {
+        tx[i] = req[i];
+    }
+    sendResponse(end);
+}
+
+void RtuSlave::diagnostics(const FrameView &req, bool reply) {
+    if (req.length() != 8) {
+        sendException(req, EX_ILLEGAL_VALUE, reply);
+        return;
+    }
+    uint16_t sub = req.u16(2);
+    uint16_t data = req.u16(4);
+    switch (sub) {
+        case DIAG_RETURN_QUERY:
+            break;
+        case DIAG_RESTART:
+            // Dinleme modundayken yanıt verilmez, sadece moddan çıkılır
+            if (listenOnly) {
+                reply = false;
+            }
+            if (data != 0x0000 && data != 0xFF00) {
+                sendException(req, EX_ILLEGAL_VALUE, reply);
+                return;
+            }
+            listenOnly = false;
+            diag.clear();
+            if (data == 0xFF00) {
+                diag.clearLog();
+            }
+            diag.logEvent(EVENT_RESTART);
+            break;
+        case DIAG_REGISTER:
+            data = 0;
+            break;
+        case DIAG_LISTEN_ONLY:
+            // Yanıt verilmez
+            listenOnly = true;
+            diag.logEvent(EVENT_ENTER_LISTEN_ONLY);
+            return;
+        case DIAG_CLEAR_COUNTERS:
+            diag.clear();
+            break;
+        case DIAG_BUS_MESSAGES:
+            data = diag.busMessages;
+            break;
+        case DIAG_BUS_CRC_ERRORS:
+            data = diag.crcErrors;
+            break;
+        case DIAG_BUS_EXCEPTIONS:
+            data = diag.exceptions;
+            break;
+        case DIAG_SLAVE_MESSAGES:
+            data = diag.slaveMessages;
+            break;
+        case DIAG_SLAVE_NO_RESPONSE:
+            data = diag.noResponses;
+            break;
+        case DIAG_SLAVE_NAK:
+            data = 0;
+            break;
+        case DIAG_SLAVE_BUSY:
+            data = diag.busyCount;
+            break;
+        case DIAG_BUS_OVERRUNS:
+            data = diag.overruns;
+            break;
+        case DIAG_CLEAR_OVERRUNS:
+            diag.overruns = 0;
+            break;
+        default:
+            sendException(req, EX_ILLEGAL_FUNCTION, reply);
+            return;
+    }
+    if (!reply) {
+        return;
+    }
+    tx[0] = curUnit;
+    tx[1] = FC_DIAGNOSTICS;
+    tx[2] = sub >> 8;
+    tx[3] = sub & 0xFF;
+    tx[4] = data >> 8;
+    tx[5] = data & 0xFF;
+    sendResponse(6);
+}
+
+void RtuSlave::commEventCounter(const FrameView &req, bool reply) {
+    if (req.length() != 4) {
+        sendException(req, EX_ILLEGAL_VALUE, reply);
+        return;
+    }
+    if (!reply) {
+        return;
+    }
+    tx[0] = curUnit;
+    tx[1] = FC_COMM_EVENT_COUNTER;
+    tx[2] = 0;  // durum: meşgul değil
+    tx[3] = 0;
+    tx[4] = diag.eventCount >> 8;
+    tx[5] = diag.eventCount & 0xFF;
+    sendResponse(6);
+}
+
+void RtuSlave::commEventLog(const FrameView &req, bool reply) {
+    if (req.length() != 4) {
+        sendException(req, EX_ILLEGAL_VALUE, reply);
+        return;
+    }
+    if (!reply) {
+        return;
+    }
+    uint8_t n = diag.logSize();
+    tx[0] = curUnit;
+    tx[1] = FC_COMM_EVENT_LOG;
+    tx[2] = 6 + n;
+    tx[3] = 0;  // durum: meşgul değil
+    tx[4] = 0;
+    tx[5] = diag.eventCount >> 8;
+    tx[6] = diag.eventCount & 0xFF;
+    tx[7] = diag.busMessages >> 8;
+    tx[8] = diag.busMessages & 0xFF;
+    for (uint8_t i = 0; i < n; i++) {
+        tx[9 + i] = diag.logAt(i);
+    }
+    sendResponse(9 + n);
+}
+
+void RtuSlave::sendException(const FrameView &req, uint8_t code, bool reply) {
+    if (!reply) {
+        return;
+    }
+    tx[0] = curUnit;
+    tx[1] = req[1] | 0x80;
+    tx[2] = code;
+    sendResponse(3);
+}
+
+uint16_t RtuSlave::sendResponse(uint16_t len) {
+    uint16_t crc = modbusCrc(tx, len);
+    tx[len++] = crc & 0xFF;
+    tx[len++] = crc >> 8;
+    transmit(tx, len);
+    return len;
+}
+
+void RtuSlave::transmit(const uint8_t *frame, uint16_t len) {
+    transport.send(frame, len);
+    if (recorder) {
+        recorder->record(TrafficSink::DIR_TX, taskUs, frame, len);
+    }
+
+    uint8_t fc = frame[1];
+    uint8_t flags = 0;
+    if (fc & 0x80) {
+        uint8_t code = frame[2];
+        diag.exceptions++;
+        if (code <= EX_ILLEGAL_VALUE) {
+            flags = EVENT_TX_READ_EXCEPTION;
+        } else if (code == EX_DEVICE_FAILURE) {
+            flags = EVENT_TX_ABORT_EXCEPTION;
+        } else {
+            flags = EVENT_TX_BUSY_EXCEPTION;
+            if (code == EX_SLAVE_BUSY) {
+                diag.busyCount++;
+            }
+        }
+    } else if (fc != FC_COMM_EVENT_COUNTER && fc != FC_COMM_EVENT_LOG) {
+        diag.eventCount++;
+    }
+    diag.logEvent(EVENT_SEND | flags);
+}
@@ -0,0 +1,237 @@
+/*
+ * Modbus RTU slave.
+ *
+ * Baytlar receive() ile RX halkasına yazılır; task() 3.5 karakterlik
+ * sessizlikten sonra çerçeveyi kapatır ve halkada yerinde işler. Yanıt
+ * tek bir TX tamponunda kurulur ve RtuTransport üzerinden gönderilir.
+ *
+ * Desteklenen fonksiyonlar: 03 / 04 (register oku), 06 / 16 (yaz),
+ * 20 / 21 (dosya kaydı oku/yaz, setFileStore() ile bağlanan depoya),
+ * 08 / 11 / 12 (tanılama sayaçları ve olay kaydı, bkz. ModbusDiagnostics.h).
+ * Register'lar çağıranın dizileridir; yazmalardan sonra WriteHandler
+ * banka ve değişen aralıkla çağrılır. Birim 0 yayın kabul edilir (yanıt
+ * yok, banka 0'a uygulanır).
+ *
+ * Tek cihaz birden fazla slave gibi görünebilir: addBank() ile eklenen her
+ * birim adresinin kendi register bankası vardır. Birim -> banka eşlemesi
+ * 256 baytlık tabloyla tek adımda bulunur. Banka 0 yapıcıdaki dizilerdir,
+ * adresi begin() ile verilir.
+ *
+ * Bekleyen çerçeveler önceliğe göre işlenir: içerik değiştiren yazmalar
+ * (06 / 16 / 21) okuma ve tanılama isteklerinden önce uygulanır ve
+ * yanıtlanır. Sınıf başına kuyrukta bekleme süresi queueStats() ile okunur.
+ * setResponseLimit() verildiyse kuyrukta bundan uzun bekleyen isteğin
+ * yanıtı gönderilmez (master zaman aşımına uğramıştır; geç yanıt sonraki
+ * isteğiyle karışır). İstek yine uygulanır.
+ *
+ * setRecorder() ile bağlanan TrafficSink hattaki tüm çerçeveleri ve
+ * gönderilen yanıtları zaman damgasıyla alır (bkz. TrafficRecorder.h).
+ *
+ * Okuma yanıtları ResponseCache'te tutulur. Uygulama register dizilerini
+ * kendisi değiştirdiğinde holdingChanged() / inputChanged() çağırmalıdır.
+ */
+
+#ifndef RTU_SLAVE_H
+#define RTU_SLAVE_H
+
+#include <stdint.h>
+
+#include "ContentStore.h"
+#include "FrameRing.h"
+#include "ModbusDiagnostics.h"
+#include "ResponseCache.h"
+#include "TrafficRecorder.h"
+
+// Yanıtı hatta yazan katman (RS485 yön kontrolü dahil)
+class RtuTransport {
+public:
+    virtual void send(const uint8_t *data, uint16_t len) = 0;
+};
+
+// Bir birim adresinin register dizileri
+struct RegisterBank {
+    uint16_t *holding;
+    uint16_t holdingCount;
+    uint16_t *input;
+    uint16_t inputCount;
+};
+
+class RtuSlave {
+public:
+    typedef void (*WriteHandler)(uint8_t bank, uint16_t start, uint16_t count);
+
+    static const uint16_t MAX_ADU = 256;
+    static const uint8_t MAX_PENDING = 4;
+    static const uint8_t MAX_BANKS = 4;
+    static const uint8_t NO_BANK = 0xFF;
+
+    // İstek sınıfları (küçük = önce işlenir)
+    enum RequestClass {
+        CLASS_WRITE = 0,
+        CLASS_READ = 1,
+        CLASS_COUNT = 2
+    };
+
+    // Çerçevenin kapanmasından işlenmesine kadar geçen süre
+    struct QueueStats {
+        uint32_t frames;
+        uint32_t lastDelayUs;
+        uint32_t maxDelayUs;
+        uint32_t late;  // yanıtı sınırı aştığı için gönderilmeyen
+    };
+
+    enum Function {
+        FC_READ_HOLDING = 0x03,
+        FC_READ_INPUT = 0x04,
+        FC_WRITE_SINGLE = 0x06,
+        FC_DIAGNOSTICS = 0x08,
+        FC_COMM_EVENT_COUNTER = 0x0B,
+        FC_COMM_EVENT_LOG = 0x0C,
+        FC_WRITE_MULTIPLE = 0x10,
+        FC_READ_FILE_RECORD = 0x14,
+        FC_WRITE_FILE_RECORD = 0x15
+    };
+
+    enum Exception {
+        EX_ILLEGAL_FUNCTION = 0x01,
+        EX_ILLEGAL_ADDRESS = 0x02,
+        EX_ILLEGAL_VALUE = 0x03,
+        EX_DEVICE_FAILURE = 0x04,
+        EX_SLAVE_BUSY = 0x06
+    };
+
+    // FC08 alt fonksiyonları
+    enum DiagnosticsSub {
+        DIAG_RETURN_QUERY = 0x00,
+        DIAG_RESTART = 0x01,
+        DIAG_REGISTER = 0x02,
+        DIAG_LISTEN_ONLY = 0x04,
+        DIAG_CLEAR_COUNTERS = 0x0A,
+        DIAG_BUS_MESSAGES = 0x0B,
+        DIAG_BUS_CRC_ERRORS = 0x0C,
+        DIAG_BUS_EXCEPTIONS = 0x0D,
+        DIAG_SLAVE_MESSAGES = 0x0E,
+        DIAG_SLAVE_NO_RESPONSE = 0x0F,
+        DIAG_SLAVE_NAK = 0x10,
+        DIAG_SLAVE_BUSY = 0x11,
+        DIAG_BUS_OVERRUNS = 0x12,
+        DIAG_CLEAR_OVERRUNS = 0x14
+    };
+
+    // Olay kaydı baytları
+    enum CommEvent {
+        EVENT_RESTART = 0x00,
+        EVENT_ENTER_LISTEN_ONLY = 0x04,
+        EVENT_SEND = 0x40,
+        EVENT_RECEIVE = 0x80,
+        EVENT_RX_COMM_ERROR = 0x02,
+        EVENT_RX_OVERRUN = 0x10,
+        EVENT_LISTEN_ONLY = 0x20,
+        EVENT_RX_BROADCAST = 0x40,
+        EVENT_TX_READ_EXCEPTION = 0x01,
+        EVENT_TX_ABORT_EXCEPTION = 0x02,
+        EVENT_TX_BUSY_EXCEPTION = 0x04
+    };
+
+    RtuSlave(RtuTransport &transport,
+             uint16_t *holding, uint16_t holdingCount,
+             uint16_t *input, uint16_t inputCount);
+
+    void begin(uint8_t unitId, uint32_t baud);
+
+    // Ek birim adresi ve bankası; banka indeksi ya da -1 (dolu / adres kullanımda)
+    int8_t addBank(uint8_t unitId, uint16_t *holding, uint16_t holdingCount,
+                   uint16_t *input, uint16_t inputCount);
+    void onWrite(WriteHandler fn) { writeHandler = fn; }
+    void setFileStore(FileRecordStore *store) { fileStore = store; }
+    void setRecorder(TrafficSink *sink) { recorder = sink; }
+
+    // Yanıt sınırı (us, çerçevenin bitişinden işlenmesine kadar); 0 = sınırsız
+    void setResponseLimit(uint32_t us) { responseLimitUs = us; }
+
+    // Bir bayt al (nowUs: baytın hatta geldiği an, mikrosaniye)
+    void receive(uint8_t b, uint32_t nowUs);
+
+    // Sessizlik dolduysa çerçeveyi kapat, bekleyen çerçeveleri işle
+    void task(uint32_t nowUs);
+
+    // Uygulama tarafı değişiklikleri (önbelleği geçersiz kılar)
+    void holdingChanged(uint16_t start, uint16_t count = 1, uint8_t bank = 0) {
+        cache.invalidate(bank, FC_READ_HOLDING, start, count);
+    }
+    void inputChanged(uint16_t start, uint16_t count = 1, uint8_t bank = 0) {
+        cache.invalidate(bank, FC_READ_INPUT, start, count);
+    }
+
+    const ResponseCache &responseCache() const { return cache; }
+    const ModbusDiagnostics &diagnostics() const { return diag; }
+    const QueueStats &queueStats(uint8_t cls) const { return queue[cls]; }
+    bool listenOnlyMode() const { return listenOnly; }
+
+    uint8_t unitId() const { return unit; }
+    uint8_t bankCount() const { return banks; }
+    uint8_t bankForUnit(uint8_t unitId) const { return bankOf[unitId]; }
+    uint32_t silenceUs() const { return t35Us; }
+    const FrameRing &rxRing() const { return ring; }
+
+private:
+    struct PendingFrame {
+        uint16_t start;
+        uint16_t len;
+        uint8_t cls;
+        uint32_t endUs;  // son baytın zamanı
+    };
+
+    RtuTransport &transport;
+    RegisterBank bank[MAX_BANKS];
+    uint8_t banks;
+    uint8_t bankOf[256];
+    WriteHandler writeHandler;
+    FileRecordStore *fileStore;
+    TrafficSink *recorder;
+
+    uint8_t unit;
+    uint32_t t35Us;
+    bool listenOnly;
+    ModbusDiagnostics diag;
+
+    // İşlenen çerçevenin hedefi (yanıtın birim baytı ve bankası)
+    uint8_t curUnit;
+    uint8_t curBank;
+
+    FrameRing ring;
+    uint16_t frameStart;
+    uint16_t frameLen;
+    bool frameOpen;
+    bool frameOverflow;
+    uint32_t lastByteUs;
+    uint32_t taskUs;  // işlenen çerçevelerin yanıt zamanı
+    uint32_t responseLimitUs;
+
+    PendingFrame pending[MAX_PENDING];
+    uint8_t pendingHead;
+    uint8_t pendingCount;
+    QueueStats queue[CLASS_COUNT];
+
+    uint8_t tx[MAX_ADU];
+    ResponseCache cache;
+
+    void closeFrame();
+    static uint8_t classify(uint8_t fc);
+    void process(const FrameView &req, bool late);
+    void readRegisters(const FrameView &req, const uint16_t *regs, uint16_t count, bool reply);
+    void writeSingle(const FrameView &req, bool reply);
+    void writeMultiple(const FrameView &req, bool reply);
+    void readFileRecord(const FrameView &req, bool reply);
+    void writeFileRecord(const FrameView &req, bool reply);
+    void diagnostics(const FrameView &req, bool reply);
+    void commEventCounter(const FrameView &req, bool reply);
+    void commEventLog(const FrameView &req, bool reply);
+    void sendException(const FrameView &req, uint8_t code, bool reply);
+    uint16_t sendResponse(uint16_t len);
+
+    // Hatta gönder ve sayaçları/olay kaydını güncelle
+    void transmit(const uint8_t *frame, uint16_t len);
+};
+
+#endif
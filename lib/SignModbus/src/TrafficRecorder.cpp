@@ -0,0 +1,57 @@
+#include "TrafficRecorder.h"
+
+void TrafficRecorder::clear() {
+    head = 0;
+    tail = 0;
+    used = 0;
+    recordCount = 0;
+    droppedCount = 0;
+}
+
+void TrafficRecorder::put(uint8_t b) {
+    buf[head] = b;
+    head = (head + 1) % CAPACITY;
+    used++;
+}
+
+void TrafficRecorder::dropOldest() {
+    uint16_t len = at(5) | ((uint16_t)at(6) << 8);
+    uint16_t n = TRAFFIC_HEADER_BYTES + len;
+    tail = (tail + n) % CAPACITY;
+    used -= n;
+    recordCount--;
+    droppedCount++;
+}
+
+void TrafficRecorder::record(uint8_t dir, uint32_t stampUs, const uint8_t *data, uint16_t len) {
+    uint16_t n = TRAFFIC_HEADER_BYTES + len;
+    if (n > CAPACITY) {
+        droppedCount++;
+        return;
+    }
+    while (CAPACITY - used < n) {
+        dropOldest();
+    }
+    put(stampUs & 0xFF);
+    put((stampUs >> 8) & 0xFF);
+    put((stampUs >> 16) & 0xFF);
+    put(stampUs >> 24);
+    put(dir);
+    put(len & 0xFF);
+    put(len >> 8);
+    for (uint16_t i = 0; i < len; i++) {
+        put(data[i]);
+    }
+    recordCount++;
+}
+
+bool TrafficRecorder::read(uint32_t offset, uint8_t *dst, uint32_t len) const {
+    if (offset + len > size()) {
+        return false;
+    }
+    for (uint32_t i = 0; i < len; i++, offset++) {
+        dst[i] = offset < sizeof(TRAFFIC_MAGIC) ? TRAFFIC_MAGIC[offset]
+                                                : at(offset - sizeof(TRAFFIC_MAGIC));
+    }
+    return true;
+}
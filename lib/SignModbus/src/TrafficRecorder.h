@@ -0,0 +1,66 @@
+/*
+ * Modbus trafik kaydı.
+ *
+ * RtuSlave hatta gördüğü her çerçeveyi (başka slave'lere gidenler ve CRC'si
+ * bozuk olanlar dahil) ve gönderdiği her yanıtı TrafficSink'e verir.
+ * TrafficRecorder bunları RAM halkasında tutar; halka dolunca en eski
+ * kayıtlar silinir. Host araçları aynı biçimi dosyaya yazar.
+ *
+ * Biçim (dosya ve read() çıktısı):
+ *   "MBR1" başlık, ardından kayıtlar:
+ *   [u32 zaman us (LE)][u8 yön (0 = RX, 1 = TX)][u16 uzunluk (LE)][veri]
+ * RX zamanı çerçevenin son baytının geliş anı, TX zamanı gönderimin
+ * başladığı andır.
+ */
+
+#ifndef TRAFFIC_RECORDER_H
+#define TRAFFIC_RECORDER_H
+
+#include <stdint.h>
+
+class TrafficSink {
+public:
+    enum Direction {
+        DIR_RX = 0,
+        DIR_TX = 1
+    };
+
+    virtual void record(uint8_t dir, uint32_t stampUs, const uint8_t *data, uint16_t len) = 0;
+};
+
+static const uint8_t TRAFFIC_MAGIC[4] = { 'M', 'B', 'R', '1' };
+static const uint8_t TRAFFIC_HEADER_BYTES = 7;
+
+class TrafficRecorder : public TrafficSink {
+public:
+    static const uint16_t CAPACITY = 4096;
+
+    TrafficRecorder() { clear(); }
+
+    void record(uint8_t dir, uint32_t stampUs, const uint8_t *data, uint16_t len) override;
+
+    void clear();
+
+    // Başlık dahil doğrusal boyut (bayt)
+    uint32_t size() const { return sizeof(TRAFFIC_MAGIC) + used; }
+
+    // Doğrusal kayıttan oku (en eski kayıttan başlayarak)
+    bool read(uint32_t offset, uint8_t *dst, uint32_t len) const;
+
+    uint32_t records() const { return recordCount; }
+    uint32_t dropped() const { return droppedCount; }
+
+private:
+    uint8_t buf[CAPACITY];
+    uint16_t head;  // yazma
+    uint16_t tail;  // en eski kayıt
+    uint16_t used;
+    uint32_t recordCount;
+    uint32_t droppedCount;
+
+    void put(uint8_t b);
+    uint8_t at(uint16_t offset) const { return buf[(tail + offset) % CAPACITY]; }
+    void dropOldest();
+};
+
+#endif
@@ -0,0 +1,257 @@
+/*
+ * Hat çözümleyici raporu: hat zamanı nereye gidiyor.
+ *
+ * Hattaki boştaki bir tabela (master'ın hiç sormadığı bir birim) BusAnalyzer
+ * ile tüm trafiği dinler; cihazda aynı sonuçlar HR154 = 1 ile input
+ * register'lardan okunur. Trafik iki kaynaktan gelebilir:
+ *   simülasyon  master N tabelayı sırayla yoklar (FC03 okuma / FC06 fiyat
+ *               yazma), zaman aşımında aynı isteği --retries kez tekrarlar.
+ *               --slow ile bir tabelanın döngüsü yavaşlatılır, --noise ile
+ *               isteklerin bir kısmı bozulur (CRC hatası, tekrar).
+ *   --input     TrafficRecorder kaydı (cihazdan ya da replay --record)
+ *
+ * Her --report-s saniyede pencere satırı (doluluk, çerçeve/s, en uzun
+ * boşluk), sonunda slave başına istek, yanıt süresi, zaman aşımı ve tekrar
+ * oranı yazdırılır.
+ *
+ * Kullanım:
+ *   program [--signs N] [--seconds S] [--poll-ms P] [--slow I] [--slow-poll-ms P]
+ *           [--timeout-ms T] [--retries R] [--noise Y] [--seed S] [--report-s R]
+ *   program --input kayıt [--report-s R] [--timeout-ms T]
+ *
+ * --timeout-ms master'ın zaman aşımıdır; çözümleyicinin yanıt sınırı olarak
+ * da kullanılır (kayıtta varsayılan 1000 ms).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "BusAnalyzer.h"
+#include "ModbusFrames.h"
+#include "SignRegisters.h"
+#include "SimBus.h"
+#include "SimMaster.h"
+#include "SimSign.h"
+#include "TrafficFile.h"
+
+struct Options {
+    const char *input = nullptr;
+    int signs = 4;
+    double seconds = 60;
+    uint32_t pollUs = 10000;
+    int slow = -1;
+    uint32_t slowPollUs = 80000;
+    uint32_t timeoutUs = 0;  // 0 = simülasyonda 50 ms, kayıtta 1000 ms
+    int retries = 2;
+    double noise = 0;
+    unsigned seed = 1;
+    uint32_t reportUs = 10000000;
+};
+
+static const uint64_t STEP_US = 50;
+static const uint8_t SPARE_UNIT = 200;
+
+static uint8_t unitOf(int sign) {
+    return MODBUS_SLAVE_ID + sign * (ZONE_COUNT + 1);
+}
+
+static void printHeader() {
+    printf("%8s %7s %9s %10s\n", "zaman s", "hat %", "cerceve/s", "bosluk ms");
+}
+
+static void printWindow(const BusAnalyzer &a, double atSeconds) {
+    double span = a.windowUs() / 1e6;
+    printf("%8.0f %7.1f %9.1f %10.1f\n", atSeconds, a.utilizationPermille() / 10.0,
+           span > 0 ? a.windowFrames() / span : 0, a.windowMaxGapUs() / 1000.0);
+}
+
+static void printSlaves(const BusAnalyzer &a) {
+    const BusAnalyzer::BusStats &bus = a.bus();
+    printf("\n%u cerceve, %u CRC hatasi, %u yayin, %u izlenmeyen; bosluk ort %.1f maks %.1f ms\n\n",
+           bus.frames, bus.crcErrors, bus.broadcasts, bus.untracked, bus.averageGapUs() / 1000.0,
+           bus.maxGapUs / 1000.0);
+    printf("%5s %7s %7s %7s %7s %7s %7s %8s %8s %8s\n", "birim", "istek", "yanit", "z.asimi",
+           "tekrar", "tekrar%", "gec", "son ms", "ort ms", "maks ms");
+    for (uint8_t i = 0; i < a.slaveCount(); i++) {
+        const BusAnalyzer::SlaveStats &s = a.slaveAt(i);
+        printf("%5u %7u %7u %7u %7u %7.1f %7u %8.1f %8.1f %8.1f\n", s.unit, s.requests, s.responses,
+               s.timeouts, s.retries, s.requests ? 100.0 * s.retries / s.requests : 0, s.late,
+               s.lastResponseUs / 1000.0, s.averageResponseUs() / 1000.0, s.maxResponseUs / 1000.0);
+    }
+}
+
+static int analyzeFile(const Options &opt) {
+    std::vector<TrafficRecord> records;
+    if (!loadTraffic(opt.input, records)) {
+        fprintf(stderr, "%s okunamadi ya da bozuk (%zu kayit okundu)\n", opt.input, records.size());
+        if (records.empty()) {
+            return 2;
+        }
+    }
+    BusAnalyzer analyzer(MODBUS_BAUD);
+    analyzer.setResponseLimit(opt.timeoutUs ? opt.timeoutUs : BusAnalyzer::DEFAULT_RESPONSE_LIMIT_US);
+    printHeader();
+    uint32_t first = records.front().stampUs;
+    uint64_t elapsed = 0;
+    uint64_t nextReport = opt.reportUs;
+    uint32_t prev = first;
+    for (const TrafficRecord &r : records) {
+        elapsed += (uint32_t)(r.stampUs - prev);
+        prev = r.stampUs;
+        while (elapsed >= nextReport) {
+            analyzer.tick(first + (uint32_t)nextReport);
+            printWindow(analyzer, nextReport / 1e6);
+            nextReport += opt.reportUs;
+        }
+        analyzer.record(r.dir, r.stampUs, r.data.data(), r.data.size());
+    }
+    printWindow(analyzer, elapsed / 1e6);
+    printSlaves(analyzer);
+    return 0;
+}
+
+static int analyzeSimulation(Options opt) {
+    if (!opt.timeoutUs) {
+        opt.timeoutUs = 50000;
+    }
+    SimBus bus(MODBUS_BAUD);
+    SimMaster master(bus, MODBUS_BAUD);
+    std::mt19937 rng(opt.seed);
+    std::uniform_real_distribution<double> chance(0, 1);
+
+    std::vector<std::unique_ptr<SimSign>> signs;
+    for (int i = 0; i < opt.signs; i++) {
+        signs.emplace_back(new SimSign(bus, unitOf(i), i == opt.slow ? opt.slowPollUs : opt.pollUs));
+        signs.back()->setPhase(std::uniform_int_distribution<uint32_t>(0, opt.pollUs)(rng));
+    }
+    SimSign spare(bus, SPARE_UNIT, opt.pollUs);
+    BusAnalyzer analyzer(MODBUS_BAUD);
+    analyzer.setResponseLimit(opt.timeoutUs);
+    spare.setRecorder(&analyzer);
+
+    printf("%d baud, %d tabela, dongu %u ms%s, zaman asimi %u ms, %d tekrar, gurultu %.1f%%\n\n",
+           MODBUS_BAUD, opt.signs, opt.pollUs / 1000, opt.slow >= 0 ? " (biri yavas)" : "",
+           opt.timeoutUs / 1000, opt.retries, opt.noise * 100);
+    printHeader();
+
+    int target = 0;
+    int attempt = 0;
+    uint32_t cycle = 0;
+    bool waiting = false;
+    uint64_t deadlineUs = 0;
+    uint64_t readyUs = 0;
+    uint64_t nextReport = opt.reportUs;
+    Frame request;
+    const uint64_t limitUs = (uint64_t)(opt.seconds * 1e6);
+
+    for (uint64_t now = 0; now < limitUs; now += STEP_US) {
+        bus.deliverUntil(now);
+        for (std::unique_ptr<SimSign> &s : signs) {
+            s->runUntil(now);
+        }
+        spare.runUntil(now);
+
+        bool advance = false;
+        if (waiting) {
+            Frame reply;
+            uint64_t endUs;
+            while (master.takeFrame(now, reply, endUs)) {
+                if (replyMatches(request, reply)) {
+                    waiting = false;
+                    advance = true;
+                    readyUs = endUs + master.silenceUs();
+                    break;
+                }
+            }
+            if (waiting && now >= deadlineUs) {
+                waiting = false;
+                readyUs = now;
+                advance = ++attempt > opt.retries;
+            }
+        }
+        if (advance) {
+            attempt = 0;
+            if (++target == opt.signs) {
+                target = 0;
+                cycle++;
+            }
+        }
+
+        if (!waiting && now >= readyUs) {
+            // Yeni istek ya da aynısının tekrarı
+            if (attempt == 0) {
+                request = cycle % 2 ? readRequest(unitOf(target), 0x03, 0, 4)
+                                    : writeSingleRequest(unitOf(target), 2, 1000 + cycle % 500);
+            }
+            Frame wire = request;
+            if (chance(rng) < opt.noise) {
+                wire[std::uniform_int_distribution<size_t>(0, wire.size() - 1)(rng)] ^= 0x10;
+            }
+            master.flush();
+            deadlineUs = master.send(now, wire) + opt.timeoutUs;
+            waiting = true;
+        }
+
+        if (now >= nextReport) {
+            analyzer.tick((uint32_t)now);
+            printWindow(analyzer, now / 1e6);
+            nextReport += opt.reportUs;
+        }
+    }
+    printSlaves(analyzer);
+    return 0;
+}
+
+static bool parseArgs(int argc, char **argv, Options &opt) {
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!value) {
+            return false;
+        }
+        if (strcmp(arg, "--input") == 0) {
+            opt.input = value;
+        } else if (strcmp(arg, "--signs") == 0) {
+            opt.signs = atoi(value);
+        } else if (strcmp(arg, "--seconds") == 0) {
+            opt.seconds = atof(value);
+        } else if (strcmp(arg, "--poll-ms") == 0) {
+            opt.pollUs = atoi(value) * 1000;
+        } else if (strcmp(arg, "--slow") == 0) {
+            opt.slow = atoi(value);
+        } else if (strcmp(arg, "--slow-poll-ms") == 0) {
+            opt.slowPollUs = atoi(value) * 1000;
+        } else if (strcmp(arg, "--timeout-ms") == 0) {
+            opt.timeoutUs = atoi(value) * 1000;
+        } else if (strcmp(arg, "--retries") == 0) {
+            opt.retries = atoi(value);
+        } else if (strcmp(arg, "--noise") == 0) {
+            opt.noise = atof(value) / 100;
+        } else if (strcmp(arg, "--seed") == 0) {
+            opt.seed = strtoul(value, nullptr, 10);
+        } else if (strcmp(arg, "--report-s") == 0) {
+            opt.reportUs = atof(value) * 1e6;
+        } else {
+            return false;
+        }
+        i++;
+    }
+    return opt.signs > 0 && unitOf(opt.signs - 1) + ZONE_COUNT < SPARE_UNIT && opt.pollUs > 0 &&
+           opt.reportUs > 0 && opt.retries >= 0;
+}
+
+int main(int argc, char **argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        fprintf(stderr, "kullanim: %s [--signs N] [--seconds S] [--poll-ms P] [--slow I] [--slow-poll-ms P]\n"
+                        "          [--timeout-ms T] [--retries R] [--noise Y] [--seed S] [--report-s R]\n"
+                        "       %s --input kayit [--report-s R] [--timeout-ms T]\n", argv[0], argv[0]);
+        return 2;
+    }
+    return opt.input ? analyzeFile(opt) : analyzeSimulation(opt);
+}
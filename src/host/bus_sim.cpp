@@ -0,0 +1,347 @@
+/*
+ * Çok tabelalı hat simülasyonu: bir master kaç tabelayı güncelleyebilir.
+ *
+ * Tek bir sanal RS485 hattına N tabela (RenderSign: src/main.cpp'nin Modbus
+ * yolu ve çizimi) ve bir master bağlanır. Master tabelaları sırayla
+ * günceller: her tabelaya tek FC16 ile mod, hız, fiyat ve zaman yazar,
+ * yanıtı (ya da zaman aşımını) bekler, sonra sıradakine geçer. Her N için
+ * aynı senaryo baştan koşulur.
+ *
+ * Tabelalar dilimler halinde host iş parçacıklarına dağıtılır: her dilimde
+ * önce hattaki baytlar iletilir, sonra tabelalar paralel döner, gönderimleri
+ * dilim sonunda sırayla hatta konur (bkz. SimBus "bekletmeli" mod). Sonuç
+ * --threads değerinden bağımsızdır. Master dilim sınırlarında karar verir
+ * (dilim 500 us: yanıtı fark etme en fazla yarım ms gecikir).
+ *
+ * Raporlananlar (her N için):
+ *   günc/s      saniyedeki başarılı güncelleme (tüm tabelalar)
+ *   gecikme     isteğin başlamasından tabelanın yeni değeri çizmesine kadar
+ *   periyot     aynı tabelanın iki güncellemesi arası (tazelik)
+ *   hat %       hattın dolu olduğu sürenin oranı
+ *   çakışma     aynı anda sürülen bayt sayısı
+ *   zaman aş.   yanıt gelmeyen istekler
+ *   host        gerçek süre ve gerçek zamana oranı
+ *
+ * Kullanım:
+ *   program [--signs 1,2,4,...] [--threads T] [--seconds S] [--poll-ms P]
+ *           [--timeout-ms T] [--gap-ms G] [--seed S] [--csv dosya] [--label ad]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "ModbusFrames.h"
+#include "RenderSign.h"
+#include "SignRegisters.h"
+#include "SimBus.h"
+#include "SimMaster.h"
+
+struct Options {
+    std::vector<int> counts = { 1, 2, 4, 8, 16, 32, 63 };
+    unsigned threads = 0;  // 0 = donanım iş parçacığı sayısı
+    double seconds = 20;
+    uint32_t pollUs = 10000;
+    uint32_t timeoutUs = 100000;
+    uint32_t gapUs = 0;
+    unsigned seed = 1;
+    const char *csv = nullptr;
+    const char *label = "local";
+};
+
+struct RunResult {
+    uint32_t updates;
+    uint32_t timeouts;
+    uint32_t collisions;
+    double utilization;
+    std::vector<double> latencyMs;
+    std::vector<double> periodMs;
+    double wallMs;
+};
+
+static const uint32_t SLICE_US = 500;
+
+// Her tabelanın birim numarası; bölge bankaları araya girer
+static uint8_t unitOf(int sign) {
+    return MODBUS_SLAVE_ID + sign * (ZONE_COUNT + 1);
+}
+
+// Tabelaları her dilimde iş parçacıklarına bölüştürür (tabela i -> i % T)
+class SlicePool {
+public:
+    SlicePool(std::vector<std::unique_ptr<RenderSign>> &signs, unsigned count)
+        : signs(signs), stride(count), generation(0), untilUs(0), running(0), stopping(false) {
+        for (unsigned i = 1; i < count; i++) {
+            workers.emplace_back(&SlicePool::worker, this, i);
+        }
+    }
+
+    ~SlicePool() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        start.notify_all();
+        for (std::thread &t : workers) {
+            t.join();
+        }
+    }
+
+    // Tüm tabelaları 'nowUs'a kadar çalıştır; çağıran da 0. payı üstlenir
+    void run(uint64_t nowUs) {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            untilUs = nowUs;
+            running = workers.size();
+            generation++;
+        }
+        start.notify_all();
+        runShare(0, nowUs);
+
+        std::unique_lock<std::mutex> guard(lock);
+        done.wait(guard, [this] { return running == 0; });
+    }
+
+private:
+    std::vector<std::unique_ptr<RenderSign>> &signs;
+    std::vector<std::thread> workers;
+    unsigned stride;
+
+    std::mutex lock;
+    std::condition_variable start;
+    std::condition_variable done;
+    uint64_t generation;
+    uint64_t untilUs;
+    size_t running;
+    bool stopping;
+
+    void runShare(unsigned index, uint64_t nowUs) {
+        for (size_t i = index; i < signs.size(); i += stride) {
+            signs[i]->runUntil(nowUs);
+        }
+    }
+
+    void worker(unsigned index) {
+        uint64_t seen = 0;
+        for (;;) {
+            uint64_t nowUs;
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                start.wait(guard, [&] { return stopping || generation != seen; });
+                if (stopping) {
+                    return;
+                }
+                seen = generation;
+                nowUs = untilUs;
+            }
+            runShare(index, nowUs);
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                running--;
+            }
+            done.notify_one();
+        }
+    }
+};
+
+static RunResult runBus(int count, const Options &opt) {
+    SimBus bus(MODBUS_BAUD);
+    SimMaster master(bus, MODBUS_BAUD);
+    std::mt19937 rng(opt.seed);
+
+    // Tabelaların döngüleri birbirinden bağımsız fazda
+    std::vector<std::unique_ptr<RenderSign>> signs;
+    for (int i = 0; i < count; i++) {
+        signs.emplace_back(new RenderSign(bus, unitOf(i), opt.pollUs));
+        signs.back()->setPhase(std::uniform_int_distribution<uint32_t>(0, opt.pollUs)(rng));
+    }
+    unsigned threads = std::min<unsigned>(opt.threads, count);
+    SlicePool pool(signs, threads);
+    bus.setStaged(true);
+
+    RunResult result = { 0, 0, 0, 0, {}, {}, 0 };
+    std::vector<uint64_t> lastDoneUs(count, 0);
+    const uint64_t limitUs = (uint64_t)(opt.seconds * 1e6);
+    const uint32_t sliceUs = std::min<uint32_t>(SLICE_US, bus.byteUs() - 1);
+
+    int target = 0;
+    bool waiting = false;
+    uint64_t readyUs = 0;
+    uint64_t startUs = 0;
+    uint64_t deadlineUs = 0;
+    Frame request;
+    uint16_t price = 1000;
+
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    for (uint64_t now = 0; now < limitUs; now += sliceUs) {
+        bus.deliverUntil(now);
+        pool.run(now);
+
+        if (waiting) {
+            Frame reply;
+            uint64_t endUs;
+            while (master.takeFrame(now, reply, endUs)) {
+                if (!replyMatches(request, reply)) {
+                    continue;
+                }
+                waiting = false;
+                result.updates++;
+                const std::vector<RenderSign::Sample> &drawn = signs[target]->samples();
+                if (!drawn.empty() && drawn.back().atUs >= startUs) {
+                    result.latencyMs.push_back((drawn.back().atUs - startUs) / 1000.0);
+                }
+                if (lastDoneUs[target]) {
+                    result.periodMs.push_back((endUs - lastDoneUs[target]) / 1000.0);
+                }
+                lastDoneUs[target] = endUs;
+                readyUs = endUs + master.silenceUs() + opt.gapUs;
+                target = (target + 1) % count;
+                break;
+            }
+            if (waiting && now >= deadlineUs) {
+                waiting = false;
+                result.timeouts++;
+                readyUs = now + opt.gapUs;
+                target = (target + 1) % count;
+            }
+        }
+
+        if (!waiting && now >= readyUs) {
+            uint16_t values[4] = { 2, 100, price++, (uint16_t)(now / 1000000) };
+            master.flush();
+            request = writeMultipleRequest(unitOf(target), 0, values, 4);
+            startUs = now;
+            deadlineUs = master.send(now, request) + opt.timeoutUs;
+            waiting = true;
+        }
+        bus.commitStaged();
+    }
+    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+
+    result.wallMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    result.collisions = bus.collisions();
+    result.utilization = 100.0 * bus.busyUs() / limitUs;
+    return result;
+}
+
+static double percentile(std::vector<double> v, double p) {
+    if (v.empty()) {
+        return 0;
+    }
+    std::sort(v.begin(), v.end());
+    size_t i = (size_t)(p * (v.size() - 1) + 0.5);
+    return v[i];
+}
+
+static double mean(const std::vector<double> &v) {
+    double sum = 0;
+    for (double x : v) {
+        sum += x;
+    }
+    return v.empty() ? 0 : sum / v.size();
+}
+
+static bool parseCounts(const char *value, std::vector<int> &counts) {
+    counts.clear();
+    for (const char *p = value; *p;) {
+        char *end;
+        long n = strtol(p, &end, 10);
+        if (end == p || n < 1 || n >= SimBus::MAX_NODES || unitOf(n - 1) + ZONE_COUNT > 247) {
+            return false;
+        }
+        counts.push_back(n);
+        p = *end == ',' ? end + 1 : end;
+    }
+    return !counts.empty();
+}
+
+static bool parseArgs(int argc, char **argv, Options &opt) {
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!value) {
+            return false;
+        }
+        if (strcmp(arg, "--signs") == 0) {
+            if (!parseCounts(value, opt.counts)) {
+                return false;
+            }
+        } else if (strcmp(arg, "--threads") == 0) {
+            opt.threads = atoi(value);
+        } else if (strcmp(arg, "--seconds") == 0) {
+            opt.seconds = atof(value);
+        } else if (strcmp(arg, "--poll-ms") == 0) {
+            opt.pollUs = atoi(value) * 1000;
+        } else if (strcmp(arg, "--timeout-ms") == 0) {
+            opt.timeoutUs = atoi(value) * 1000;
+        } else if (strcmp(arg, "--gap-ms") == 0) {
+            opt.gapUs = atoi(value) * 1000;
+        } else if (strcmp(arg, "--seed") == 0) {
+            opt.seed = strtoul(value, nullptr, 10);
+        } else if (strcmp(arg, "--csv") == 0) {
+            opt.csv = value;
+        } else if (strcmp(arg, "--label") == 0) {
+            opt.label = value;
+        } else {
+            return false;
+        }
+        i++;
+    }
+    if (opt.threads == 0) {
+        opt.threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    return opt.seconds > 0 && opt.pollUs > 0;
+}
+
+int main(int argc, char **argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        fprintf(stderr, "kullanim: %s [--signs 1,2,4,...] [--threads T] [--seconds S] [--poll-ms P]\n"
+                        "          [--timeout-ms T] [--gap-ms G] [--seed S] [--csv dosya] [--label ad]\n",
+                argv[0]);
+        return 2;
+    }
+
+    FILE *csv = opt.csv ? fopen(opt.csv, "a") : nullptr;
+    if (opt.csv && !csv) {
+        fprintf(stderr, "%s acilamadi\n", opt.csv);
+        return 2;
+    }
+
+    printf("%d baud, dongu %u ms, zaman asimi %u ms, %.0f s sanal, %u is parcacigi\n\n", MODBUS_BAUD,
+           opt.pollUs / 1000, opt.timeoutUs / 1000, opt.seconds, opt.threads);
+    printf("%5s %7s %8s   %15s   %23s %6s %6s %6s %9s\n", "", "", "", "gecikme (ms)",
+           "periyot (ms)", "", "", "zaman", "host");
+    printf("%5s %7s %8s %7s %7s %7s %7s %7s %6s %6s %6s %9s\n", "tabela", "gunc/s", "tabela/s",
+           "ort", "p95", "ort", "p95", "maks", "hat %", "cakis.", "as.", "x gercek");
+
+    for (int count : opt.counts) {
+        RunResult r = runBus(count, opt);
+        double rate = r.updates / opt.seconds;
+        double realtime = r.wallMs > 0 ? opt.seconds * 1000.0 / r.wallMs : 0;
+        printf("%5d %7.1f %8.2f %7.1f %7.1f %7.0f %7.0f %7.0f %6.1f %6u %6u %9.1f\n", count, rate,
+               rate / count, mean(r.latencyMs), percentile(r.latencyMs, 0.95), mean(r.periodMs),
+               percentile(r.periodMs, 0.95), percentile(r.periodMs, 1.0), r.utilization,
+               r.collisions, r.timeouts, realtime);
+        if (csv) {
+            fprintf(csv, "%s,%d,%u,%.2f,%.3f,%.3f,%.1f,%.1f,%.1f,%.2f,%u,%u\n", opt.label, count,
+                    opt.threads, rate, mean(r.latencyMs), percentile(r.latencyMs, 0.95),
+                    mean(r.periodMs), percentile(r.periodMs, 0.95), percentile(r.periodMs, 1.0),
+                    r.utilization, r.collisions, r.timeouts);
+        }
+    }
+
+    if (csv) {
+        fclose(csv);
+    }
+    return 0;
+}
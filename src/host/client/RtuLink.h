@@ -0,0 +1,43 @@
+/*
+ * Master tarafı seri bağlantı (host).
+ *
+ * SignClient sadece bu arayüzü kullanır; gerçek RS485 adaptörü ya da
+ * simülasyonun pty'si SerialLink ile açılır (8N1, ham mod).
+ */
+
+#ifndef RTU_LINK_H
+#define RTU_LINK_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+class RtuLink {
+public:
+    virtual ~RtuLink() {}
+
+    virtual bool send(const uint8_t *data, size_t len) = 0;
+
+    // En fazla 'len' bayt oku; 'timeoutUs' içinde bayt gelmezse 0
+    virtual size_t receive(uint8_t *dst, size_t len, uint32_t timeoutUs) = 0;
+
+    // Alıcıda bekleyen baytları at
+    virtual void discard() = 0;
+};
+
+class SerialLink : public RtuLink {
+public:
+    SerialLink() : fd(-1) {}
+    ~SerialLink() { close(); }
+
+    bool open(const char *path, uint32_t baud);
+    void close();
+
+    bool send(const uint8_t *data, size_t len) override;
+    size_t receive(uint8_t *dst, size_t len, uint32_t timeoutUs) override;
+    void discard() override;
+
+private:
+    int fd;
+};
+
+#endif
@@ -0,0 +1,86 @@
+#include "RtuLink.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+static speed_t baudConstant(uint32_t baud) {
+    switch (baud) {
+        case 1200: return B1200;
+        case 2400: return B2400;
+        case 4800: return B4800;
+        case 9600: return B9600;
+        case 19200: return B19200;
+        case 38400: return B38400;
+        case 57600: return B57600;
+        case 115200: return B115200;
+        default: return 0;
+    }
+}
+
+bool SerialLink::open(const char *path, uint32_t baud) {
+    close();
+    speed_t speed = baudConstant(baud);
+    if (speed == 0) {
+        return false;
+    }
+    fd = ::open(path, O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (fd < 0) {
+        return false;
+    }
+    termios tio;
+    if (tcgetattr(fd, &tio) != 0) {
+        close();
+        return false;
+    }
+    cfmakeraw(&tio);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cflag &= ~(CSTOPB | PARENB);
+    cfsetispeed(&tio, speed);
+    cfsetospeed(&tio, speed);
+    if (tcsetattr(fd, TCSANOW, &tio) != 0) {
+        close();
+        return false;
+    }
+    tcflush(fd, TCIOFLUSH);
+    return true;
+}
+
+void SerialLink::close() {
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+bool SerialLink::send(const uint8_t *data, size_t len) {
+    while (len > 0) {
+        ssize_t n = ::write(fd, data, len);
+        if (n < 0) {
+            pollfd p = { fd, POLLOUT, 0 };
+            if (poll(&p, 1, 100) <= 0) {
+                return false;
+            }
+            continue;
+        }
+        data += n;
+        len -= n;
+    }
+    return true;
+}
+
+size_t SerialLink::receive(uint8_t *dst, size_t len, uint32_t timeoutUs) {
+    pollfd p = { fd, POLLIN, 0 };
+    if (poll(&p, 1, (timeoutUs + 999) / 1000) <= 0) {
+        return 0;
+    }
+    ssize_t n = ::read(fd, dst, len);
+    return n > 0 ? n : 0;
+}
+
+void SerialLink::discard() {
+    uint8_t junk[64];
+    while (::read(fd, junk, sizeof(junk)) > 0) {
+    }
+}
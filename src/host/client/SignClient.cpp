@@ -0,0 +1,296 @@
+#include "SignClient.h"
+
+#include <string.h>
+#include <unistd.h>
+
+#include <chrono>
+
+// Metnin 'i'. register'ı (iki karakter, üst bayt önce; sonrası sıfır)
+static uint16_t textWord(const char *text, size_t len, uint8_t i) {
+    size_t k = 2 * (size_t)i;
+    uint8_t hi = k < len ? text[k] : 0;
+    uint8_t lo = k + 1 < len ? text[k + 1] : 0;
+    return (hi << 8) | lo;
+}
+
+SignClient::SignClient(RtuLink &link, uint32_t baud)
+    : link(link), t35Us(baud > 19200 ? 1750 : 38500000UL / baud), timeoutUs(100000), retries(1),
+      batching(true) {
+    memset(&counters, 0, sizeof(counters));
+}
+
+bool SignClient::addSign(uint8_t unit) {
+    // Çakışan bankalarda find() yanlış bankayı döndürürdü
+    if (unit == 0 || unit + ZONE_COUNT > 247) {
+        return false;
+    }
+    for (const Bank &other : banks) {
+        if (other.unit >= unit && other.unit <= unit + ZONE_COUNT) {
+            return false;
+        }
+    }
+
+    Bank b;
+    b.unit = unit;
+    b.main = true;
+    b.desired.assign(SignRegisters::HOLDING_COUNT, 0);
+    b.written.assign(SignRegisters::HOLDING_COUNT, 0);
+    b.flags.assign(SignRegisters::HOLDING_COUNT, 0);
+    banks.push_back(b);
+
+    for (uint8_t z = 0; z < ZONE_COUNT; z++) {
+        b.unit = unit + 1 + z;
+        b.main = false;
+        b.desired.assign(ZONE_REG_COUNT, 0);
+        b.written.assign(ZONE_REG_COUNT, 0);
+        b.flags.assign(ZONE_REG_COUNT, 0);
+        banks.push_back(b);
+    }
+    return true;
+}
+
+SignClient::Bank *SignClient::find(uint8_t unit, size_t *index) {
+    for (size_t i = 0; i < banks.size(); i++) {
+        if (banks[i].unit == unit) {
+            if (index) {
+                *index = i;
+            }
+            return &banks[i];
+        }
+    }
+    return nullptr;
+}
+
+bool SignClient::set(uint8_t unit, uint16_t addr, uint16_t value) {
+    Bank *b = find(unit);
+    if (!b || addr >= b->desired.size() || isCommand(*b, addr)) {
+        return false;
+    }
+    b->desired[addr] = value;
+    b->flags[addr] |= F_SET | F_PENDING;
+    return true;
+}
+
+bool SignClient::command(uint8_t unit, uint16_t addr, uint16_t value) {
+    size_t index;
+    Bank *b = find(unit, &index);
+    if (!b || addr >= b->desired.size()) {
+        return false;
+    }
+    commands.push_back(makeWrite(index, addr, 1, &value));
+    commands.back().command = true;
+    return true;
+}
+
+bool SignClient::setText(uint8_t unit, uint8_t slot, const char *text) {
+    if (slot >= TEXT_SLOTS) {
+        return false;
+    }
+    // Slot sabit uzunlukta yazılır: kısalan metnin sonu sıfırlanır
+    size_t len = strlen(text);
+    uint16_t base = REG_TEXT_BASE + slot * TEXT_SLOT_REGS;
+    for (uint8_t i = 0; i < TEXT_SLOT_REGS; i++) {
+        if (!set(unit, base + i, textWord(text, len, i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SignClient::setZone(uint8_t unit, uint8_t zone, uint16_t content, int16_t value, const char *text) {
+    uint8_t zu = unit + 1 + zone;
+    if (zone >= ZONE_COUNT || !set(zu, ZREG_CONTENT, content) || !set(zu, ZREG_VALUE, (uint16_t)value)) {
+        return false;
+    }
+    if (!text) {
+        return true;
+    }
+    size_t len = strlen(text);
+    for (uint8_t i = 0; i < ZONE_TEXT_REGS; i++) {
+        set(zu, ZREG_TEXT + i, textWord(text, len, i));
+    }
+    return true;
+}
+
+void SignClient::forget(uint8_t unit) {
+    for (Bank &b : banks) {
+        if (b.unit >= unit && b.unit <= unit + ZONE_COUNT) {
+            for (uint8_t &f : b.flags) {
+                f &= ~F_KNOWN;
+            }
+        }
+    }
+}
+
+bool SignClient::isCommand(const Bank &b, uint16_t addr) {
+    if (!b.main) {
+        return false;
+    }
+    const RegisterDef *def = SignRegisters::holdingDef(addr);
+    return def && (def->action == ACT_FILE_COMMAND || def->action == ACT_RECORDER ||
+                   def->action == ACT_FEED);
+}
+
+bool SignClient::dirty(const Bank &b, uint16_t addr) const {
+    uint8_t f = b.flags[addr];
+    if (!batching) {
+        return f & F_PENDING;
+    }
+    return (f & F_SET) && (!(f & F_KNOWN) || b.desired[addr] != b.written[addr]);
+}
+
+// Register yazılınca tabelada tetiklenen eylemler (bit maskesi), bankanın
+// register tablosundan
+uint32_t SignClient::effects(const Bank &b, uint16_t addr) {
+    const RegisterDef *def = b.main ? SignRegisters::holdingDef(addr) : ZoneRegisters::holdingDef(addr);
+    return def && def->action != ACT_NONE ? 1UL << def->action : 0;
+}
+
+// Boşluk kapatmak için yeniden yazılabilir mi: değeri biliniyor, komut değil
+// ve eylemi aynı yazmada zaten tetikleniyor ('triggered'). Aynı değeri
+// yeniden yazmak ACT_TIME'da geri sayımı, ACT_DISPLAY'de kayan yazıyı,
+// ACT_PROGRAM'da programı baştan başlatırdı.
+bool SignClient::bridgeable(const Bank &b, uint16_t addr, uint32_t triggered) const {
+    return (b.flags[addr] & (F_KNOWN | F_SET)) == (F_KNOWN | F_SET) && !isCommand(b, addr) &&
+           (effects(b, addr) & ~triggered) == 0;
+}
+
+SignClient::Write SignClient::makeWrite(size_t index, uint16_t start, uint16_t count,
+                                        const uint16_t *values) const {
+    uint8_t unit = banks[index].unit;
+    Write w = { index, start, count, false,
+                count == 1 ? writeSingleRequest(unit, start, values[0])
+                           : writeMultipleRequest(unit, start, values, count) };
+    return w;
+}
+
+void SignClient::plan(size_t index, std::vector<Write> &out) const {
+    const Bank &b = banks[index];
+    uint16_t n = b.desired.size();
+    uint16_t addr = 0;
+    while (addr < n) {
+        if (!dirty(b, addr)) {
+            addr++;
+            continue;
+        }
+        uint16_t start = addr;
+        uint16_t end = addr + 1;
+        if (batching) {
+            uint32_t triggered = effects(b, start);
+            uint16_t j = end;
+            while (j < n && j - start < MAX_WRITE_REGS) {
+                if (dirty(b, j)) {
+                    triggered |= effects(b, j);
+                    end = ++j;
+                    continue;
+                }
+                // Kısa ve kapatılabilir boşluğun ardından yine değişen register varsa
+                // birleştir; boşluk o register'ın eylemlerini de kullanabilir
+                uint16_t k = j;
+                while (k < n && k - j <= MAX_BRIDGE && !dirty(b, k)) {
+                    k++;
+                }
+                if (k >= n || k - j > MAX_BRIDGE || k - start >= MAX_WRITE_REGS) {
+                    break;
+                }
+                uint32_t allowed = triggered | effects(b, k);
+                uint16_t m = j;
+                while (m < k && bridgeable(b, m, allowed)) {
+                    m++;
+                }
+                if (m < k) {
+                    break;
+                }
+                j = k;
+            }
+        }
+        out.push_back(makeWrite(index, start, end - start, &b.desired[start]));
+        addr = end;
+    }
+}
+
+bool SignClient::readReply(Frame &reply) {
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point deadline = Clock::now() + std::chrono::microseconds(timeoutUs);
+    size_t expect = 8;  // FC06 / FC16 yanıtı
+    uint8_t buf[64];
+
+    reply.clear();
+    while (reply.size() < expect) {
+        Clock::time_point now = Clock::now();
+        if (now >= deadline) {
+            return false;
+        }
+        uint32_t left = std::chrono::duration_cast<std::chrono::microseconds>(deadline - now).count();
+        size_t n = link.receive(buf, expect - reply.size(), left);
+        reply.insert(reply.end(), buf, buf + n);
+        if (reply.size() >= 2 && (reply[1] & 0x80)) {
+            expect = 5;
+        }
+    }
+    counters.rxBytes += reply.size();
+    return true;
+}
+
+SignClient::Result SignClient::execute(const Write &w) {
+    for (uint8_t attempt = 0; attempt <= retries; attempt++) {
+        link.discard();
+        if (!link.send(w.request.data(), w.request.size())) {
+            return RESULT_FAILED;
+        }
+        counters.transactions++;
+        counters.txBytes += w.request.size();
+
+        Frame reply;
+        bool received = readReply(reply);
+        usleep(t35Us);
+        if (!received || !crcOk(reply)) {
+            counters.timeouts++;
+            continue;
+        }
+        if (reply[0] == w.request[0] && reply[1] == (w.request[1] | 0x80)) {
+            counters.exceptions++;
+            return RESULT_REJECTED;
+        }
+        if (replyMatches(w.request, reply)) {
+            return RESULT_DONE;
+        }
+        counters.timeouts++;
+    }
+    return RESULT_FAILED;
+}
+
+bool SignClient::flush() {
+    counters.flushes++;
+    std::vector<Write> writes;
+    for (size_t i = 0; i < banks.size(); i++) {
+        plan(i, writes);
+    }
+    writes.insert(writes.end(), commands.begin(), commands.end());
+    commands.clear();
+
+    bool ok = true;
+    for (const Write &w : writes) {
+        Bank &b = banks[w.bank];
+        Result r = execute(w);
+        if (r != RESULT_DONE) {
+            ok = false;
+        }
+        if (w.command || r == RESULT_FAILED) {
+            continue;
+        }
+        for (uint16_t a = w.start; a < w.start + w.count; a++) {
+            if (r == RESULT_REJECTED) {
+                // Tabela kabul etmiyor: istenen değer bırakılır
+                b.flags[a] &= ~(F_SET | F_PENDING);
+                continue;
+            }
+            b.written[a] = b.desired[a];
+            b.flags[a] = (b.flags[a] | F_KNOWN) & ~F_PENDING;
+        }
+        if (r == RESULT_DONE) {
+            counters.registers += w.count;
+        }
+    }
+    return ok;
+}
@@ -0,0 +1,137 @@
+/*
+ * Tabela için master istemcisi (host).
+ *
+ * Uygulama istenen durumu set*() ile verir, flush() sadece değişenleri
+ * yazar:
+ *   - Her register için son yazılan değer tutulur; aynı değer tekrar
+ *     yazılmaz.
+ *   - Bitişik değişen register'lar tek FC16'da birleşir. Aradaki en fazla
+ *     MAX_BRIDGE değişmemiş register, değeri biliniyorsa, komut register'ı
+ *     değilse ve yazılınca tetiklediği eylem (RegisterDef::action) aynı
+ *     yazmada zaten tetikleniyorsa yeniden yazılarak boşluk kapatılır
+ *     (ayrı bir işlemden ucuz).
+ *     Tek register FC06 ile yazılır.
+ *   - Tüm tabelaların (ve bölge bankalarının) yazmaları önceden planlanır ve
+ *     arka arkaya gönderilir. Yanıtın sonu beklenen uzunluktan bilinir;
+ *     sıradaki istek zaman aşımını değil sadece t3.5 sessizliğini bekler.
+ * RS485 yarı çift yönlü olduğundan aynı anda tek istek hattadır.
+ *
+ * Komut register'ları (dosya, kayıt, haber bandı) command() ile verilir;
+ * her seferinde yazılır, durum yazmalarından sonra gönderilir.
+ *
+ * setBatching(false) bugünkü entegrasyonu taklit eder: set() ile verilen
+ * her register ayrı bir FC06 ile, değişmemiş olsa da yazılır.
+ */
+
+#ifndef SIGN_CLIENT_H
+#define SIGN_CLIENT_H
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "ModbusFrames.h"
+#include "RtuLink.h"
+#include "SignRegisters.h"
+
+class SignClient {
+public:
+    static const uint8_t MAX_BRIDGE = 2;
+    static const uint16_t MAX_WRITE_REGS = 123;
+
+    struct Stats {
+        uint32_t flushes;
+        uint32_t transactions;
+        uint32_t registers;
+        uint32_t txBytes;
+        uint32_t rxBytes;
+        uint32_t timeouts;
+        uint32_t exceptions;
+    };
+
+    SignClient(RtuLink &link, uint32_t baud = MODBUS_BAUD);
+
+    // Ana banka ve bölge bankaları (unit + 1 + bölge); her tabela
+    // ZONE_COUNT + 1 adres kaplar. Aralık başka bir tabelanınkiyle
+    // çakışıyorsa veya 1-247 dışına taşıyorsa eklenmez, false döner.
+    bool addSign(uint8_t unit);
+
+    bool set(uint8_t unit, uint16_t addr, uint16_t value);
+    bool command(uint8_t unit, uint16_t addr, uint16_t value);
+
+    bool setMode(uint8_t unit, uint16_t mode) { return set(unit, 0, mode); }
+    bool setSpeed(uint8_t unit, uint16_t ms) { return set(unit, 1, ms); }
+    bool setPrice(uint8_t unit, int16_t price) { return set(unit, 2, (uint16_t)price); }
+    // 32 bitlik fiyat (HR208-209); setPrice ile aynı tabelada karıştırılmamalı,
+    // HR2 yazımı bu çifti tabelada değiştirir
+    bool setFixedPrice(uint8_t unit, int32_t price) {
+        return set(unit, REG_PRICE_VALUE, (uint32_t)price >> 16) &&
+               set(unit, REG_PRICE_VALUE + 1, (uint32_t)price & 0xFFFF);
+    }
+    bool setTime(uint8_t unit, int16_t seconds) { return set(unit, 3, (uint16_t)seconds); }
+    bool setText(uint8_t unit, uint8_t slot, const char *text);
+    bool setZone(uint8_t unit, uint8_t zone, uint16_t content, int16_t value, const char *text = nullptr);
+
+    // Değişenleri yaz; tüm işlemler başarılıysa true
+    bool flush();
+
+    // Son yazılan değerleri unut (tabela yeniden başladıysa)
+    void forget(uint8_t unit);
+
+    void setBatching(bool on) { batching = on; }
+    void setTimeout(uint32_t us) { timeoutUs = us; }
+    void setRetries(uint8_t n) { retries = n; }
+
+    const Stats &stats() const { return counters; }
+
+private:
+    enum Flags : uint8_t {
+        F_KNOWN = 0x01,    // 'written' tabeladaki değerdir
+        F_SET = 0x02,      // uygulama bir değer verdi
+        F_PENDING = 0x04   // son flush'tan beri set() çağrıldı
+    };
+
+    struct Bank {
+        uint8_t unit;
+        bool main;
+        std::vector<uint16_t> desired;
+        std::vector<uint16_t> written;
+        std::vector<uint8_t> flags;
+    };
+
+    struct Write {
+        size_t bank;
+        uint16_t start;
+        uint16_t count;
+        bool command;
+        Frame request;
+    };
+
+    enum Result {
+        RESULT_DONE,
+        RESULT_FAILED,   // yanıt yok / bozuk: sonraki flush tekrar dener
+        RESULT_REJECTED  // istisna yanıtı: tekrar denemek sonucu değiştirmez
+    };
+
+    RtuLink &link;
+    uint32_t t35Us;
+    uint32_t timeoutUs;
+    uint8_t retries;
+    bool batching;
+    std::vector<Bank> banks;
+    std::vector<Write> commands;
+    Stats counters;
+
+    Bank *find(uint8_t unit, size_t *index = nullptr);
+    bool dirty(const Bank &b, uint16_t addr) const;
+    bool bridgeable(const Bank &b, uint16_t addr, uint32_t triggered) const;
+    static bool isCommand(const Bank &b, uint16_t addr);
+    static uint32_t effects(const Bank &b, uint16_t addr);
+
+    void plan(size_t index, std::vector<Write> &out) const;
+    Write makeWrite(size_t index, uint16_t start, uint16_t count, const uint16_t *values) const;
+    Result execute(const Write &w);
+    bool readReply(Frame &reply);
+};
+
+#endif
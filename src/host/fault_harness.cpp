@@ -0,0 +1,371 @@
+/*
+ * Hat gürültüsü ve hata enjeksiyonu: tabelanın toparlanma süresi.
+ *
+ * Sanal RS485 hattında bir master, bir tabela (SimSign, src/main.cpp'nin
+ * Modbus yolu) ve bir hata üreticisi bulunur. Master durmadan istek gönderir
+ * (FC06 yaz / FC03 oku; yanıttan 5 ms sonra sıradaki, zaman aşımında hemen
+ * tekrar). Her denemede ısınmadan sonra tek bir hata enjekte edilir:
+ *   flip    isteğin rastgele bir bitini çevir
+ *   trunc   isteği yarıda kes
+ *   gap2    istek ortasında 2 karakterlik boşluk (çerçeve bölünmemeli)
+ *   gap5    istek ortasında 5 karakterlik boşluk (çerçeve bölünür)
+ *   noise   istekten hemen önce 1-3 bayt parazit (t3.5 içinde)
+ *   babble  başka bir slave 5-50 ms susmadan konuşur
+ *   lbabble başka bir slave 150-500 ms konuşur: zaman aşımını geçer,
+ *           sonraki istekler de bozulur
+ *   burst   150-500 ms boyunca 5-20 ms arayla 1-3 bayt parazit (gevşek
+ *           bağlantı); aradaki istek ve yanıtların bir kısmı bozulur
+ *
+ * Ölçülenler (deneme başına):
+ *   kayıp       hatalı istekten sonra gönderilip doğru yanıt alamayan istek
+ *   resync      hata bittikten sonraki ilk sağlam isteğin bitişinden tabelanın
+ *               geçerli bir çerçeveyi kabul etmesine kadar geçen süre (slave
+ *               tarafı; master zaman aşımı sadece çerçeve kaybolursa girer)
+ *   toparlanma  hatanın bitişinden ilk doğru yanıtın bitişine kadar (uçtan uca,
+ *               master zaman aşımı dahil)
+ *
+ * Kullanım:
+ *   program [--trials N] [--seed S] [--poll-ms P] [--timeout-ms T]
+ *           [--csv dosya] [--label ad] [--max-resync-ms M]
+ *
+ * --csv her hata türü için bir satır ekler (label, hata, deneme, kayıp ort /
+ * maks, resync ort / p95 / maks, toparlanma ort / p95 / maks ms); sürümler
+ * arası takip içindir. Toparlanmayan deneme varsa ya da --max-resync-ms
+ * verilip p95 resync sınırı aştıysa çıkış kodu 1 olur.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "ModbusFrames.h"
+#include "SignRegisters.h"
+#include "SimBus.h"
+#include "SimMaster.h"
+#include "SimSign.h"
+
+enum Fault {
+    FAULT_FLIP,
+    FAULT_TRUNC,
+    FAULT_GAP2,
+    FAULT_GAP5,
+    FAULT_NOISE,
+    FAULT_BABBLE,
+    FAULT_LONG_BABBLE,
+    FAULT_BURST,
+    FAULT_COUNT
+};
+
+static const char *const FAULT_NAMES[FAULT_COUNT] = {
+    "flip", "trunc", "gap2", "gap5", "noise", "babble", "lbabble", "burst"
+};
+
+struct Options {
+    int trials = 200;
+    unsigned seed = 1;
+    uint32_t pollUs = 10000;
+    uint32_t timeoutUs = 100000;
+    const char *csv = nullptr;
+    const char *label = "local";
+    double maxResyncMs = 0;
+};
+
+struct TrialResult {
+    uint32_t lost;
+    double resyncMs;
+    double recoveryMs;
+    bool recovered;
+};
+
+// Hatta sadece konuşan düğüm (parazit, gevezelik eden slave)
+class Injector : public BusNode {
+public:
+    explicit Injector(SimBus &bus) : driver(bus.attach(this)) {}
+    void busByte(uint8_t, uint64_t, bool) override {}
+    int driver;
+};
+
+static const uint32_t WARMUP_REQUESTS = 10;
+static const uint64_t STEP_US = 50;
+static const uint64_t TRIAL_LIMIT_US = 5000000;
+static const uint64_t REQUEST_GAP_US = 5000;
+
+static Frame nextRequest(uint32_t index) {
+    // Çift: fiyatı yaz, tek: ilk 4 register'ı oku
+    if (index % 2 == 0) {
+        return writeSingleRequest(MODBUS_SLAVE_ID, 2, index);
+    }
+    return readRequest(MODBUS_SLAVE_ID, 0x03, 0, 4);
+}
+
+// Hatalı isteği hatta koy; isteğin bitişini döndürür (master zaman aşımı
+// buradan sayar). Hatanın bitişi 'faultEndUs'a yazılır; gevezelik ve
+// parazit isteğin bitişinden uzun sürebilir.
+static uint64_t injectFault(Fault fault, const Frame &request, uint64_t nowUs, SimBus &bus,
+                            SimMaster &master, Injector &noise, std::mt19937 &rng, uint64_t &faultEndUs) {
+    uint32_t byteUs = bus.byteUs();
+    size_t len = request.size();
+    std::uniform_int_distribution<size_t> cut(1, len - 1);
+
+    switch (fault) {
+        case FAULT_FLIP: {
+            Frame f = request;
+            size_t i = std::uniform_int_distribution<size_t>(0, len - 1)(rng);
+            f[i] ^= 1 << std::uniform_int_distribution<int>(0, 7)(rng);
+            return faultEndUs = master.send(nowUs, f);
+        }
+        case FAULT_TRUNC: {
+            Frame f(request.begin(), request.begin() + cut(rng));
+            return faultEndUs = master.send(nowUs, f);
+        }
+        case FAULT_GAP2:
+        case FAULT_GAP5: {
+            size_t k = cut(rng);
+            Frame head(request.begin(), request.begin() + k);
+            Frame tail(request.begin() + k, request.end());
+            uint64_t end = master.send(nowUs, head);
+            return faultEndUs = master.send(end + (fault == FAULT_GAP2 ? 2 : 5) * byteUs, tail);
+        }
+        case FAULT_NOISE: {
+            uint8_t junk[3];
+            size_t n = std::uniform_int_distribution<size_t>(1, 3)(rng);
+            for (size_t i = 0; i < n; i++) {
+                junk[i] = rng();
+            }
+            uint64_t end = bus.transmit(noise.driver, nowUs, junk, n);
+            uint64_t gap = std::uniform_int_distribution<uint32_t>(0, master.silenceUs() - byteUs)(rng);
+            return faultEndUs = master.send(end + gap, request);
+        }
+        case FAULT_BABBLE:
+        case FAULT_LONG_BABBLE: {
+            uint64_t durationUs = fault == FAULT_BABBLE
+                                      ? std::uniform_int_distribution<uint32_t>(5000, 50000)(rng)
+                                      : std::uniform_int_distribution<uint32_t>(150000, 500000)(rng);
+            uint64_t startUs = nowUs + std::uniform_int_distribution<uint32_t>(0, len * byteUs)(rng);
+            std::vector<uint8_t> babble(durationUs / byteUs);
+            for (uint8_t &b : babble) {
+                b = rng();
+            }
+            faultEndUs = bus.transmit(noise.driver, startUs, babble.data(), babble.size());
+            return master.send(nowUs, request);
+        }
+        case FAULT_BURST: {
+            // Parazit önceden hatta konur; master kendi akışında araya girer
+            uint64_t untilUs = nowUs + std::uniform_int_distribution<uint32_t>(150000, 500000)(rng);
+            faultEndUs = nowUs;
+            for (uint64_t t = nowUs; t < untilUs;
+                 t += std::uniform_int_distribution<uint32_t>(5000, 20000)(rng)) {
+                uint8_t junk[3];
+                size_t n = std::uniform_int_distribution<size_t>(1, 3)(rng);
+                for (size_t i = 0; i < n; i++) {
+                    junk[i] = rng();
+                }
+                faultEndUs = bus.transmit(noise.driver, t, junk, n);
+            }
+            return master.send(nowUs, request);
+        }
+        default:
+            return faultEndUs = master.send(nowUs, request);
+    }
+}
+
+static TrialResult runTrial(Fault fault, std::mt19937 &rng, const Options &opt) {
+    SimBus bus(MODBUS_BAUD);
+    SimMaster master(bus, MODBUS_BAUD);
+    SimSign sign(bus, MODBUS_SLAVE_ID, opt.pollUs);
+    Injector noise(bus);
+
+    TrialResult result = { 0, 0, 0, false };
+    uint32_t index = 0;
+    bool waiting = false;
+    bool faulted = false;
+    uint64_t faultEndUs = 0;
+    uint64_t deadlineUs = 0;
+    Frame request;
+
+    // Hatadan sonraki ilk sağlam istek ve o an tabelanın kabul ettiği çerçeve sayısı
+    bool probeSent = false;
+    bool probeArmed = false;
+    bool resynced = false;
+    uint64_t probeEndUs = 0;
+    uint32_t acceptedBase = 0;
+    std::uniform_int_distribution<uint32_t> jitter(0, opt.pollUs);
+
+    // Master'ın tabela döngüsüne göre fazı her denemede farklı
+    uint64_t nextSendUs = std::uniform_int_distribution<uint32_t>(0, opt.pollUs)(rng);
+
+    for (uint64_t now = 0; now < TRIAL_LIMIT_US; now += STEP_US) {
+        bus.deliverUntil(now);
+        sign.runUntil(now);
+
+        uint32_t accepted = sign.slave().diagnostics().slaveMessages;
+        if (probeSent && !probeArmed && now >= probeEndUs) {
+            probeArmed = true;
+            acceptedBase = accepted;
+        } else if (probeArmed && !resynced && accepted > acceptedBase) {
+            resynced = true;
+            result.resyncMs = (now - probeEndUs) / 1000.0;
+        }
+        if (resynced && result.recovered) {
+            return result;
+        }
+
+        if (waiting) {
+            Frame reply;
+            uint64_t endUs;
+            while (master.takeFrame(now, reply, endUs)) {
+                if (!replyMatches(request, reply)) {
+                    continue;
+                }
+                waiting = false;
+                if (faulted && endUs >= faultEndUs && !result.recovered) {
+                    result.recovered = true;
+                    result.recoveryMs = (endUs - faultEndUs) / 1000.0;
+                }
+                nextSendUs = now + REQUEST_GAP_US + jitter(rng);
+                break;
+            }
+            if (waiting && now >= deadlineUs) {
+                waiting = false;
+                if (faulted && index - 1 > WARMUP_REQUESTS) {
+                    result.lost++;
+                }
+                nextSendUs = now;
+            }
+        }
+
+        if (!waiting && now >= nextSendUs) {
+            master.flush();
+            request = nextRequest(index);
+            uint64_t endUs;
+            if (index == WARMUP_REQUESTS) {
+                endUs = injectFault(fault, request, now, bus, master, noise, rng, faultEndUs);
+                faulted = true;
+            } else {
+                endUs = master.send(now, request);
+                if (faulted && !probeSent && now >= faultEndUs) {
+                    probeSent = true;
+                    probeEndUs = endUs;
+                }
+            }
+            waiting = true;
+            deadlineUs = endUs + opt.timeoutUs;
+            index++;
+        }
+    }
+    return result;
+}
+
+static double percentile(std::vector<double> v, double p) {
+    if (v.empty()) {
+        return 0;
+    }
+    std::sort(v.begin(), v.end());
+    size_t i = (size_t)(p * (v.size() - 1) + 0.5);
+    return v[i];
+}
+
+static double mean(const std::vector<double> &v) {
+    double sum = 0;
+    for (double x : v) {
+        sum += x;
+    }
+    return v.empty() ? 0 : sum / v.size();
+}
+
+static bool parseArgs(int argc, char **argv, Options &opt) {
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!value) {
+            return false;
+        }
+        if (strcmp(arg, "--trials") == 0) {
+            opt.trials = atoi(value);
+        } else if (strcmp(arg, "--seed") == 0) {
+            opt.seed = strtoul(value, nullptr, 10);
+        } else if (strcmp(arg, "--poll-ms") == 0) {
+            opt.pollUs = atoi(value) * 1000;
+        } else if (strcmp(arg, "--timeout-ms") == 0) {
+            opt.timeoutUs = atoi(value) * 1000;
+        } else if (strcmp(arg, "--csv") == 0) {
+            opt.csv = value;
+        } else if (strcmp(arg, "--label") == 0) {
+            opt.label = value;
+        } else if (strcmp(arg, "--max-resync-ms") == 0) {
+            opt.maxResyncMs = atof(value);
+        } else {
+            return false;
+        }
+        i++;
+    }
+    return opt.trials > 0 && opt.pollUs > 0;
+}
+
+int main(int argc, char **argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        fprintf(stderr, "kullanim: %s [--trials N] [--seed S] [--poll-ms P] [--timeout-ms T]\n"
+                        "          [--csv dosya] [--label ad] [--max-resync-ms M]\n", argv[0]);
+        return 2;
+    }
+
+    FILE *csv = opt.csv ? fopen(opt.csv, "a") : nullptr;
+    if (opt.csv && !csv) {
+        fprintf(stderr, "%s acilamadi\n", opt.csv);
+        return 2;
+    }
+
+    printf("%d baud, dongu %u ms, zaman asimi %u ms, %d deneme\n\n", MODBUS_BAUD,
+           opt.pollUs / 1000, opt.timeoutUs / 1000, opt.trials);
+    printf("%-7s %6s %6s   %21s   %21s %6s\n", "", "kayip", "", "resync (ms)",
+           "toparlanma (ms)", "");
+    printf("%-7s %6s %6s %7s %7s %7s %7s %7s %7s %6s\n", "hata", "ort", "max", "ort", "p95",
+           "max", "ort", "p95", "max", "basar.");
+
+    int status = 0;
+    for (int f = 0; f < FAULT_COUNT; f++) {
+        std::vector<double> resync;
+        std::vector<double> recovery;
+        uint32_t lostTotal = 0;
+        uint32_t lostMax = 0;
+        int failed = 0;
+
+        for (int t = 0; t < opt.trials; t++) {
+            std::mt19937 rng(opt.seed * 7919 + t * 131 + f);
+            TrialResult r = runTrial((Fault)f, rng, opt);
+            lostTotal += r.lost;
+            lostMax = std::max(lostMax, r.lost);
+            if (r.recovered) {
+                resync.push_back(r.resyncMs);
+                recovery.push_back(r.recoveryMs);
+            } else {
+                failed++;
+            }
+        }
+
+        double lostAvg = (double)lostTotal / opt.trials;
+        double syncP95 = percentile(resync, 0.95);
+        printf("%-7s %6.2f %6u %7.1f %7.1f %7.1f %7.1f %7.1f %7.1f %6d\n", FAULT_NAMES[f],
+               lostAvg, lostMax, mean(resync), syncP95, percentile(resync, 1.0), mean(recovery),
+               percentile(recovery, 0.95), percentile(recovery, 1.0), failed);
+        if (csv) {
+            fprintf(csv, "%s,%s,%d,%.3f,%u,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%d\n", opt.label,
+                    FAULT_NAMES[f], opt.trials, lostAvg, lostMax, mean(resync), syncP95,
+                    percentile(resync, 1.0), mean(recovery), percentile(recovery, 0.95),
+                    percentile(recovery, 1.0), failed);
+        }
+        if (failed || (opt.maxResyncMs > 0 && syncP95 > opt.maxResyncMs)) {
+            status = 1;
+        }
+    }
+
+    if (csv) {
+        fclose(csv);
+    }
+    return status;
+}
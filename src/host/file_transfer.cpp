@@ -0,0 +1,305 @@
+/*
+ * FC21 dosya aktarımı: uçtan uca hız (bayt/s) her baud için.
+ *
+ * Sanal hatta bir master ve bir tabela (SimSign, src/main.cpp'nin Modbus
+ * yolu) bulunur; tabelanın dosya kayıtları RAM'deki bir flash bölgesi
+ * üzerindeki ContentStore'a bağlıdır. Master dosyayı en büyük FC21
+ * çerçeveleriyle (122 kayıt = 244 bayt) sırayla yazar; her yanıttan sonra
+ * sıradakini gönderir, zaman aşımında aynı parçayı tekrar yollar.
+ *
+ * Flash süreleri tabelanın döngüsünü bloke eder (cihazda yazma Modbus
+ * görevinde yapılır): sektör silme --erase-ms, 4 KB yazma --write-ms.
+ * Aktarımın başlatılması ve bitirilmesi cihazda HR144-151 ile yapılır;
+ * burada ContentStore doğrudan çağrılır, commit'in flash süresi toplama
+ * eklenir.
+ *
+ * Süre ilk isteğin başından commit'in bitişine kadardır. Sütunlar:
+ *   bayt/s   dosya boyutu / süre
+ *   hat %    bayt/s'nin hattın ham kapasitesine (baud / 10) oranı
+ *   tekrar   zaman aşımıyla yeniden gönderilen istek
+ * Dosya commit'ten sonra geri okunup karşılaştırılır; uyuşmazsa çıkış
+ * kodu 1 olur.
+ *
+ * Varsayılan hız cihazın derlendiği MODBUS_BAUD'dur (SignRegisters.h).
+ * --bauds ile verilen diğer hızlar sadece simülasyondur ("sim" notu):
+ * cihaz bu hızlarda MODBUS_BAUD değiştirilip yeniden derlenmeden ölçülmüş
+ * değildir.
+ *
+ * Kullanım:
+ *   program [--bauds 9600,19200,38400] [--size N (cift)] [--poll-ms P]
+ *           [--timeout-ms T] [--erase-ms E] [--write-ms W]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vector>
+
+#include "ContentStore.h"
+#include "ModbusCrc.h"
+#include "ModbusFrames.h"
+#include "SignRegisters.h"
+#include "SimBus.h"
+#include "SimMaster.h"
+#include "SimSign.h"
+
+struct Options {
+    std::vector<uint32_t> bauds = { MODBUS_BAUD };
+    uint32_t size = ContentStore::FILE_BYTES;
+    uint32_t pollUs = 10000;
+    uint32_t timeoutUs = 1000000;
+    uint32_t eraseUs = 45000;
+    uint32_t writeUs = 11000;
+};
+
+// Tek dosya yuvası kadar RAM; silme / yazma süresi tabelayı bekletir
+class RamFlash : public FlashDevice {
+public:
+    RamFlash(uint32_t eraseUs, uint32_t writeUs)
+        : data((uint32_t)ContentStore::SLOT_SECTORS * SECTOR_SIZE, 0xFF), sign(nullptr),
+          eraseUs(eraseUs), writeUs(writeUs), busyUs(0), erases(0) {}
+
+    void attach(SimSign *s) { sign = s; }
+
+    uint32_t size() const override { return data.size(); }
+
+    bool eraseSector(uint32_t offset) override {
+        if (offset % SECTOR_SIZE || offset >= data.size()) {
+            return false;
+        }
+        memset(&data[offset], 0xFF, SECTOR_SIZE);
+        erases++;
+        block(eraseUs);
+        return true;
+    }
+
+    // NOR flash: yazma sadece bit temizler
+    bool write(uint32_t offset, const uint8_t *src, uint32_t len) override {
+        if (offset + len > data.size()) {
+            return false;
+        }
+        for (uint32_t i = 0; i < len; i++) {
+            data[offset + i] &= src[i];
+        }
+        block((uint64_t)writeUs * len / SECTOR_SIZE);
+        return true;
+    }
+
+    bool read(uint32_t offset, uint8_t *dst, uint32_t len) override {
+        if (offset + len > data.size()) {
+            return false;
+        }
+        memcpy(dst, &data[offset], len);
+        return true;
+    }
+
+    // Tabela döngüsü dışında (begin / commit) geçen flash süresi
+    uint64_t takeBusyUs() {
+        uint64_t us = busyUs;
+        busyUs = 0;
+        return us;
+    }
+
+    uint32_t eraseCount() const { return erases; }
+
+private:
+    std::vector<uint8_t> data;
+    SimSign *sign;
+    uint32_t eraseUs;
+    uint32_t writeUs;
+    uint64_t busyUs;
+    uint32_t erases;
+
+    void block(uint64_t us) {
+        busyUs += us;
+        if (sign) {
+            sign->stall(us);
+        }
+    }
+};
+
+static const uint16_t FILE_NUMBER = 1;
+static const uint16_t CHUNK_RECORDS = 122;  // bayt sayısı alanı (0xFB) sınırı
+static const uint64_t STEP_US = 50;
+static const uint64_t RUN_LIMIT_US = 3600000000ULL;
+
+// FC21, tek alt istek
+static Frame writeFileRequest(uint8_t unit, uint16_t file, uint16_t record, const uint8_t *data,
+                              uint16_t records) {
+    Frame f;
+    f.push_back(unit);
+    f.push_back(0x15);
+    f.push_back(7 + records * 2);
+    f.push_back(6);
+    pushU16(f, file);
+    pushU16(f, record);
+    pushU16(f, records);
+    f.insert(f.end(), data, data + records * 2);
+    appendCrc(f);
+    return f;
+}
+
+struct TransferResult {
+    bool ok;
+    double seconds;
+    uint32_t requests;
+    uint32_t retries;
+    uint32_t erases;
+};
+
+static TransferResult transfer(uint32_t baud, const std::vector<uint8_t> &content, const Options &opt) {
+    SimBus bus(baud);
+    SimMaster master(bus, baud);
+    SimSign sign(bus, MODBUS_SLAVE_ID, opt.pollUs, baud);
+    RamFlash flash(opt.eraseUs, opt.writeUs);
+    ContentStore store(flash);
+    store.begin();
+    sign.setFileStore(&store);
+
+    TransferResult result = { false, 0, 0, 0, 0 };
+    uint16_t crc = modbusCrc(content.data(), content.size());
+    if (store.beginTransfer(FILE_NUMBER, content.size(), crc) != ContentStore::STATUS_RECEIVING) {
+        return result;
+    }
+    uint64_t startUs = flash.takeBusyUs();
+    flash.attach(&sign);
+
+    uint32_t records = content.size() / 2;
+    uint32_t next = 0;
+    bool waiting = false;
+    uint64_t deadlineUs = 0;
+    uint64_t doneUs = 0;
+    Frame request;
+
+    for (uint64_t now = startUs; now < startUs + RUN_LIMIT_US; now += STEP_US) {
+        bus.deliverUntil(now);
+        sign.runUntil(now);
+
+        if (waiting) {
+            Frame reply;
+            uint64_t endUs;
+            while (master.takeFrame(now, reply, endUs)) {
+                if (replyMatches(request, reply)) {
+                    waiting = false;
+                    next += frameU16(request, 8);
+                    doneUs = endUs;
+                    break;
+                }
+            }
+            if (waiting && now >= deadlineUs) {
+                waiting = false;
+                result.retries++;
+            }
+        }
+        if (waiting) {
+            continue;
+        }
+        if (next >= records) {
+            break;
+        }
+
+        uint16_t n = records - next < CHUNK_RECORDS ? records - next : CHUNK_RECORDS;
+        master.flush();
+        request = writeFileRequest(MODBUS_SLAVE_ID, FILE_NUMBER, next, &content[next * 2], n);
+        deadlineUs = master.send(now, request) + opt.timeoutUs;
+        waiting = true;
+        result.requests++;
+    }
+    if (next < records) {
+        return result;
+    }
+
+    flash.attach(nullptr);
+    if (store.commitTransfer() != ContentStore::STATUS_VERIFIED) {
+        return result;
+    }
+    doneUs += flash.takeBusyUs();
+
+    std::vector<uint8_t> back(content.size());
+    result.ok = store.readRecords(FILE_NUMBER, 0, back.data(), back.size()) == 0 && back == content;
+    result.seconds = (doneUs - startUs) / 1e6;
+    result.erases = flash.eraseCount();
+    return result;
+}
+
+static bool parseBauds(const char *value, std::vector<uint32_t> &bauds) {
+    bauds.clear();
+    for (const char *p = value; *p;) {
+        char *end;
+        unsigned long baud = strtoul(p, &end, 10);
+        if (end == p || baud < 1200) {
+            return false;
+        }
+        bauds.push_back(baud);
+        p = *end == ',' ? end + 1 : end;
+        if (*end && *end != ',') {
+            return false;
+        }
+    }
+    return !bauds.empty();
+}
+
+static bool parseArgs(int argc, char **argv, Options &opt) {
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!value) {
+            return false;
+        }
+        if (strcmp(arg, "--bauds") == 0) {
+            if (!parseBauds(value, opt.bauds)) {
+                return false;
+            }
+        } else if (strcmp(arg, "--size") == 0) {
+            opt.size = strtoul(value, nullptr, 10);
+        } else if (strcmp(arg, "--poll-ms") == 0) {
+            opt.pollUs = atoi(value) * 1000;
+        } else if (strcmp(arg, "--timeout-ms") == 0) {
+            opt.timeoutUs = atoi(value) * 1000;
+        } else if (strcmp(arg, "--erase-ms") == 0) {
+            opt.eraseUs = atoi(value) * 1000;
+        } else if (strcmp(arg, "--write-ms") == 0) {
+            opt.writeUs = atoi(value) * 1000;
+        } else {
+            return false;
+        }
+        i++;
+    }
+    return opt.size > 0 && opt.size % 2 == 0 && opt.size <= ContentStore::FILE_BYTES && opt.pollUs > 0 && opt.timeoutUs > 0;
+}
+
+int main(int argc, char **argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        fprintf(stderr, "kullanim: %s [--bauds 9600,19200,38400] [--size 2-%u, cift] [--poll-ms P]\n"
+                        "          [--timeout-ms T] [--erase-ms E] [--write-ms W]\n",
+                argv[0], ContentStore::FILE_BYTES);
+        return 2;
+    }
+
+    std::vector<uint8_t> content(opt.size);
+    uint32_t seed = 1;
+    for (uint8_t &b : content) {
+        seed = seed * 1664525 + 1013904223;
+        b = seed >> 24;
+    }
+
+    printf("%u bayt, FC21 %u kayit/istek, dongu %u ms, silme %u ms, 4 KB yazma %u ms\n\n", opt.size,
+           CHUNK_RECORDS, opt.pollUs / 1000, opt.eraseUs / 1000, opt.writeUs / 1000);
+    printf("%7s %8s %8s %6s %6s %6s %6s  %s\n", "baud", "sure s", "bayt/s", "hat %", "istek", "tekrar",
+           "silme", "dosya");
+    int status = 0;
+    for (uint32_t baud : opt.bauds) {
+        TransferResult r = transfer(baud, content, opt);
+        if (!r.ok) {
+            printf("%7u %8s %8s %6s %6u %6u %6s  HATALI\n", baud, "-", "-", "-", r.requests, r.retries, "-");
+            status = 1;
+            continue;
+        }
+        double rate = opt.size / r.seconds;
+        printf("%7u %8.2f %8.0f %6.1f %6u %6u %6u  ayni%s\n", baud, r.seconds, rate, rate * 1000 / baud,
+               r.requests, r.retries, r.erases, baud == MODBUS_BAUD ? "" : "  sim");
+    }
+    return status;
+}
@@ -0,0 +1,247 @@
+/*
+ * Fiyat metni biçimlendirme ölçümü.
+ *
+ * Aynı fiyat dizisi her yöntemle metne çevrilir; çağrı başına süre (en iyi
+ * tur) ve heap ayırma sayısı yazdırılır:
+ *   String      eski yol: String(priceValue) + " TL"; host'ta Arduino String
+ *               olmadığından kısa metin optimizasyonu olmayan bir kopyası
+ *               (AVR çekirdeğindeki WString gibi): sayı metni, toplama
+ *               için kopya ve ekleme ayrı ayrı heap'ten alınır. std::string
+ *               bu boyda heap'e gitmez, ayırma maliyetini göstermez.
+ *   snprintf    "%ld TL"
+ *   bolme       basamak başına bir bölme (formatInt'in önceki hali)
+ *   formatInt   çift basamak tablosu
+ *   formatFixed çift basamak tablosu + ondalık, binlik ayırıcı ve işaret
+ *
+ * Süreler host'ta ölçülür. Host'ta çift basamak tablosu basamak döngüsünden
+ * hızlı değildir (fark ölçüm gürültüsü içindedir); ESP8266'da donanım
+ * bölmesi olmadığından bölme sayısının payı daha büyüktür, kazanç orada
+ * beklenir ama bu araçla ölçülmez.
+ *
+ * Kullanım:
+ *   program [--count N] [--decimals D] [--max M] [--rounds R]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <new>
+#include <vector>
+
+#include "TextFormat.h"
+
+// Heap ayırmaları sayılır
+static size_t allocations = 0;
+
+void *operator new(size_t size) {
+    allocations++;
+    void *p = malloc(size ? size : 1);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void *p) noexcept {
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    free(p);
+}
+
+struct Options {
+    uint32_t count = 1000000;
+    uint8_t decimals = 2;
+    uint32_t max = 10000000;
+    int rounds = 5;
+};
+
+// Basamak başına bölme (karşılaştırma için)
+static size_t formatDivide(char *buf, size_t size, int32_t value, const char *suffix) {
+    char digits[10];
+    uint8_t n = 0;
+    uint32_t magnitude = value < 0 ? 0UL - (uint32_t)value : (uint32_t)value;
+    do {
+        digits[n++] = '0' + magnitude % 10;
+        magnitude /= 10;
+    } while (magnitude > 0);
+    size_t len = 0;
+    if (value < 0 && len + 1 < size) {
+        buf[len++] = '-';
+    }
+    while (n > 0 && len + 1 < size) {
+        buf[len++] = digits[--n];
+    }
+    while (*suffix && len + 1 < size) {
+        buf[len++] = *suffix++;
+    }
+    buf[len] = '\0';
+    return len;
+}
+
+// Arduino String düzeni: tampon her zaman heap'te, ekleme yeni tampon alır
+class HeapString {
+public:
+    explicit HeapString(long value) : buffer(nullptr), len(0) {
+        char digits[12];
+        assign(digits, formatDivide(digits, sizeof(digits), value, ""));
+    }
+
+    HeapString(const HeapString &other) : buffer(nullptr), len(0) {
+        assign(other.buffer, other.len);
+    }
+
+    ~HeapString() {
+        delete[] buffer;
+    }
+
+    HeapString &operator=(const HeapString &) = delete;
+
+    // String + "..." : önce kopya (StringSumHelper), sonra ekleme
+    HeapString operator+(const char *suffix) const {
+        HeapString sum(*this);
+        sum.concat(suffix, strlen(suffix));
+        return sum;
+    }
+
+    const char *c_str() const { return buffer; }
+    size_t length() const { return len; }
+
+private:
+    char *buffer;
+    size_t len;
+
+    void assign(const char *src, size_t n) {
+        buffer = new char[n + 1];
+        memcpy(buffer, src, n);
+        buffer[n] = '\0';
+        len = n;
+    }
+
+    void concat(const char *src, size_t n) {
+        char *grown = new char[len + n + 1];
+        memcpy(grown, buffer, len);
+        memcpy(grown + len, src, n + 1);
+        delete[] buffer;
+        buffer = grown;
+        len += n;
+    }
+};
+
+struct Result {
+    double ns;
+    double allocs;
+};
+
+// Sonuçlar kullanılmazsa derleyici döngüyü atabilir
+static volatile uint32_t sink;
+
+// En iyi tur alınır (host'taki gürültüye karşı)
+template <class Fn>
+static Result run(const std::vector<int32_t> &prices, int rounds, Fn fn) {
+    typedef std::chrono::steady_clock Clock;
+    Result r = { 0, 0 };
+    for (int i = 0; i < rounds; i++) {
+        size_t before = allocations;
+        uint32_t check = 0;
+        Clock::time_point t0 = Clock::now();
+        for (int32_t p : prices) {
+            check += fn(p);
+        }
+        double ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / prices.size();
+        if (i == 0 || ns < r.ns) {
+            r.ns = ns;
+        }
+        r.allocs = (double)(allocations - before) / prices.size();
+        sink = check;
+    }
+    return r;
+}
+
+static void print(const char *name, const char *sample, const Result &r) {
+    printf("%-12s %-16s %8.1f %8.2f\n", name, sample, r.ns, r.allocs);
+}
+
+static bool parseArgs(int argc, char **argv, Options &opt) {
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!value) {
+            return false;
+        }
+        if (strcmp(arg, "--count") == 0) {
+            opt.count = strtoul(value, nullptr, 10);
+        } else if (strcmp(arg, "--decimals") == 0) {
+            opt.decimals = atoi(value);
+        } else if (strcmp(arg, "--max") == 0) {
+            opt.max = strtoul(value, nullptr, 10);
+        } else if (strcmp(arg, "--rounds") == 0) {
+            opt.rounds = atoi(value);
+        } else {
+            return false;
+        }
+        i++;
+    }
+    return opt.count > 0 && opt.decimals <= 9 && opt.max > 0 && opt.max <= 2147483647UL &&
+           opt.rounds > 0;
+}
+
+int main(int argc, char **argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        fprintf(stderr, "kullanim: %s [--count N] [--decimals D] [--max M] [--rounds R]\n", argv[0]);
+        return 2;
+    }
+
+    // Sabit tohumlu fiyatlar: çoğu pozitif, bir kısmı negatif (indirim)
+    std::vector<int32_t> prices(opt.count);
+    uint32_t seed = 1;
+    for (int32_t &p : prices) {
+        seed = seed * 1664525 + 1013904223;
+        p = (int32_t)(seed % opt.max);
+        if ((seed >> 28) == 0) {
+            p = -p;
+        }
+    }
+    const FixedFormat format = { opt.decimals, ',', '.', false };
+    char buf[24];
+
+    printf("%u fiyat, 0-%u, %u ondalik\n\n", opt.count, opt.max - 1, opt.decimals);
+    printf("%-12s %-16s %8s %8s\n", "yontem", "ornek", "ns/cagri", "heap");
+
+    // Örnek metin ölçümden sonra ilk fiyattan yazılır
+    char sample[24];
+    Result r = run(prices, opt.rounds, [](int32_t p) {
+        HeapString t = HeapString(p) + " TL";
+        return (uint32_t)t.length() + t.c_str()[0];
+    });
+    print("String", (HeapString(prices[0]) + " TL").c_str(), r);
+
+    r = run(prices, opt.rounds, [&buf](int32_t p) {
+        return (uint32_t)snprintf(buf, sizeof(buf), "%ld TL", (long)p) + buf[0];
+    });
+    snprintf(sample, sizeof(sample), "%ld TL", (long)prices[0]);
+    print("snprintf", sample, r);
+
+    r = run(prices, opt.rounds, [&buf](int32_t p) {
+        return (uint32_t)formatDivide(buf, sizeof(buf), p, " TL") + buf[0];
+    });
+    formatDivide(sample, sizeof(sample), prices[0], " TL");
+    print("bolme", sample, r);
+
+    r = run(prices, opt.rounds, [&buf](int32_t p) {
+        return (uint32_t)formatInt(buf, sizeof(buf), p, " TL") + buf[0];
+    });
+    formatInt(sample, sizeof(sample), prices[0], " TL");
+    print("formatInt", sample, r);
+
+    r = run(prices, opt.rounds, [&buf, &format](int32_t p) {
+        return (uint32_t)formatFixed(buf, sizeof(buf), p, format, " TL") + buf[0];
+    });
+    formatFixed(sample, sizeof(sample), prices[0], format, " TL");
+    print("formatFixed", sample, r);
+    return 0;
+}
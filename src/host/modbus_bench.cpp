@@ -0,0 +1,185 @@
+/*
+ * RtuSlave çerçeve işleme ve CRC ölçümü.
+ *
+ * CRC: aynı tampon tablolu modbusCrc() ve bit bit döngü ile hesaplanır,
+ * MB/s yazdırılır. Çerçeveler: istek baytları receive() ile halkaya yazılır,
+ * task() sessizlikten sonra çerçeveyi işler ve yanıtı kurar; saniyedeki
+ * çerçeve sayısı ve çerçeve başına süre yazdırılır:
+ *   read-cache   FC03, yanıt önbellekten
+ *   read         FC03, her seferinde yeniden kurulur (önbellek bozulur)
+ *   write-single FC06
+ *   write-multi  FC16
+ *   bad-crc      CRC'si bozuk çerçeve (yanıt yok)
+ * Zaman damgaları yapaydır; ölçülen sadece işlemci süresidir, hat süresi
+ * dahil değildir. Süreler host'ta ölçülür (en iyi tur).
+ *
+ * Kullanım:
+ *   program [--regs N] [--count N] [--rounds R]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <vector>
+
+#include "ModbusCrc.h"
+#include "RtuSlave.h"
+
+struct Options {
+    uint16_t regs = 10;
+    uint32_t count = 200000;
+    int rounds = 5;
+};
+
+// Yanıt atılır, sadece sayılır
+struct NullTransport : RtuTransport {
+    uint32_t sent = 0;
+
+    void send(const uint8_t *data, uint16_t len) override {
+        sent++;
+    }
+};
+
+static const uint16_t HOLDING_COUNT = 128;
+
+static NullTransport transport;
+static uint16_t holding[HOLDING_COUNT];
+static uint16_t input[4];
+static RtuSlave slave(transport, holding, HOLDING_COUNT, input, 4);
+static uint32_t now = 0;
+
+// Sonuçlar kullanılmazsa derleyici döngüyü atabilir
+static volatile uint32_t sink;
+
+static uint16_t crcBitwise(const uint8_t *data, size_t len) {
+    uint16_t crc = MODBUS_CRC_INIT;
+    while (len--) {
+        crc ^= *data++;
+        for (uint8_t i = 0; i < 8; i++) {
+            crc = crc & 1 ? (crc >> 1) ^ 0xA001 : crc >> 1;
+        }
+    }
+    return crc;
+}
+
+static std::vector<uint8_t> frame(std::vector<uint8_t> body) {
+    uint16_t crc = modbusCrc(body.data(), body.size());
+    body.push_back(crc & 0xFF);
+    body.push_back(crc >> 8);
+    return body;
+}
+
+// İşlem başına ns, en iyi tur alınır (host'taki gürültüye karşı)
+template <class Fn>
+static double run(uint32_t count, int rounds, Fn fn) {
+    typedef std::chrono::steady_clock Clock;
+    double best = 0;
+    for (int r = 0; r < rounds; r++) {
+        uint32_t check = 0;
+        Clock::time_point t0 = Clock::now();
+        for (uint32_t i = 0; i < count; i++) {
+            check += fn(i);
+        }
+        double ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / count;
+        if (r == 0 || ns < best) {
+            best = ns;
+        }
+        sink = check;
+    }
+    return best;
+}
+
+// Çerçeveyi 9600 baud karakter aralığıyla al ve sessizlikten sonra işle
+static uint32_t feed(const std::vector<uint8_t> &f) {
+    for (uint8_t b : f) {
+        slave.receive(b, now);
+        now += 1146;
+    }
+    now += slave.silenceUs();
+    slave.task(now);
+    return transport.sent;
+}
+
+static void frames(const char *name, const Options &opt, const std::vector<uint8_t> &f,
+                   bool invalidate = false) {
+    uint32_t sentBefore = transport.sent;
+    double ns = run(opt.count, opt.rounds, [&](uint32_t) {
+        if (invalidate) {
+            slave.holdingChanged(0, opt.regs);
+        }
+        return feed(f);
+    });
+    uint32_t replies = transport.sent - sentBefore;
+    printf("%-13s %5zu %10.0f %8.0f %8.2f\n", name, f.size(), 1e9 / ns, ns,
+           (double)replies / ((double)opt.count * opt.rounds));
+}
+
+static bool parseArgs(int argc, char **argv, Options &opt) {
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!value) {
+            return false;
+        }
+        if (strcmp(arg, "--regs") == 0) {
+            opt.regs = atoi(value);
+        } else if (strcmp(arg, "--count") == 0) {
+            opt.count = strtoul(value, nullptr, 10);
+        } else if (strcmp(arg, "--rounds") == 0) {
+            opt.rounds = atoi(value);
+        } else {
+            return false;
+        }
+        i++;
+    }
+    return opt.regs >= 1 && opt.regs <= 123 && opt.count > 0 && opt.rounds > 0;
+}
+
+int main(int argc, char **argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        fprintf(stderr, "kullanim: %s [--regs 1-123] [--count N] [--rounds R]\n", argv[0]);
+        return 2;
+    }
+    slave.begin(1, 9600);
+
+    // CRC: en büyük RTU çerçevesi boyunda tampon
+    std::vector<uint8_t> buf(RtuSlave::MAX_ADU);
+    uint32_t seed = 1;
+    for (uint8_t &b : buf) {
+        seed = seed * 1664525 + 1013904223;
+        b = seed >> 24;
+    }
+    uint32_t crcCount = opt.count / 10 + 1;
+    double table = run(crcCount, opt.rounds, [&](uint32_t i) {
+        buf[0] = i;
+        return modbusCrc(buf.data(), buf.size());
+    });
+    double bitwise = run(crcCount, opt.rounds, [&](uint32_t i) {
+        buf[0] = i;
+        return crcBitwise(buf.data(), buf.size());
+    });
+    printf("CRC (%zu bayt)   MB/s   ns/cerceve\n", buf.size());
+    printf("  tablo      %8.1f %10.0f\n", buf.size() * 1e3 / table, table);
+    printf("  bit bit    %8.1f %10.0f\n\n", buf.size() * 1e3 / bitwise, bitwise);
+
+    uint8_t n = opt.regs;
+    std::vector<uint8_t> multi = { 1, 16, 0, 0, 0, n, (uint8_t)(n * 2) };
+    for (uint8_t i = 0; i < n; i++) {
+        multi.push_back(0);
+        multi.push_back(i);
+    }
+    std::vector<uint8_t> bad = frame({ 1, 3, 0, 0, 0, n });
+    bad.back() ^= 1;
+
+    printf("%u register, %u cerceve\n", opt.regs, opt.count);
+    printf("%-13s %5s %10s %8s %8s\n", "istek", "bayt", "cerceve/s", "ns", "yanit");
+    frames("read-cache", opt, frame({ 1, 3, 0, 0, 0, n }));
+    frames("read", opt, frame({ 1, 3, 0, 0, 0, n }), true);
+    frames("write-single", opt, frame({ 1, 6, 0, 1, 0x12, 0x34 }));
+    frames("write-multi", opt, frame(multi));
+    frames("bad-crc", opt, bad);
+    return 0;
+}
@@ -0,0 +1,311 @@
+/*
+ * Derleme zamanı geometri ile çalışma zamanı geometri karşılaştırması.
+ *
+ * Aynı çizim işleri iki framebuffer ile yapılır; işlem başına süre (en iyi
+ * tur) yazdırılır:
+ *   runtime   DMD2'deki SPIDMD yolu: panel sayısı kurucuda verilir, satır
+ *             adımı ve bayt indeksi her pikselde hesaplanır, ekran dışındaki
+ *             karakterler de çözülür
+ *   template  PanelFrame<PanelGeometry<W, H>>
+ *
+ * İşler:
+ *   clear   ekranı sil
+ *   pixels  tüm pikselleri tek tek yaz (dama deseni)
+ *   marquee kayan yazı karesi: sil + metni x konumunda çiz, x her karede
+ *           bir azalır
+ *   scan    tam tarama: 4 tarama adımının SPI baytları
+ *
+ * Panel sayısı komut satırından okunur; derleyici çalışma zamanı yolunu
+ * sabitlerle özelleştiremez. Her işten sonra iki framebuffer karşılaştırılır.
+ * Süreler host'ta ölçülür, ESP8266'da oranlar farklı olabilir: örneğin
+ * x86'da sabit boyutlu memset 'rep stos'a dönüşür ve küçük karelerde
+ * kütüphane memset'inden yavaştır (clear satırı).
+ *
+ * Kullanım:
+ *   program [--panels 1x1|2x1|2x2] [--count N] [--rounds R]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+
+#include "HostFont5x7.h"
+#include "PanelFrame.h"
+
+// Çalışma zamanı geometrili framebuffer (DMD2 DMDFrame/SPIDMD düzeni)
+class RuntimeFrame {
+public:
+    static const uint8_t PANEL_WIDTH = 32;
+    static const uint8_t PANEL_HEIGHT = 16;
+
+    RuntimeFrame(uint8_t panelsWide, uint8_t panelsHigh)
+        : width(panelsWide * PANEL_WIDTH), height(panelsHigh * PANEL_HEIGHT), panelsHigh(panelsHigh),
+          font(nullptr) {
+        bitmap = (uint8_t *)malloc(bitmapBytes());
+        clearScreen();
+    }
+
+    ~RuntimeFrame() {
+        free(bitmap);
+    }
+
+    void clearScreen() {
+        memset(bitmap, 0, bitmapBytes());
+    }
+
+    void setPixel(int x, int y, bool on = true) {
+        if (x < 0 || y < 0 || x >= width || y >= height) {
+            return;
+        }
+        uint8_t &b = bitmap[pixelToBitmapIndex(x, y)];
+        uint8_t mask = 0x80 >> (x & 7);
+        if (on) {
+            b |= mask;
+        } else {
+            b &= ~mask;
+        }
+    }
+
+    void selectFont(const uint8_t *newFont) {
+        font = newFont;
+    }
+
+    // Sadece sabit genişlikli font (HostFont5x7)
+    int drawChar(int x, int y, char c) {
+        uint8_t w = font[2];
+        uint8_t h = font[3];
+        uint8_t first = font[4];
+        uint8_t code = (uint8_t)c;
+        if (code < first || code >= first + font[5]) {
+            return 0;
+        }
+        uint8_t bands = (h + 7) / 8;
+        uint16_t index = 6 + (code - first) * w * bands;
+        for (int j = 0; j < w; j++) {
+            for (uint8_t i = 0; i < bands; i++) {
+                uint8_t data = font[index + j + i * w];
+                int offset = (i == bands - 1 && bands > 1) ? h - 8 : i * 8;
+                for (uint8_t k = 0; k < 8 && offset + k < h; k++) {
+                    setPixel(x + j, y + offset + k, data & (1 << k));
+                }
+            }
+        }
+        return w;
+    }
+
+    int drawString(int x, int y, const char *str) {
+        for (; *str; str++) {
+            x += drawChar(x, y, *str) + 1;
+        }
+        return x;
+    }
+
+    void scanBytes(uint8_t scanRow, uint8_t *out) const {
+        uint16_t rowsize = unifiedWidthBytes();
+        const uint8_t *offset = bitmap + rowsize * scanRow;
+        for (uint16_t i = 0; i < rowsize; i++) {
+            out[4 * i + 0] = ~offset[i + rowsize * 12];
+            out[4 * i + 1] = ~offset[i + rowsize * 8];
+            out[4 * i + 2] = ~offset[i + rowsize * 4];
+            out[4 * i + 3] = ~offset[i];
+        }
+    }
+
+    const uint8_t *frameBuffer() const { return bitmap; }
+
+    uint16_t bitmapBytes() const { return unifiedWidthBytes() * PANEL_HEIGHT; }
+
+    const int width;
+    const int height;
+
+private:
+    uint8_t panelsHigh;
+    const uint8_t *font;
+    uint8_t *bitmap;
+
+    uint16_t unifiedWidthBytes() const { return width * panelsHigh / 8; }
+
+    uint16_t pixelToBitmapIndex(int x, int y) const {
+        x += width * (y / PANEL_HEIGHT);
+        y = y % PANEL_HEIGHT;
+        return x / 8 + y * unifiedWidthBytes();
+    }
+};
+
+struct Options {
+    uint8_t wide = 2;
+    uint8_t high = 1;
+    uint32_t count = 20000;
+    int rounds = 5;
+};
+
+// En büyük desteklenen geometri (2x2) için tarama tamponu
+static const uint16_t MAX_SCAN_BYTES = PanelGeometry<2, 2>::SCAN_BYTES;
+
+static const char MARQUEE_TEXT[] = "Hosgeldiniz - Bugunun fiyati 42,50 TL";
+
+// Sonuçlar kullanılmazsa derleyici döngüyü atabilir
+static volatile uint32_t sink;
+
+// Derleyici tamponu yazılmış ve okunacak saysın; değişmeyen kare için
+// döngü dışına alınmasın (GCC/Clang)
+static inline void clobber(const void *p) {
+    asm volatile("" : : "r"(p) : "memory");
+}
+
+// İşlem başına ns, en iyi tur alınır (host'taki gürültüye karşı)
+template <class Fn>
+static double run(const Options &opt, Fn fn) {
+    typedef std::chrono::steady_clock Clock;
+    double best = 0;
+    for (int r = 0; r < opt.rounds; r++) {
+        uint32_t check = 0;
+        Clock::time_point t0 = Clock::now();
+        for (uint32_t i = 0; i < opt.count; i++) {
+            check += fn(i);
+        }
+        double ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / opt.count;
+        if (r == 0 || ns < best) {
+            best = ns;
+        }
+        sink = check;
+    }
+    return best;
+}
+
+template <class Frame>
+static uint32_t drawPixels(Frame &frame, uint32_t i) {
+    for (int y = 0; y < frame.height; y++) {
+        for (int x = 0; x < frame.width; x++) {
+            frame.setPixel(x, y, ((x + y + i) & 1) != 0);
+        }
+    }
+    return frame.frameBuffer()[0];
+}
+
+template <class Frame>
+static uint32_t drawMarquee(Frame &frame, uint32_t i, int textWidth) {
+    int span = frame.width + textWidth;
+    frame.clearScreen();
+    return frame.drawString(frame.width - (int)(i % span), 4, MARQUEE_TEXT);
+}
+
+template <class Frame>
+static uint32_t scanFrame(const Frame &frame) {
+    uint8_t out[MAX_SCAN_BYTES];
+    uint32_t check = 0;
+    for (uint8_t s = 0; s < 4; s++) {
+        frame.scanBytes(s, out);
+        clobber(out);
+        check += out[s];
+    }
+    return check;
+}
+
+// PanelFrame'in width/height'ı fonksiyondur; işler aynı ifadeyle yazılsın
+template <class Geometry>
+struct FixedFrame : PanelFrame<Geometry> {
+    static constexpr int width = Geometry::WIDTH;
+    static constexpr int height = Geometry::HEIGHT;
+};
+
+template <class Geometry>
+static int bench(const Options &opt) {
+    RuntimeFrame dyn(opt.wide, opt.high);
+    static FixedFrame<Geometry> fixed;
+    dyn.selectFont(HostFont5x7);
+    fixed.selectFont(HostFont5x7);
+    int textWidth = fixed.stringWidth(MARQUEE_TEXT);
+    int bad = 0;
+
+    printf("%dx%d panel (%dx%d piksel, %u bayt), %u islem\n\n", opt.wide, opt.high, dyn.width, dyn.height,
+           dyn.bitmapBytes(), opt.count);
+    printf("%-8s %10s %10s %7s  %s\n", "is", "runtime", "template", "oran", "kare");
+
+    // Her işten sonra son kare iki yolda da aynı olmalı
+    auto report = [&](const char *name, double a, double b) {
+        bool same = memcmp(dyn.frameBuffer(), fixed.frameBuffer(), Geometry::FRAME_BYTES) == 0;
+        bad += !same;
+        printf("%-8s %10.1f %10.1f %6.2fx  %s\n", name, a, b, a / b, same ? "ayni" : "FARKLI");
+    };
+
+    double a = run(opt, [&](uint32_t) {
+        dyn.clearScreen();
+        clobber(dyn.frameBuffer());
+        return dyn.frameBuffer()[0];
+    });
+    double b = run(opt, [&](uint32_t) {
+        fixed.clearScreen();
+        clobber(fixed.frameBuffer());
+        return fixed.frameBuffer()[0];
+    });
+    report("clear", a, b);
+
+    a = run(opt, [&](uint32_t i) { return drawPixels(dyn, i); });
+    b = run(opt, [&](uint32_t i) { return drawPixels(fixed, i); });
+    report("pixels", a, b);
+
+    a = run(opt, [&](uint32_t i) { return drawMarquee(dyn, i, textWidth); });
+    b = run(opt, [&](uint32_t i) { return drawMarquee(fixed, i, textWidth); });
+    report("marquee", a, b);
+
+    a = run(opt, [&](uint32_t) { return scanFrame(dyn); });
+    b = run(opt, [&](uint32_t) { return scanFrame(fixed); });
+    // Tarama baytları da aynı olmalı
+    uint8_t outA[MAX_SCAN_BYTES], outB[MAX_SCAN_BYTES];
+    for (uint8_t s = 0; s < Geometry::SCAN; s++) {
+        dyn.scanBytes(s, outA);
+        fixed.scanBytes(s, outB);
+        bad += memcmp(outA, outB, Geometry::SCAN_BYTES) != 0;
+    }
+    report("scan", a, b);
+    return bad == 0 ? 0 : 1;
+}
+
+static bool parseArgs(int argc, char **argv, Options &opt) {
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!value) {
+            return false;
+        }
+        if (strcmp(arg, "--panels") == 0) {
+            int w, h;
+            if (sscanf(value, "%dx%d", &w, &h) != 2) {
+                return false;
+            }
+            opt.wide = w;
+            opt.high = h;
+        } else if (strcmp(arg, "--count") == 0) {
+            opt.count = strtoul(value, nullptr, 10);
+        } else if (strcmp(arg, "--rounds") == 0) {
+            opt.rounds = atoi(value);
+        } else {
+            return false;
+        }
+        i++;
+    }
+    return opt.count > 0 && opt.rounds > 0;
+}
+
+int main(int argc, char **argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        fprintf(stderr, "kullanim: %s [--panels 1x1|2x1|2x2] [--count N] [--rounds R]\n", argv[0]);
+        return 2;
+    }
+    // Şablon yolu sadece derlenmiş geometrilerle çalışır
+    if (opt.wide == 1 && opt.high == 1) {
+        return bench<P10Single>(opt);
+    }
+    if (opt.wide == 2 && opt.high == 1) {
+        return bench<P10Double>(opt);
+    }
+    if (opt.wide == 2 && opt.high == 2) {
+        return bench<PanelGeometry<2, 2> >(opt);
+    }
+    fprintf(stderr, "desteklenen paneller: 1x1, 2x1, 2x2\n");
+    return 2;
+}
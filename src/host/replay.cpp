@@ -0,0 +1,279 @@
+/*
+ * Trafik kaydını sanal tabelada tekrar oynatma.
+ *
+ * Kayıt cihazdan (HR152 = 1, sonra FC20 ile dosya 100) ya da bu aracın
+ * --record seçeneğiyle alınır (biçim: TrafficRecorder.h). Kayıttaki RX
+ * çerçeveleri (master istekleri ve başka slave'lerin yanıtları) sanal
+ * hatta özgün aralıklarla ya da --speed kat hızlı konur; çerçeveler arası
+ * t3.5 sessizlik her hızda korunur ve tabelaya giden istekten sonra yanıt
+ * (ya da zaman aşımı) beklenir. Tabela RenderSign'dır: src/main.cpp'nin
+ * Modbus yolu ve çizimi.
+ *
+ * Raporlananlar:
+ *   yanıtlar    simülasyon yanıtı kayıttaki TX ile aynı / farklı / eksik /
+ *               fazla. Kayıt anındaki register içeriği bilinmediği için ilk
+ *               okumalar farklı çıkabilir; yazma yanıtları aynı olmalıdır.
+ *   yanıt       isteğin bitişinden yanıtın başlamasına kadar, simülasyon
+ *               ve kayıt için ayrı ayrı
+ *   çizim       yazmanın beklemesi (sıra gecikmesi) + host'taki çizim süresi
+ *
+ * Kullanım:
+ *   program kayıt [--speed K] [--unit U] [--poll-ms P] [--timeout-ms T]
+ *           [--record çıktı]
+ *
+ * Farklı ya da eksik yanıt varsa çıkış kodu 1 olur.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "ModbusFrames.h"
+#include "RenderSign.h"
+#include "SignRegisters.h"
+#include "SimBus.h"
+#include "SimMaster.h"
+#include "TrafficFile.h"
+
+struct Options {
+    const char *input = nullptr;
+    const char *output = nullptr;
+    double speed = 1;
+    uint8_t unit = MODBUS_SLAVE_ID;
+    uint32_t pollUs = 10000;
+    uint32_t timeoutUs = 100000;
+};
+
+struct Request {
+    Frame data;
+    uint64_t startUs;    // kayıt zamanı, ilk çerçeveye göre
+    const Frame *reply;  // kayıttaki yanıt (yoksa nullptr)
+    double replyMs;      // kayıttaki yanıt gecikmesi
+};
+
+static const uint64_t STEP_US = 50;
+static const int MAX_MISMATCH_PRINT = 5;
+
+// RX kayıtlarını isteklere çevir; 32 bit damgalar taşmaya karşı farkla toplanır
+static std::vector<Request> buildRequests(const std::vector<TrafficRecord> &records,
+                                          uint32_t byteUs) {
+    std::vector<Request> requests;
+    uint64_t clock = 0;
+    uint32_t prev = records.empty() ? 0 : records[0].stampUs;
+    uint64_t base = 0;
+
+    for (const TrafficRecord &r : records) {
+        clock += (uint32_t)(r.stampUs - prev);
+        prev = r.stampUs;
+        if (r.dir == TrafficSink::DIR_TX) {
+            // Bir önceki RX'e verilen ilk yanıt
+            if (!requests.empty() && !requests.back().reply) {
+                Request &q = requests.back();
+                q.reply = &r.data;
+                uint64_t endUs = q.startUs + q.data.size() * byteUs;
+                q.replyMs = ((double)(clock - base) - endUs) / 1000.0;
+            }
+            continue;
+        }
+        uint64_t durUs = r.data.size() * byteUs;
+        if (requests.empty()) {
+            base = clock - durUs;
+        }
+        Request q = { r.data, clock - durUs - base, nullptr, 0 };
+        requests.push_back(q);
+    }
+    return requests;
+}
+
+static bool forSign(const Frame &f, uint8_t unit) {
+    return f.size() >= 4 && f[0] >= unit && f[0] <= unit + ZONE_COUNT;
+}
+
+static double percentile(std::vector<double> v, double p) {
+    if (v.empty()) {
+        return 0;
+    }
+    std::sort(v.begin(), v.end());
+    size_t i = (size_t)(p * (v.size() - 1) + 0.5);
+    return v[i];
+}
+
+static double mean(const std::vector<double> &v) {
+    double sum = 0;
+    for (double x : v) {
+        sum += x;
+    }
+    return v.empty() ? 0 : sum / v.size();
+}
+
+static void printRow(const char *name, const std::vector<double> &v, const char *unit) {
+    printf("  %-16s %6zu  ort %8.3f  p95 %8.3f  maks %8.3f %s\n", name, v.size(), mean(v),
+           percentile(v, 0.95), percentile(v, 1.0), unit);
+}
+
+static void printFrame(const char *label, const Frame &f) {
+    printf("    %-6s", label);
+    for (uint8_t b : f) {
+        printf(" %02X", b);
+    }
+    printf("\n");
+}
+
+static bool parseArgs(int argc, char **argv, Options &opt) {
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        if (arg[0] != '-') {
+            if (opt.input) {
+                return false;
+            }
+            opt.input = arg;
+            continue;
+        }
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!value) {
+            return false;
+        }
+        if (strcmp(arg, "--speed") == 0) {
+            opt.speed = atof(value);
+        } else if (strcmp(arg, "--unit") == 0) {
+            opt.unit = atoi(value);
+        } else if (strcmp(arg, "--poll-ms") == 0) {
+            opt.pollUs = atoi(value) * 1000;
+        } else if (strcmp(arg, "--timeout-ms") == 0) {
+            opt.timeoutUs = atoi(value) * 1000;
+        } else if (strcmp(arg, "--record") == 0) {
+            opt.output = value;
+        } else {
+            return false;
+        }
+        i++;
+    }
+    return opt.input && opt.speed > 0 && opt.pollUs > 0 && opt.unit > 0;
+}
+
+int main(int argc, char **argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        fprintf(stderr, "kullanim: %s kayit [--speed K] [--unit U] [--poll-ms P] [--timeout-ms T]\n"
+                        "          [--record cikti]\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<TrafficRecord> records;
+    if (!loadTraffic(opt.input, records)) {
+        fprintf(stderr, "%s okunamadi ya da bozuk (%zu kayit okundu)\n", opt.input, records.size());
+        if (records.empty()) {
+            return 2;
+        }
+    }
+
+    SimBus bus(MODBUS_BAUD);
+    SimMaster master(bus, MODBUS_BAUD);
+    RenderSign sign(bus, opt.unit, opt.pollUs);
+
+    TrafficFileWriter writer;
+    if (opt.output) {
+        if (!writer.open(opt.output)) {
+            fprintf(stderr, "%s acilamadi\n", opt.output);
+            return 2;
+        }
+        sign.setRecorder(&writer);
+    }
+
+    std::vector<Request> requests = buildRequests(records, bus.byteUs());
+    uint32_t matched = 0, mismatched = 0, missing = 0, extra = 0;
+    std::vector<double> simReply, recReply;
+
+    // Sıradaki çerçevenin en erken başlangıcı ve beklenen yanıt
+    const uint64_t originUs = opt.pollUs;
+    uint64_t readyUs = originUs;
+    uint64_t deadlineUs = 0;
+    uint64_t requestEndUs = 0;
+    const Request *waiting = nullptr;
+    size_t next = 0;
+
+    uint64_t now = 0;
+    for (; next < requests.size() || waiting; now += STEP_US) {
+        bus.deliverUntil(now);
+        sign.runUntil(now);
+
+        Frame reply;
+        uint64_t endUs;
+        while (master.takeFrame(now, reply, endUs)) {
+            readyUs = std::max(readyUs, endUs + master.silenceUs());
+            if (!waiting) {
+                extra++;
+                continue;
+            }
+            simReply.push_back((double)(endUs - reply.size() * bus.byteUs() - requestEndUs) / 1000.0);
+            if (!waiting->reply) {
+                extra++;
+            } else if (reply == *waiting->reply) {
+                matched++;
+                recReply.push_back(waiting->replyMs);
+            } else {
+                if (mismatched < MAX_MISMATCH_PRINT) {
+                    printf("farkli yanit:\n");
+                    printFrame("istek", waiting->data);
+                    printFrame("kayit", *waiting->reply);
+                    printFrame("sim", reply);
+                }
+                mismatched++;
+                recReply.push_back(waiting->replyMs);
+            }
+            waiting = nullptr;
+        }
+        if (waiting && now >= deadlineUs) {
+            if (waiting->reply) {
+                missing++;
+            }
+            waiting = nullptr;
+        }
+        if (waiting || next >= requests.size()) {
+            continue;
+        }
+
+        const Request &q = requests[next];
+        uint64_t at = originUs + (uint64_t)(q.startUs / opt.speed);
+        if (now < std::max(at, readyUs) || bus.busy(now)) {
+            continue;
+        }
+        requestEndUs = master.send(now, q.data);
+        readyUs = requestEndUs + master.silenceUs();
+        next++;
+        if (forSign(q.data, opt.unit)) {
+            waiting = &q;
+            deadlineUs = requestEndUs + opt.timeoutUs;
+        }
+    }
+    // Son çerçeve (yanıt beklenmeyen) tabelada da kapansın, kayda girsin
+    now += master.silenceUs() + opt.pollUs;
+    bus.deliverUntil(now);
+    sign.runUntil(now);
+    writer.close();
+
+    const std::vector<RenderSign::Sample> &samples = sign.samples();
+    std::vector<double> waitMs, drawUs, totalMs;
+    for (const RenderSign::Sample &s : samples) {
+        waitMs.push_back(s.waitUs / 1000.0);
+        drawUs.push_back(s.drawNs / 1000.0);
+        totalMs.push_back(s.waitUs / 1000.0 + s.drawNs / 1e6);
+    }
+
+    printf("%s: %zu kayit, %zu cerceve, %.1fx hiz, %d baud, dongu %u ms\n\n", opt.input,
+           records.size(), requests.size(), opt.speed, MODBUS_BAUD, opt.pollUs / 1000);
+    printf("yanitlar: %u ayni, %u farkli, %u eksik, %u fazla\n\n", matched, mismatched, missing,
+           extra);
+    printf("yanit gecikmesi (istek sonu -> yanit basi)\n");
+    printRow("simulasyon", simReply, "ms");
+    printRow("kayit", recReply, "ms");
+    printf("\ncizim (%zu yazma)\n", samples.size());
+    printRow("bekleme", waitMs, "ms");
+    printRow("cizim (host)", drawUs, "us");
+    printRow("toplam", totalMs, "ms");
+
+    return mismatched || missing ? 1 : 0;
+}
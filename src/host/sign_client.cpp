@@ -0,0 +1,143 @@
+/*
+ * SignClient ile örnek güncelleme senaryosu ve hat maliyeti ölçümü.
+ *
+ * Seri porta (gerçek adaptör ya da sign_pty.cpp'nin pty'si) bağlanıp
+ * tabelaları --updates kez günceller. Her güncellemede fiyat ve zaman
+ * değişir; ara sıra mod, hız, yazı slotu ve bölge değerleri de değişir.
+ * Sonunda güncelleme başına işlem, bayt ve süre yazdırılır.
+ *
+ * --no-batch bugünkü entegrasyonu taklit eder (her register ayrı FC06);
+ * iki çalıştırma karşılaştırılarak birleştirmenin kazancı görülür:
+ *   program /tmp/sign --signs 2
+ *   program /tmp/sign --signs 2 --no-batch
+ *
+ * Kullanım:
+ *   program port [--signs N] [--updates U] [--baud B] [--timeout-ms T] [--no-batch]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+
+#include "RtuLink.h"
+#include "SignClient.h"
+#include "SignRegisters.h"
+
+struct Options {
+    const char *port = nullptr;
+    int signs = 1;
+    int updates = 50;
+    uint32_t baud = MODBUS_BAUD;
+    uint32_t timeoutUs = 200000;
+    bool batching = true;
+};
+
+static uint8_t unitOf(int sign) {
+    return MODBUS_SLAVE_ID + sign * (ZONE_COUNT + 1);
+}
+
+// Güncelleme 'n' için istenen durum (her çalıştırmada aynı)
+static void script(SignClient &client, int signs, int n) {
+    static const char *const NEWS[] = { "KAMPANYA", "YENI URUN", "HOSGELDINIZ" };
+    for (int s = 0; s < signs; s++) {
+        uint8_t unit = unitOf(s);
+        client.setMode(unit, n % 20 < 15 ? 2 : MODE_ZONES);
+        client.setSpeed(unit, n % 10 == 0 ? 80 : 100);
+        client.setPrice(unit, 1500 + (n * 7 + s * 13) % 300);
+        client.setTime(unit, 60 - n % 60);
+        client.setText(unit, 0, NEWS[(n / 10) % 3]);
+        for (uint8_t z = 0; z < ZONE_COUNT; z++) {
+            client.setZone(unit, z, 2, 900 + z * 100 + (n / 5) % 50);
+        }
+    }
+}
+
+static bool parseArgs(int argc, char **argv, Options &opt) {
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        if (arg[0] != '-') {
+            if (opt.port) {
+                return false;
+            }
+            opt.port = arg;
+            continue;
+        }
+        if (strcmp(arg, "--no-batch") == 0) {
+            opt.batching = false;
+            continue;
+        }
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!value) {
+            return false;
+        }
+        if (strcmp(arg, "--signs") == 0) {
+            opt.signs = atoi(value);
+        } else if (strcmp(arg, "--updates") == 0) {
+            opt.updates = atoi(value);
+        } else if (strcmp(arg, "--baud") == 0) {
+            opt.baud = strtoul(value, nullptr, 10);
+        } else if (strcmp(arg, "--timeout-ms") == 0) {
+            opt.timeoutUs = atoi(value) * 1000;
+        } else {
+            return false;
+        }
+        i++;
+    }
+    return opt.port && opt.signs > 0 && opt.updates > 0;
+}
+
+int main(int argc, char **argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        fprintf(stderr, "kullanim: %s port [--signs N] [--updates U] [--baud B] [--timeout-ms T]"
+                        " [--no-batch]\n", argv[0]);
+        return 2;
+    }
+
+    SerialLink link;
+    if (!link.open(opt.port, opt.baud)) {
+        fprintf(stderr, "%s acilamadi\n", opt.port);
+        return 2;
+    }
+    SignClient client(link, opt.baud);
+    client.setBatching(opt.batching);
+    client.setTimeout(opt.timeoutUs);
+    for (int s = 0; s < opt.signs; s++) {
+        if (!client.addSign(unitOf(s))) {
+            fprintf(stderr, "tabela %d: adres %u kullanilamaz\n", s + 1, (unsigned)unitOf(s));
+            return 2;
+        }
+    }
+
+    // İlk güncelleme tüm durumu yazar; ölçüm sonrakiler içindir
+    script(client, opt.signs, 0);
+    bool ok = client.flush();
+    SignClient::Stats base = client.stats();
+
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point t0 = Clock::now();
+    int failed = 0;
+    for (int n = 1; n <= opt.updates; n++) {
+        script(client, opt.signs, n);
+        if (!client.flush()) {
+            failed++;
+        }
+    }
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+
+    const SignClient::Stats &st = client.stats();
+    double u = opt.updates;
+    printf("%s: %d tabela, %d guncelleme, %s\n", opt.port, opt.signs, opt.updates,
+           opt.batching ? "birlestirme acik" : "her register ayri FC06");
+    printf("  ilk yazma       %s, %u islem\n", ok ? "tamam" : "HATALI", base.transactions);
+    printf("  islem/gunc      %.2f\n", (st.transactions - base.transactions) / u);
+    printf("  register/gunc   %.2f\n", (st.registers - base.registers) / u);
+    printf("  bayt/gunc       %.1f gonderilen, %.1f alinan\n", (st.txBytes - base.txBytes) / u,
+           (st.rxBytes - base.rxBytes) / u);
+    printf("  sure/gunc       %.1f ms\n", ms / u);
+    printf("  zaman asimi %u, istisna %u, basarisiz guncelleme %d\n", st.timeouts, st.exceptions,
+           failed);
+    return failed || !ok ? 1 : 0;
+}
@@ -0,0 +1,175 @@
+/*
+ * Sanal tabelaları bir pty üzerinden gerçek zamanlı sunma.
+ *
+ * Bir pseudo-terminal açılır ve yolu yazdırılır; master tarafındaki araçlar
+ * (ör. sign_client.cpp, herhangi bir Modbus master yazılımı) onu seri port
+ * gibi açar. pty'den gelen baytlar sanal hatta o anki gerçek zamanda ve bayt
+ * süresiyle konur, tabelaların yanıtları pty'ye yazılır. Tabelalar
+ * SimSign'dır (src/main.cpp'nin Modbus yolu); birim numaraları bus_sim ile
+ * aynıdır: 1, 4, 7, ... (aradakiler bölge bankaları).
+ *
+ * Kullanım:
+ *   program [--signs N] [--poll-ms P] [--link yol]
+ *
+ * --link verilirse pty yoluna o adla sembolik bağ açılır (sabit yol için).
+ */
+
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "SignRegisters.h"
+#include "SimBus.h"
+#include "SimSign.h"
+
+struct Options {
+    int signs = 1;
+    uint32_t pollUs = 10000;
+    const char *link = nullptr;
+};
+
+// Hattaki baytları pty'ye veren ve pty'den geleni hatta koyan düğüm
+class PtyNode : public BusNode {
+public:
+    PtyNode(SimBus &bus, int fd) : bus(bus), driver(bus.attach(this)), fd(fd), txEndUs(0) {}
+
+    void busByte(uint8_t value, uint64_t endUs, bool collided) override {
+        if (write(fd, &value, 1) != 1) {
+            // Karşı taraf kapalıysa bayt kaybolur (hatta dinleyen yok)
+        }
+    }
+
+    void pump(uint64_t nowUs) {
+        uint8_t buf[256];
+        ssize_t n = read(fd, buf, sizeof(buf));
+        if (n > 0) {
+            txEndUs = bus.transmit(driver, txEndUs > nowUs ? txEndUs : nowUs, buf, n);
+        }
+    }
+
+private:
+    SimBus &bus;
+    int driver;
+    int fd;
+    uint64_t txEndUs;
+};
+
+static volatile sig_atomic_t stopping = 0;
+
+static void onSignal(int) {
+    stopping = 1;
+}
+
+static int openPty(const char *link) {
+    int fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if (fd < 0 || grantpt(fd) != 0 || unlockpt(fd) != 0) {
+        return -1;
+    }
+    // Karşı taraf açana kadar da ham mod (yankı yok)
+    const char *path = ptsname(fd);
+    int slave = open(path, O_RDWR | O_NOCTTY);
+    if (slave >= 0) {
+        termios tio;
+        tcgetattr(slave, &tio);
+        cfmakeraw(&tio);
+        tcsetattr(slave, TCSANOW, &tio);
+        close(slave);
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    printf("pty: %s\n", path);
+    if (link) {
+        unlink(link);
+        if (symlink(path, link) != 0) {
+            perror(link);
+        } else {
+            printf("bag: %s\n", link);
+        }
+    }
+    fflush(stdout);
+    return fd;
+}
+
+static bool parseArgs(int argc, char **argv, Options &opt) {
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!value) {
+            return false;
+        }
+        if (strcmp(arg, "--signs") == 0) {
+            opt.signs = atoi(value);
+        } else if (strcmp(arg, "--poll-ms") == 0) {
+            opt.pollUs = atoi(value) * 1000;
+        } else if (strcmp(arg, "--link") == 0) {
+            opt.link = value;
+        } else {
+            return false;
+        }
+        i++;
+    }
+    return opt.signs > 0 && opt.signs < SimBus::MAX_NODES &&
+           MODBUS_SLAVE_ID + opt.signs * (ZONE_COUNT + 1) <= 247 && opt.pollUs > 0;
+}
+
+int main(int argc, char **argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        fprintf(stderr, "kullanim: %s [--signs N] [--poll-ms P] [--link yol]\n", argv[0]);
+        return 2;
+    }
+
+    int fd = openPty(opt.link);
+    if (fd < 0) {
+        perror("pty");
+        return 2;
+    }
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    SimBus bus(MODBUS_BAUD);
+    PtyNode port(bus, fd);
+    std::vector<std::unique_ptr<SimSign>> signs;
+    for (int i = 0; i < opt.signs; i++) {
+        uint8_t unit = MODBUS_SLAVE_ID + i * (ZONE_COUNT + 1);
+        signs.emplace_back(new SimSign(bus, unit, opt.pollUs));
+        printf("tabela %d: birim %u (bolgeler %u-%u)\n", i, unit, unit + 1, unit + ZONE_COUNT);
+    }
+    fflush(stdout);
+
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point t0 = Clock::now();
+    while (!stopping) {
+        uint64_t now = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - t0).count();
+        port.pump(now);
+        bus.deliverUntil(now);
+        for (std::unique_ptr<SimSign> &s : signs) {
+            s->runUntil(now);
+        }
+        pollfd p = { fd, POLLIN, 0 };
+        if (poll(&p, 1, 1) > 0 && (p.revents & POLLHUP)) {
+            // Karşı taraf kapalı: hemen dönen poll'u bekleyerek yavaşlat
+            usleep(1000);
+        }
+    }
+
+    for (std::unique_ptr<SimSign> &s : signs) {
+        const ModbusDiagnostics &d = s->slave().diagnostics();
+        printf("birim %u: %u cerceve, %u kendine, %u yanit, %u crc hatasi\n", s->unitId(),
+               d.busMessages, d.slaveMessages, s->responses(), d.crcErrors);
+    }
+    if (opt.link) {
+        unlink(opt.link);
+    }
+    close(fd);
+    return 0;
+}
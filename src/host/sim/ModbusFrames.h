@@ -0,0 +1,92 @@
+/*
+ * Host araçları için Modbus RTU istek çerçeveleri.
+ */
+
+#ifndef SIM_MODBUS_FRAMES_H
+#define SIM_MODBUS_FRAMES_H
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "ModbusCrc.h"
+
+typedef std::vector<uint8_t> Frame;
+
+inline void appendCrc(Frame &f) {
+    uint16_t crc = modbusCrc(f.data(), f.size());
+    f.push_back(crc & 0xFF);
+    f.push_back(crc >> 8);
+}
+
+// CRC dahil tüm çerçevenin CRC'si sıfırdır
+inline bool crcOk(const Frame &f) {
+    return f.size() >= 4 && modbusCrc(f.data(), f.size()) == 0;
+}
+
+inline uint16_t frameU16(const Frame &f, size_t i) {
+    return ((uint16_t)f[i] << 8) | f[i + 1];
+}
+
+inline void pushU16(Frame &f, uint16_t v) {
+    f.push_back(v >> 8);
+    f.push_back(v & 0xFF);
+}
+
+// FC03 / FC04
+inline Frame readRequest(uint8_t unit, uint8_t fc, uint16_t start, uint16_t count) {
+    Frame f;
+    f.push_back(unit);
+    f.push_back(fc);
+    pushU16(f, start);
+    pushU16(f, count);
+    appendCrc(f);
+    return f;
+}
+
+// FC06
+inline Frame writeSingleRequest(uint8_t unit, uint16_t addr, uint16_t value) {
+    Frame f;
+    f.push_back(unit);
+    f.push_back(0x06);
+    pushU16(f, addr);
+    pushU16(f, value);
+    appendCrc(f);
+    return f;
+}
+
+// FC16
+inline Frame writeMultipleRequest(uint8_t unit, uint16_t start, const uint16_t *values, uint16_t count) {
+    Frame f;
+    f.push_back(unit);
+    f.push_back(0x10);
+    pushU16(f, start);
+    pushU16(f, count);
+    f.push_back(count * 2);
+    for (uint16_t i = 0; i < count; i++) {
+        pushU16(f, values[i]);
+    }
+    appendCrc(f);
+    return f;
+}
+
+// Yanıt isteğe uyuyor mu (istisna yanıtları geçersiz sayılır)
+inline bool replyMatches(const Frame &req, const Frame &reply) {
+    if (!crcOk(reply) || reply[0] != req[0] || reply[1] != req[1]) {
+        return false;
+    }
+    switch (req[1]) {
+        case 0x03:
+        case 0x04:
+            return reply.size() == 5u + frameU16(req, 4) * 2 && reply[2] == frameU16(req, 4) * 2;
+        case 0x06:
+            return reply == req;
+        case 0x10:
+            return reply.size() == 8 && frameU16(reply, 2) == frameU16(req, 2) &&
+                   frameU16(reply, 4) == frameU16(req, 4);
+        default:
+            return true;
+    }
+}
+
+#endif
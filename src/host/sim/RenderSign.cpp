@@ -0,0 +1,218 @@
+#include "RenderSign.h"
+
+#include <string.h>
+
+#include <chrono>
+
+#include "HostFont5x7.h"
+#include "TextFormat.h"
+#include "TextRenderer.h"
+
+// src/main.cpp ile aynı yerleşim
+static const int TEXT_POS_X = 2;
+static const int TEXT_POS_Y = 4;
+static const int ZONE_HEIGHT = 8;
+
+thread_local RenderSign *RenderSign::drawing = nullptr;
+
+RenderSign::RenderSign(SimBus &bus, uint8_t unitId, uint32_t pollUs)
+    : SimSign(bus, unitId, pollUs), lastPrice(0), shownMode(-1) {
+    panel.selectFont(HostFont5x7);
+    board.selectFont(HostFont5x7);
+    memset(boardSeen, 0, sizeof(boardSeen));
+    priceHistory.place(0, ZONE_HEIGHT, panel.width(), ZONE_HEIGHT);
+    timeBar.place(0, ZONE_HEIGHT + 1, panel.width(), ZONE_HEIGHT - 2);
+}
+
+void RenderSign::applied(uint8_t bank, uint32_t actions, uint64_t nowUs) {
+    int mode = registers().value(0);
+    // Fiyat geçmişi her modda tutulur
+    if (bank == 0 && fixedPrice(registers()) != lastPrice) {
+        lastPrice = fixedPrice(registers());
+        priceHistory.push(lastPrice);
+    }
+    if (bank > 0) {
+        // Bölge yazmaları sadece bölge modunda ekrana çıkar; efekt yazmak
+        // bölgeyi yeniden çizmez
+        if (mode != MODE_ZONES || !(actions & (1UL << ACT_DISPLAY))) {
+            return;
+        }
+    } else {
+        // Pano girdileri her modda işaretlenir, kareler panoda çizilir.
+        // Panoya girerken ilk gösterilebilir girdiden başlanır.
+        markBoard(actions);
+        if (mode == MODE_BOARD && shownMode != MODE_BOARD) {
+            board.restart();
+            board.update(nowUs / 1000);
+        }
+        shownMode = mode;
+
+        uint32_t drawn = (1UL << ACT_DISPLAY) | (1UL << ACT_TEXTS) | (1UL << ACT_PRICE) |
+                         (1UL << ACT_PRICE_FORMAT) | (1UL << ACT_TIME);
+        if (mode == MODE_BOARD) {
+            drawn |= 1UL << ACT_BOARD;
+        }
+        if (!(actions & drawn) || mode == MODE_PROGRAM || mode == MODE_FEED) {
+            return;
+        }
+    }
+
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    if (bank > 0) {
+        renderZone(bank - 1);
+    } else {
+        renderMode();
+    }
+    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+
+    Sample s;
+    s.atUs = nowUs;
+    s.waitUs = slave().queueStats(RtuSlave::CLASS_WRITE).lastDelayUs;
+    s.drawNs = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+    renders.push_back(s);
+}
+
+void RenderSign::renderMode() {
+    char text[TEXT_SLOT_REGS * 2 + 1];
+    switch (registers().value(0)) {
+        case 1:  // kayan yazı: şerit ve ilk kare
+            slotText(0, text, sizeof(text));
+            marquee.start(panel, text, registers().value(4));
+            renderMarquee(panel, marquee, TEXT_POS_Y);
+            break;
+        case 2:
+            formatFixed(text, sizeof(text), fixedPrice(registers()), priceFormat(registers()), " TL");
+            if (registers().value(REG_PRICE_GRAPH) == PRICE_GRAPH_OFF) {
+                renderText(panel, TEXT_POS_X, TEXT_POS_Y, text);
+            } else {
+                // Fiyat üst bantta, geçmiş alt bantta; her yazmada tamamı
+                // çizilir (cihazdaki kaydırmalı güncelleme yapılmaz)
+                renderText(panel, TEXT_POS_X, 0, text);
+                priceHistory.setFilled(registers().value(REG_PRICE_GRAPH) == PRICE_GRAPH_BARS);
+                priceHistory.draw(panel);
+            }
+            break;
+        case 3:
+            formatInt(text, sizeof(text), registers().value(3), " sn");
+            if (registers().value(REG_TIME_TOTAL) == 0) {
+                renderText(panel, TEXT_POS_X, TEXT_POS_Y, text);
+            } else {
+                // Geri sayımın ilk karesi (sanal tabelada saat ilerlemez)
+                renderText(panel, TEXT_POS_X, 0, text);
+                timeBar.setTotal(registers().value(REG_TIME_TOTAL));
+                timeBar.draw(panel, registers().value(3) > 0 ? registers().value(3) : 0);
+            }
+            break;
+        case MODE_ZONES:
+            for (uint8_t z = 0; z < ZONE_COUNT; z++) {
+                renderZone(z);
+            }
+            break;
+        case MODE_BOARD:
+            drawing = this;
+            board.refresh(drawBoardEntry);
+            drawing = nullptr;
+            board.show(panel);
+            break;
+        default:
+            panel.clearScreen();
+            break;
+    }
+}
+
+// Değişen girdiler (src/main.cpp yazılan girdileri işaretler; burada yazma
+// aralığı bilinmediği için değerler karşılaştırılır)
+void RenderSign::markBoard(uint32_t actions) {
+    const uint16_t *table = registers().holding + REG_BOARD_BASE;
+    for (uint8_t i = 0; i < BOARD_ENTRIES; i++) {
+        const uint16_t *e = table + i * BOARD_ENTRY_REGS;
+        uint16_t *seen = boardSeen + i * BOARD_ENTRY_REGS;
+        bool changed = memcmp(e, seen, sizeof(uint16_t) * BOARD_ENTRY_REGS) != 0;
+        // Biçim ve yazı slotları (ad olarak) girdinin karesini bozar
+        if (actions & (1UL << ACT_PRICE_FORMAT)) {
+            changed = true;
+        }
+        if ((actions & (1UL << ACT_TEXTS)) && e[BOARD_NAME] >= PRODUCT_NAME_SLOT) {
+            changed = true;
+        }
+        if (changed) {
+            memcpy(seen, e, sizeof(uint16_t) * BOARD_ENTRY_REGS);
+            board.setDwell(i, e[BOARD_DWELL] * 1000UL);
+            board.invalidate(i);
+        }
+    }
+}
+
+// src/main.cpp renderBoardEntry() ile aynı yerleşim
+void RenderSign::drawBoardEntry(uint8_t i, PanelFrame<P10Single> &frame) {
+    RenderSign *self = drawing;
+    const uint16_t *e = self->registers().holding + REG_BOARD_BASE + i * BOARD_ENTRY_REGS;
+    char text[TEXT_SLOT_REGS * 2 + 1];
+    frame.clearScreen();
+
+    uint16_t id = e[BOARD_NAME];
+    if (id >= PRODUCT_NAME_SLOT && id < PRODUCT_NAME_SLOT + TEXT_SLOTS) {
+        self->slotText(id - PRODUCT_NAME_SLOT, text, sizeof(text));
+    } else {
+        strcpy(text, id < sizeof(PRODUCT_NAMES) / sizeof(PRODUCT_NAMES[0]) ? PRODUCT_NAMES[id] : "");
+    }
+    int x = (frame.width() - frame.stringWidth(text)) / 2;
+    frame.drawString(x < 0 ? 0 : x, 0, text);
+
+    uint16_t unit = e[BOARD_UNIT];
+    const char *suffix = unit < sizeof(PRODUCT_UNITS) / sizeof(PRODUCT_UNITS[0]) ? PRODUCT_UNITS[unit] : "";
+    FixedFormat format = priceFormat(self->registers());
+    formatFixed(text, sizeof(text), boardPrice(e), format, suffix);
+    if (frame.stringWidth(text) > frame.width()) {
+        formatFixed(text, sizeof(text), boardPrice(e), format);
+    }
+    x = (frame.width() - frame.stringWidth(text)) / 2;
+    frame.drawString(x < 0 ? 0 : x, ZONE_HEIGHT, text);
+}
+
+void RenderSign::renderZone(uint8_t zone) {
+    const uint16_t *zr = zoneRegisters(zone);
+    char text[ZONE_TEXT_REGS * 2 + 1];
+    switch (zr[ZREG_CONTENT]) {
+        case 1:
+        case ZONE_CONTENT_SCROLL: {
+            uint8_t n = 0;
+            for (uint8_t i = 0; i < ZONE_TEXT_REGS; i++) {
+                text[n++] = zr[ZREG_TEXT + i] >> 8;
+                text[n++] = zr[ZREG_TEXT + i] & 0xFF;
+            }
+            text[n] = '\0';
+            break;
+        }
+        case 2:
+            formatInt(text, sizeof(text), (int16_t)zr[ZREG_VALUE], " TL");
+            break;
+        case 3:
+            formatInt(text, sizeof(text), (int16_t)zr[ZREG_VALUE], " sn");
+            break;
+        default:
+            text[0] = '\0';
+            break;
+    }
+
+    int y = zone * ZONE_HEIGHT;
+    if (zr[ZREG_CONTENT] == ZONE_CONTENT_SCROLL) {
+        // Şerit ve ilk kare; adımlar çizim süresine dahil değil
+        zoneMarquees[zone].start(panel, text, registers().value(4));
+        zoneMarquees[zone].draw(panel, 0, y, panel.width());
+        return;
+    }
+    panel.clearRect(0, y, panel.width(), ZONE_HEIGHT);
+    int x = (panel.width() - panel.stringWidth(text)) / 2;
+    panel.drawString(x < 0 ? 0 : x, y, text);
+}
+
+void RenderSign::slotText(uint8_t slot, char *text, size_t size) {
+    const uint16_t *words = registers().holding + REG_TEXT_BASE + slot * TEXT_SLOT_REGS;
+    size_t n = 0;
+    for (uint8_t i = 0; i < TEXT_SLOT_REGS && n + 2 < size; i++) {
+        text[n++] = words[i] >> 8;
+        text[n++] = words[i] & 0xFF;
+    }
+    text[n] = '\0';
+}
@@ -0,0 +1,70 @@
+/*
+ * Ekranı da çizen sanal tabela.
+ *
+ * Uygulanan her yazmada src/main.cpp'nin çizim yolunu (mod, fiyat, zaman,
+ * sabit yazı, bölgeler) bir PanelFrame üzerinde tekrarlar ve tepki
+ * süresini iki parçada ölçer:
+ *   bekleme  çerçevenin bitişinden işlenmesine kadar (RtuSlave sıra
+ *            gecikmesi, sanal zaman)
+ *   çizim    çizimin host'taki gerçek süresi (cihaz süresi değildir; sürümler
+ *            ve trafik desenleri arası karşılaştırma içindir)
+ * Fiyat panosunda değişen girdilerin kareleri çizilir ve ilk gösterilebilir
+ * girdi gösterilir (sanal tabelada saat ilerlemez, girdiler dönmez).
+ * Program modu (DisplayVm) ve haber bandı çalıştırılmaz; bu modlardaki
+ * yazmalar çizim saymaz.
+ */
+
+#ifndef RENDER_SIGN_H
+#define RENDER_SIGN_H
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "Marquee.h"
+#include "PanelFrame.h"
+#include "PanelGeometry.h"
+#include "ProgressBar.h"
+#include "SimSign.h"
+#include "SlideDeck.h"
+#include "Sparkline.h"
+
+class RenderSign : public SimSign {
+public:
+    struct Sample {
+        uint64_t atUs;    // sanal zaman
+        uint32_t waitUs;  // sanal
+        uint32_t drawNs;  // host
+    };
+
+    RenderSign(SimBus &bus, uint8_t unitId, uint32_t pollUs);
+
+    const std::vector<Sample> &samples() const { return renders; }
+    const PanelFrame<P10Single> &frame() const { return panel; }
+
+protected:
+    void applied(uint8_t bank, uint32_t actions, uint64_t nowUs) override;
+
+private:
+    PanelFrame<P10Single> panel;
+    Marquee<256, 8> marquee;  // src/main.cpp'deki şerit boyutları
+    Marquee<160, 8> zoneMarquees[ZONE_COUNT];
+    Sparkline<PRICE_HISTORY> priceHistory;
+    int32_t lastPrice;
+    ProgressBar timeBar;
+    SlideDeck<PanelFrame<P10Single>, BOARD_ENTRIES> board;
+    uint16_t boardSeen[BOARD_ENTRIES * BOARD_ENTRY_REGS];
+    int shownMode;
+    std::vector<Sample> renders;
+
+    // SlideDeck'in çizim kancası bağlam taşımaz; çizen tabela iş parçacığı başına
+    static thread_local RenderSign *drawing;
+    static void drawBoardEntry(uint8_t i, PanelFrame<P10Single> &frame);
+
+    void markBoard(uint32_t actions);
+    void renderMode();
+    void renderZone(uint8_t zone);
+    void slotText(uint8_t slot, char *text, size_t size);
+};
+
+#endif
@@ -0,0 +1,102 @@
+#include "SimBus.h"
+
+#include <algorithm>
+
+SimBus::SimBus(uint32_t baud)
+    : byteTimeUs(10000000UL / baud), stagedMode(false), lastBusyEndUs(0), busyTotalUs(0),
+      collisionCount(0), byteCount(0) {}
+
+int SimBus::attach(BusNode *node) {
+    if (nodes.size() >= MAX_NODES) {
+        return -1;
+    }
+    nodes.push_back(node);
+    return nodes.size() - 1;
+}
+
+uint64_t SimBus::transmit(int driver, uint64_t startUs, const uint8_t *data, size_t len) {
+    if (stagedMode) {
+        std::lock_guard<std::mutex> lock(stageLock);
+        Staged t = { driver, startUs, std::vector<uint8_t>(data, data + len) };
+        staged.push_back(t);
+        return startUs + len * byteTimeUs;
+    }
+    drive(driver, startUs, data, len);
+    return startUs + len * byteTimeUs;
+}
+
+void SimBus::commitStaged() {
+    std::sort(staged.begin(), staged.end(), [](const Staged &a, const Staged &b) {
+        return a.startUs != b.startUs ? a.startUs < b.startUs : a.driver < b.driver;
+    });
+    for (const Staged &t : staged) {
+        drive(t.driver, t.startUs, t.data.data(), t.data.size());
+    }
+    staged.clear();
+}
+
+void SimBus::drive(int driver, uint64_t startUs, const uint8_t *data, size_t len) {
+    uint64_t endUs = startUs;
+    for (size_t i = 0; i < len; i++) {
+        endUs += byteTimeUs;
+
+        // Başka sürücünün zamanda örtüşen baytı varsa ikisi tek bozuk bayt olur
+        bool merged = false;
+        for (Slot &s : pending) {
+            uint64_t d = s.endUs > endUs ? s.endUs - endUs : endUs - s.endUs;
+            if (d < byteTimeUs && !(s.drivers & (1ULL << driver))) {
+                s.value &= data[i];
+                s.drivers |= 1ULL << driver;
+                if (!s.collided) {
+                    s.collided = true;
+                    collisionCount++;
+                }
+                merged = true;
+                break;
+            }
+        }
+        if (merged) {
+            continue;
+        }
+
+        Slot slot = { endUs, 1ULL << driver, data[i], false };
+        auto it = pending.end();
+        while (it != pending.begin() && (it - 1)->endUs > endUs) {
+            --it;
+        }
+        pending.insert(it, slot);
+    }
+}
+
+void SimBus::deliverUntil(uint64_t nowUs) {
+    while (!pending.empty() && pending.front().endUs <= nowUs) {
+        Slot s = pending.front();
+        pending.pop_front();
+
+        // Hat meşguliyeti: bayt aralıklarının birleşimi
+        uint64_t startUs = s.endUs - byteTimeUs;
+        if (startUs < lastBusyEndUs) {
+            startUs = lastBusyEndUs;
+        }
+        if (s.endUs > startUs) {
+            busyTotalUs += s.endUs - startUs;
+            lastBusyEndUs = s.endUs;
+        }
+        byteCount++;
+
+        for (size_t n = 0; n < nodes.size(); n++) {
+            if (!(s.drivers & (1ULL << n))) {
+                nodes[n]->busByte(s.value, s.endUs, s.collided);
+            }
+        }
+    }
+}
+
+bool SimBus::busy(uint64_t nowUs) const {
+    for (const Slot &s : pending) {
+        if (s.endUs - byteTimeUs <= nowUs) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,92 @@
+/*
+ * Sanal RS485 çok noktalı hat (sanal zaman, mikrosaniye).
+ *
+ * Her sürücü (master, tabelalar, hata üreticiler) baytlarını transmit() ile
+ * hatta koyar; bayt 10 bit sürer (8N1). Aynı anda sürülen iki bayt
+ * çakışır: dinleyenler bozuk tek bir bayt görür (bitsel AND). Baytlar
+ * bitiş zamanı sırasıyla, gönderenler hariç tüm düğümlere iletilir.
+ *
+ * Düğümler ayrı iş parçacıklarında çalıştırılacaksa hat "bekletmeli" moda
+ * alınır: transmit() baytları sadece kuyruğa ekler, commitStaged() onları
+ * (başlangıç, sürücü) sırasıyla hatta koyar. Böylece sonuç iş parçacığı
+ * sayısına ve zamanlamasına bağlı değildir. Bir dilimde gönderilen bayt en
+ * erken bir bayt süresi sonra biteceğinden dilimler byteUs()'u aşmamalıdır.
+ */
+
+#ifndef SIM_BUS_H
+#define SIM_BUS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <mutex>
+#include <vector>
+
+class BusNode {
+public:
+    virtual ~BusNode() {}
+
+    // Hattan bir bayt (endUs: stop bitinin bittiği an)
+    virtual void busByte(uint8_t value, uint64_t endUs, bool collided) = 0;
+};
+
+class SimBus {
+public:
+    static const int MAX_NODES = 64;
+
+    explicit SimBus(uint32_t baud);
+
+    // Düğümü bağla; sürücü numarasını döndürür
+    int attach(BusNode *node);
+
+    uint32_t byteUs() const { return byteTimeUs; }
+
+    // Baytları 'startUs'tan itibaren arka arkaya sür; son baytın bitişi
+    uint64_t transmit(int driver, uint64_t startUs, const uint8_t *data, size_t len);
+
+    // Bekletmeli mod; kapatmadan önce commitStaged() çağrılmalı
+    void setStaged(bool on) { stagedMode = on; }
+    void commitStaged();
+
+    // Bitişi 'nowUs'a kadar olan baytları ilet
+    void deliverUntil(uint64_t nowUs);
+
+    // 'nowUs' anında hatta bayt var mı (iletilmemiş ve başlamış)
+    bool busy(uint64_t nowUs) const;
+
+    uint64_t busyUs() const { return busyTotalUs; }
+    uint32_t collisions() const { return collisionCount; }
+    uint32_t bytes() const { return byteCount; }
+
+private:
+    struct Slot {
+        uint64_t endUs;
+        uint64_t drivers;  // bit n = sürücü n
+        uint8_t value;
+        bool collided;
+    };
+
+    struct Staged {
+        int driver;
+        uint64_t startUs;
+        std::vector<uint8_t> data;
+    };
+
+    uint32_t byteTimeUs;
+    std::vector<BusNode *> nodes;
+    std::deque<Slot> pending;  // endUs sıralı
+
+    bool stagedMode;
+    std::mutex stageLock;
+    std::vector<Staged> staged;
+
+    void drive(int driver, uint64_t startUs, const uint8_t *data, size_t len);
+
+    uint64_t lastBusyEndUs;
+    uint64_t busyTotalUs;
+    uint32_t collisionCount;
+    uint32_t byteCount;
+};
+
+#endif
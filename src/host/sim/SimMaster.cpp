@@ -0,0 +1,41 @@
+#include "SimMaster.h"
+
+SimMaster::SimMaster(SimBus &bus, uint32_t baud)
+    : bus(bus), driver(bus.attach(this)), t35Us(baud > 19200 ? 1750 : 38500000UL / baud),
+      lastUs(0) {}
+
+uint64_t SimMaster::send(uint64_t startUs, const Frame &frame) {
+    return bus.transmit(driver, startUs, frame.data(), frame.size());
+}
+
+void SimMaster::busByte(uint8_t value, uint64_t endUs, bool collided) {
+    if (!open.empty() && endUs - lastUs >= t35Us) {
+        closeOpen();
+    }
+    open.push_back(value);
+    lastUs = endUs;
+}
+
+bool SimMaster::takeFrame(uint64_t nowUs, Frame &frame, uint64_t &endUs) {
+    if (!open.empty() && nowUs - lastUs >= t35Us) {
+        closeOpen();
+    }
+    if (frames.empty()) {
+        return false;
+    }
+    frame = frames.front().frame;
+    endUs = frames.front().endUs;
+    frames.pop_front();
+    return true;
+}
+
+void SimMaster::flush() {
+    open.clear();
+    frames.clear();
+}
+
+void SimMaster::closeOpen() {
+    Received r = { open, lastUs };
+    frames.push_back(r);
+    open.clear();
+}
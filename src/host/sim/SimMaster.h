@@ -0,0 +1,52 @@
+/*
+ * Sanal hattaki Modbus master.
+ *
+ * İstekleri hatta koyar; hattan duyduğu baytları slave ile aynı kuralla
+ * (3.5 karakter sessizlik) çerçevelere ayırır.
+ */
+
+#ifndef SIM_MASTER_H
+#define SIM_MASTER_H
+
+#include <stdint.h>
+
+#include <deque>
+
+#include "ModbusFrames.h"
+#include "SimBus.h"
+
+class SimMaster : public BusNode {
+public:
+    SimMaster(SimBus &bus, uint32_t baud);
+
+    // İsteği 'startUs'ta göndermeye başla; son baytın bitişini döndürür
+    uint64_t send(uint64_t startUs, const Frame &frame);
+
+    void busByte(uint8_t value, uint64_t endUs, bool collided) override;
+
+    // Sessizliği dolmuş sıradaki çerçeve; yoksa false
+    bool takeFrame(uint64_t nowUs, Frame &frame, uint64_t &endUs);
+
+    // Bekleyen ve yarım çerçeveleri at
+    void flush();
+
+    uint32_t silenceUs() const { return t35Us; }
+
+private:
+    struct Received {
+        Frame frame;
+        uint64_t endUs;
+    };
+
+    SimBus &bus;
+    int driver;
+    uint32_t t35Us;
+
+    Frame open;
+    uint64_t lastUs;
+    std::deque<Received> frames;
+
+    void closeOpen();
+};
+
+#endif
@@ -0,0 +1,71 @@
+#include "SimSign.h"
+
+#include <string.h>
+
+thread_local SimSign *SimSign::current = nullptr;
+
+SimSign::SimSign(SimBus &bus, uint8_t unitId, uint32_t pollUs, uint32_t baud)
+    : bus(bus), driver(bus.attach(this)), unit(unitId), pollUs(pollUs), pollAt(0), nowUs(0),
+      txStartUs(0), txEndUs(0),
+      mb(*this, regs.holding, SignRegisters::HOLDING_COUNT, regs.input, SignRegisters::INPUT_COUNT),
+      responseCount(0), droppedCount(0) {
+    regs.reset();
+    mb.begin(unitId, baud);
+    for (uint8_t z = 0; z < ZONE_COUNT; z++) {
+        zones[z].reset();
+        mb.addBank(unitId + 1 + z, zones[z].holding, ZONE_REG_COUNT, nullptr, 0);
+    }
+    mb.onWrite(written);
+    mb.setResponseLimit(regs.holding[REG_RESPONSE_LIMIT] * 1000UL);
+}
+
+void SimSign::busByte(uint8_t value, uint64_t endUs, bool collided) {
+    // DE yüksekken alıcı kapalı
+    if (endUs > txStartUs && endUs - bus.byteUs() < txEndUs) {
+        droppedCount++;
+        return;
+    }
+    RxByte b = { value, endUs };
+    rx.push_back(b);
+}
+
+void SimSign::send(const uint8_t *data, uint16_t len) {
+    uint64_t startUs = nowUs > txEndUs ? nowUs : txEndUs;
+    txStartUs = startUs;
+    txEndUs = bus.transmit(driver, startUs, data, len);
+    responseCount++;
+}
+
+void SimSign::runUntil(uint64_t untilUs) {
+    while (pollAt <= untilUs) {
+        nowUs = pollAt;
+        while (!rx.empty() && rx.front().endUs <= nowUs) {
+            mb.receive(rx.front().value, (uint32_t)rx.front().endUs);
+            rx.pop_front();
+        }
+        current = this;
+        mb.task((uint32_t)nowUs);
+        current = nullptr;
+
+        // Gönderim döngüyü bloke etmez (Rs485Port UART FIFO'sundan gönderir)
+        pollAt = nowUs + pollUs;
+    }
+}
+
+void SimSign::written(uint8_t bank, uint16_t start, uint16_t count) {
+    SimSign *self = current;
+    uint32_t actions = bank == 0 ? self->regs.applyWrite(start, count)
+                                 : self->zones[bank - 1].applyWrite(start, count);
+    // HR2 -> HR208-209 aktarımı (src/main.cpp onRegistersWritten)
+    if (actions & (1UL << ACT_PRICE)) {
+        uint32_t price = legacyPrice(self->regs);
+        self->regs.holding[REG_PRICE_VALUE] = price >> 16;
+        self->regs.holding[REG_PRICE_VALUE + 1] = price & 0xFFFF;
+        self->mb.holdingChanged(REG_PRICE_VALUE, 2);
+    }
+    // HR176 yanıt sınırı (src/main.cpp onRegistersWritten)
+    if (actions & (1UL << ACT_RESPONSE_LIMIT)) {
+        self->mb.setResponseLimit(self->regs.holding[REG_RESPONSE_LIMIT] * 1000UL);
+    }
+    self->applied(bank, actions, self->nowUs);
+}
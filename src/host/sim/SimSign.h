@@ -0,0 +1,88 @@
+/*
+ * Sanal hatta bağlı tek bir tabela.
+ *
+ * src/main.cpp'deki Modbus yolunun aynısıdır: aynı RtuSlave, aynı register
+ * haritası (SignRegisters.h) ve bölge bankaları. Ana döngü 'pollUs'
+ * aralıklarla döner (cihazda modbusTaskFn + delay(10)); hattan gelen
+ * baytlar Rs485Port gibi geliş zamanlarıyla verilir. Gönderim sırasında
+ * alıcı kapalıdır (yarı çift yönlü).
+ */
+
+#ifndef SIM_SIGN_H
+#define SIM_SIGN_H
+
+#include <stdint.h>
+
+#include <deque>
+
+#include "RtuSlave.h"
+#include "SignRegisters.h"
+#include "SimBus.h"
+
+class SimSign : public BusNode, public RtuTransport {
+public:
+    SimSign(SimBus &bus, uint8_t unitId, uint32_t pollUs, uint32_t baud = MODBUS_BAUD);
+    virtual ~SimSign() {}
+
+    void busByte(uint8_t value, uint64_t endUs, bool collided) override;
+    void send(const uint8_t *data, uint16_t len) override;
+
+    // 'nowUs'a kadar olan ana döngü turlarını çalıştır
+    void runUntil(uint64_t nowUs);
+
+    // İlk döngü turunun zamanı (tabelalar arası faz farkı için)
+    void setPhase(uint64_t firstPollUs) { pollAt = firstPollUs; }
+
+    uint8_t unitId() const { return unit; }
+    const RtuSlave &slave() const { return mb; }
+    SignRegisters &registers() { return regs; }
+    const uint16_t *zoneRegisters(uint8_t zone) const { return zones[zone].holding; }
+
+    // Hatta görülen / gönderilen çerçeveleri kaydet (nullptr = kapalı)
+    void setRecorder(TrafficSink *sink) { mb.setRecorder(sink); }
+
+    // FC20/21 dosya kayıtları (nullptr = desteklenmez)
+    void setFileStore(FileRecordStore *store) { mb.setFileStore(store); }
+
+    // İşlenen döngü turu 'us' kadar uzar (ör. flash silme); yanıt ve
+    // sonraki tur o kadar gecikir
+    void stall(uint32_t us) { nowUs += us; }
+
+    uint32_t responses() const { return responseCount; }
+    uint32_t droppedWhileSending() const { return droppedCount; }
+
+protected:
+    // Yazma uygulandı (bankanın tablosundaki eylem bitleri); ekran tepkisi için kanca
+    virtual void applied(uint8_t bank, uint32_t actions, uint64_t nowUs) {}
+
+    uint64_t loopUs() const { return nowUs; }
+
+private:
+    struct RxByte {
+        uint8_t value;
+        uint64_t endUs;
+    };
+
+    SimBus &bus;
+    int driver;
+    uint8_t unit;
+    uint32_t pollUs;
+    uint64_t pollAt;
+    uint64_t nowUs;
+    uint64_t txStartUs;
+    uint64_t txEndUs;
+
+    SignRegisters regs;
+    ZoneRegisters zones[ZONE_COUNT];
+    RtuSlave mb;
+    std::deque<RxByte> rx;
+
+    uint32_t responseCount;
+    uint32_t droppedCount;
+
+    // RtuSlave yazma kancası bağlam taşımaz; işlenen tabela iş parçacığı başına tutulur
+    static thread_local SimSign *current;
+    static void written(uint8_t bank, uint16_t start, uint16_t count);
+};
+
+#endif
@@ -0,0 +1,66 @@
+#include "TrafficFile.h"
+
+#include <string.h>
+
+bool TrafficFileWriter::open(const char *path) {
+    close();
+    file = fopen(path, "wb");
+    if (!file) {
+        return false;
+    }
+    fwrite(TRAFFIC_MAGIC, 1, sizeof(TRAFFIC_MAGIC), file);
+    return true;
+}
+
+void TrafficFileWriter::close() {
+    if (file) {
+        fclose(file);
+        file = nullptr;
+    }
+}
+
+void TrafficFileWriter::record(uint8_t dir, uint32_t stampUs, const uint8_t *data, uint16_t len) {
+    if (!file) {
+        return;
+    }
+    uint8_t header[TRAFFIC_HEADER_BYTES] = {
+        (uint8_t)stampUs, (uint8_t)(stampUs >> 8), (uint8_t)(stampUs >> 16), (uint8_t)(stampUs >> 24),
+        dir, (uint8_t)len, (uint8_t)(len >> 8)
+    };
+    fwrite(header, 1, sizeof(header), file);
+    fwrite(data, 1, len, file);
+}
+
+bool loadTraffic(const char *path, std::vector<TrafficRecord> &records) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        return false;
+    }
+    uint8_t magic[sizeof(TRAFFIC_MAGIC)];
+    bool ok = fread(magic, 1, sizeof(magic), f) == sizeof(magic) &&
+              memcmp(magic, TRAFFIC_MAGIC, sizeof(magic)) == 0;
+
+    uint8_t header[TRAFFIC_HEADER_BYTES];
+    while (ok) {
+        size_t n = fread(header, 1, sizeof(header), f);
+        if (n == 0) {
+            break;
+        }
+        if (n != sizeof(header)) {
+            ok = false;
+            break;
+        }
+        TrafficRecord r;
+        r.stampUs = header[0] | ((uint32_t)header[1] << 8) | ((uint32_t)header[2] << 16) |
+                    ((uint32_t)header[3] << 24);
+        r.dir = header[4];
+        r.data.resize(header[5] | (header[6] << 8));
+        if (fread(r.data.data(), 1, r.data.size(), f) != r.data.size()) {
+            ok = false;
+            break;
+        }
+        records.push_back(r);
+    }
+    fclose(f);
+    return ok;
+}
@@ -0,0 +1,43 @@
+/*
+ * Trafik kaydı dosyaları (host).
+ *
+ * Biçim cihazdaki TrafficRecorder ile aynıdır (bkz. TrafficRecorder.h);
+ * cihazdan FC20 ile indirilen kayıt olduğu gibi dosyaya yazılabilir.
+ */
+
+#ifndef TRAFFIC_FILE_H
+#define TRAFFIC_FILE_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <vector>
+
+#include "ModbusFrames.h"
+#include "TrafficRecorder.h"
+
+struct TrafficRecord {
+    uint32_t stampUs;
+    uint8_t dir;
+    Frame data;
+};
+
+// Kayıtları doğrudan dosyaya yazar (native derlemede kayıt modu)
+class TrafficFileWriter : public TrafficSink {
+public:
+    TrafficFileWriter() : file(nullptr) {}
+    ~TrafficFileWriter() { close(); }
+
+    bool open(const char *path);
+    void close();
+
+    void record(uint8_t dir, uint32_t stampUs, const uint8_t *data, uint16_t len) override;
+
+private:
+    FILE *file;
+};
+
+// Dosyanın tamamını oku; başlık yanlışsa ya da son kayıt yarımsa false
+bool loadTraffic(const char *path, std::vector<TrafficRecord> &records);
+
+#endif
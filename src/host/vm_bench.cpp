@@ -0,0 +1,208 @@
+/*
+ * DisplayVm komut dağıtım maliyeti ölçümü.
+ *
+ * Aynı program iki yorumlayıcıyla çalıştırılır; komut başına süre (en iyi
+ * tur) yazdırılır:
+ *   switch    her adımda kelimeden opcode çözülür, switch ile dağıtılır,
+ *             operandlar ve atlama hedefi okunurken sınırlar kontrol edilir
+ *             (DisplayVm'in load() öncesi tasarımı)
+ *   handler   DisplayVm: load() komutları handler işaretçisi + çözülmüş
+ *             operandlara çevirir, run() sadece çağırır
+ *
+ * Programlarda WAIT yoktur; her run() STEP_BUDGET komut çalıştırır. Host
+ * çağrıları sadece sayaç artırır, ölçülen çoğunlukla dağıtım maliyetidir.
+ *
+ * Kullanım:
+ *   program [--runs N] [--rounds R]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+
+#include "DisplayVm.h"
+
+static const uint8_t TEXT_SLOTS = 4;
+static const uint8_t REGISTERS = 8;
+
+struct Options {
+    uint32_t runs = 200000;
+    int rounds = 5;
+};
+
+class CountingHost : public DisplayVmHost {
+public:
+    uint32_t calls = 0;
+    uint16_t regs[REGISTERS] = { 0 };
+
+    void vmShowText(uint8_t slot) override { calls += slot + 1; }
+    void vmScrollText(uint8_t slot, uint16_t speedMs) override { calls += slot + speedMs; }
+    void vmShowMode(uint8_t mode) override { calls += mode; }
+    void vmSetBrightness(uint8_t level) override { calls += level; }
+    uint16_t vmReadRegister(uint8_t reg) override { return regs[reg]; }
+};
+
+// Kelimeler üzerinde doğrudan çalışan switch yorumlayıcı
+class SwitchVm {
+public:
+    SwitchVm(DisplayVmHost &host, const uint16_t *words, uint8_t count)
+        : host(host), words(words), count(count), pc(0) {}
+
+    // DisplayVm::run() gibi ayrı derlenmiş sayılsın: host çağrıları sanal
+    // kalır (GCC, CountingHost'u görünce çağrıları tahminen açıyor)
+    __attribute__((noinline, optimize("no-devirtualize-speculatively"))) void run() {
+        for (uint8_t steps = 0; steps < DisplayVm::STEP_BUDGET && pc < count; steps++) {
+            uint16_t w = words[pc];
+            uint8_t a = w & 0xFF;
+            switch (w >> 8) {
+                case DisplayVm::OP_HALT:
+                    pc = count;
+                    break;
+                case DisplayVm::OP_SHOW:
+                    if (a < TEXT_SLOTS) {
+                        host.vmShowText(a);
+                    }
+                    pc += 1;
+                    break;
+                case DisplayVm::OP_SCROLL:
+                    if (a < TEXT_SLOTS && pc + 1 < count) {
+                        host.vmScrollText(a, words[pc + 1]);
+                    }
+                    pc += 2;
+                    break;
+                case DisplayVm::OP_WAIT:
+                    pc += 2;
+                    return;
+                case DisplayVm::OP_BREQ:
+                case DisplayVm::OP_BRNE:
+                    if (a >= REGISTERS || pc + 2 >= count) {
+                        pc = count;
+                        break;
+                    }
+                    if ((host.vmReadRegister(a) == words[pc + 1]) == ((w >> 8) == DisplayVm::OP_BREQ)) {
+                        pc = words[pc + 2] < count ? words[pc + 2] : count;
+                    } else {
+                        pc += 3;
+                    }
+                    break;
+                case DisplayVm::OP_JUMP:
+                    pc = pc + 1 < count && words[pc + 1] < count ? words[pc + 1] : count;
+                    break;
+                case DisplayVm::OP_BRIGHT:
+                    host.vmSetBrightness(a);
+                    pc += 1;
+                    break;
+                case DisplayVm::OP_MODE:
+                    if (a <= 3) {
+                        host.vmShowMode(a);
+                    }
+                    pc += 1;
+                    break;
+                default:
+                    pc = count;
+                    break;
+            }
+        }
+    }
+
+private:
+    DisplayVmHost &host;
+    const uint16_t *words;
+    uint8_t count;
+    uint8_t pc;
+};
+
+#define OP(op, a) (uint16_t)(((DisplayVm::op) << 8) | (a))
+
+// Karışık komutlar, sonsuz döngü
+static const uint16_t MIX[] = {
+    OP(OP_SHOW, 0),
+    OP(OP_BRIGHT, 200),
+    OP(OP_BREQ, 0), 5, 0,  // r0 = 0, atlamaz
+    OP(OP_BRNE, 1), 0, 0,  // r1 = 0, atlamaz
+    OP(OP_SCROLL, 1), 80,
+    OP(OP_MODE, 2),
+    OP(OP_JUMP, 0), 0,
+};
+
+// Sadece atlama: host çağrısı yok, saf dağıtım
+static const uint16_t JUMPS[] = {
+    OP(OP_JUMP, 0), 2,
+    OP(OP_JUMP, 0), 4,
+    OP(OP_JUMP, 0), 0,
+};
+
+// Sonuçlar kullanılmazsa derleyici döngüyü atabilir
+static volatile uint32_t sink;
+
+// Komut başına ns, en iyi tur alınır (host'taki gürültüye karşı)
+template <class Fn>
+static double run(const Options &opt, Fn fn) {
+    typedef std::chrono::steady_clock Clock;
+    double best = 0;
+    for (int r = 0; r < opt.rounds; r++) {
+        Clock::time_point t0 = Clock::now();
+        for (uint32_t i = 0; i < opt.runs; i++) {
+            fn(i);
+        }
+        double ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count() /
+                    ((double)opt.runs * DisplayVm::STEP_BUDGET);
+        if (r == 0 || ns < best) {
+            best = ns;
+        }
+    }
+    return best;
+}
+
+static bool bench(const char *name, const Options &opt, const uint16_t *words, uint8_t count) {
+    CountingHost switchHost, vmHost;
+    SwitchVm sw(switchHost, words, count);
+    DisplayVm vm(vmHost, TEXT_SLOTS, REGISTERS);
+    if (vm.load(words, count) != DisplayVm::LOAD_OK) {
+        fprintf(stderr, "%s: program yuklenemedi\n", name);
+        return false;
+    }
+    double a = run(opt, [&](uint32_t) { sw.run(); });
+    double b = run(opt, [&](uint32_t i) { vm.run(i); });
+    sink = switchHost.calls + vmHost.calls;
+
+    // İki yorumlayıcı aynı host çağrılarını yapmış olmalı
+    bool same = switchHost.calls == vmHost.calls;
+    printf("%-6s %8.2f %8.2f %6.2fx  %s\n", name, a, b, a / b, same ? "ayni" : "FARKLI");
+    return same;
+}
+
+static bool parseArgs(int argc, char **argv, Options &opt) {
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!value) {
+            return false;
+        }
+        if (strcmp(arg, "--runs") == 0) {
+            opt.runs = strtoul(value, nullptr, 10);
+        } else if (strcmp(arg, "--rounds") == 0) {
+            opt.rounds = atoi(value);
+        } else {
+            return false;
+        }
+        i++;
+    }
+    return opt.runs > 0 && opt.rounds > 0;
+}
+
+int main(int argc, char **argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        fprintf(stderr, "kullanim: %s [--runs N] [--rounds R]\n", argv[0]);
+        return 2;
+    }
+    printf("%u run() x %u komut\n\n", opt.runs, DisplayVm::STEP_BUDGET);
+    printf("%-6s %8s %8s %7s  %s\n", "prog", "switch", "handler", "oran", "host");
+    bool ok = bench("mix", opt, MIX, sizeof(MIX) / sizeof(MIX[0]));
+    ok &= bench("jump", opt, JUMPS, sizeof(JUMPS) / sizeof(JUMPS[0]));
+    printf("\n(ns/komut)\n");
+    return ok ? 0 : 1;
+}
@@ -19,167 +19,1034 @@
  * ┌─────────────────────────────────────────────────────────┐
  * │ Modbus RTU    │ NodeMCU Pin │ GPIO  │ Açıklama          │
  * ├───────────────┼─────────────┼───────┼───────────────────┤
- * │ TX            │ D3          │ GPIO0 │ Modbus TX         │
- * │ RX            │ D4          │ GPIO2 │ Modbus RX         │
+ * │ TX (DI)       │ TX          │ GPIO1 │ Modbus TX (UART0) │
+ * │ RX (RO)       │ RX          │ GPIO3 │ Modbus RX (UART0) │
  * │ DE/RE         │ D8          │ GPIO15│ RS485 Direction   │
  * └─────────────────────────────────────────────────────────┘
+ * UART0 RS485'e aittir (bkz. Rs485Port.h); hata ayıklama çıktısı Serial1
+ * (D4, GPIO2, sadece TX) üzerindedir. USB'den yüklerken RO ucu ayrılmalıdır.
  * 
  * Modbus Registers:
  * - Holding Register 0: Display Mode (0=Off, 1=Welcome Text, 2=Price Display, 3=Time Display)
- * - Holding Register 1: Scroll Speed (50-500ms) - for welcome text
+ * - Holding Register 1: Scroll Speed (50-500ms, aralık dışı değerler kırpılır) - for welcome text
  * - Holding Register 2: Price Value (for mode 2) - will show as "XXXX TL"
+ *   (tam TL; yazılınca HR208-209'a ondalık basamak kadar ölçeklenip aktarılır)
  * - Holding Register 3: Time Value (for mode 3) - will show as "XXXX sn"
+ *   (HR213 > 0 ise yazıldığı an geri sayım bu değerden başlar)
+ * - Holding Register 4: Kayan yazıda kuyruk ile baş arası boşluk (0-64 piksel)
+ * - Holding Register 0 = 4: Program modu (yüklü ekran programını çalıştır)
+ * - Holding Register 0 = 5: Bölge modu (aşağıya bakınız)
+ * - Holding Register 0 = 6: Haber bandı (aşağıya bakınız)
+ * - Holding Register 0 = 7: Fiyat panosu (aşağıya bakınız)
+ * - Holding Register 10: Program uzunluğu (kelime); yazılınca program yüklenir
+ * - Holding Register 11: Program yükleme durumu (0 = OK, aksi halde hata<<8 | adres)
+ * - Holding Register 16-79: Program kelimeleri (bkz. DisplayVm.h)
+ * - Holding Register 80-143: 4 yazı slotu x 16 register (register başına 2 ASCII
+ *   karakter, üst bayt önce; slot 0 = karşılama yazısı)
+ * - Holding Register 144: Aktarılacak dosya numarası (1-16)
+ * - Holding Register 145-146: Dosya boyutu (bayt, üst kelime önce)
+ * - Holding Register 147: Dosyanın beklenen CRC16'sı
+ * - Holding Register 148: Dosya komutu (1 = başlat, 2 = doğrula ve kaydet, 3 = iptal)
+ * - Holding Register 149: Dosya durumu (bkz. ContentStore::Status)
+ * - Holding Register 150-151: Alınan bayt (kaldığı yerden devam için)
+ * - Holding Register 152: Trafik kaydı (0 = durdur, 1 = kaydet, 2 = temizle)
+ * - Holding Register 153: Kayıt boyutu (bayt, başlık dahil)
+ * - Holding Register 154: Hat çözümleyici (0 = kapalı, 1 = açık, 2 = sıfırla)
+ * - Holding Register 155: Input Register 24-32'de gösterilecek slave adresi
+ * - Holding Register 156: Yanıt sınırı (ms, master'ın zaman aşımı; varsayılan 1000)
+ * - Holding Register 157: Haber bandı komutu (1 = ekle, 2 = en eskiyi çıkar, 3 = temizle)
+ * - Holding Register 158: Eklenecek mesajın süresi (s, 0 = süresiz)
+ * - Holding Register 159: Kuyruktaki mesaj sayısı (en fazla 8)
+ * - Holding Register 160-175: Eklenecek mesaj (2 karakter / register, en fazla 32)
+ * - Holding Register 176: Tabelanın yanıt sınırı (ms, 0 = sınırsız; varsayılan 80).
+ *   Kuyrukta bundan uzun bekleyen isteğe yanıt verilmez (istek uygulanır)
+ * - Holding Register 208-209: 32 bitlik işaretli fiyat (üst kelime önce), mod 2
+ *   bunu gösterir; değer = gösterilen * 10^HR210 (149990 -> "1.499,90 TL")
+ * - Holding Register 210: Fiyatın ondalık basamak sayısı (0-4)
+ * - Holding Register 211: Fiyat biçimi (bit 0 = binlik ayırıcı, bit 1 = pozitifte
+ *   '+', bit 2 = "1,499.90" yazımı; varsayılan "1499,90")
+ * - Holding Register 212: Mod 2'de fiyat geçmişi (0 = kapalı, 1 = çubuk, 2 = çizgi);
+ *   açıkken fiyat üst bantta, son 32 fiyat alt bantta gösterilir
+ * - Holding Register 213: Mod 3 geri sayımının toplam süresi (s, 0 = kapalı); açıkken
+ *   kalan süre üst bantta saniye, alt bantta toplam süreye göre çubuk olarak gösterilir
+ * - Holding Register 214: Dikkat çekme efekti, tüm panel (0 = yok, 1 = yanıp sönme,
+ *   2 = ters, 3 = ters/normal dönüşümlü, 4 = kısa flaş); tarama sırasında
+ *   uygulanır, ekran yeniden çizilmez
+ * - Holding Register 215: Efekt periyodu (ms, 0 = 500)
+ * - Holding Register 216-255: Fiyat panosu ürün tablosu (aşağıya bakınız)
+ *
+ * Haber bandında (mode 6) mesajlar HR1 hızında ve HR4 boşlukla tek bir
+ * akışta sırayla kayar. Mesaj eklemek ya da çıkarmak kaymayı sıfırlamaz;
+ * yeni mesaj sırası gelince sağdan girer. Mesaj, süre ve komut tek FC16 ile
+ * yazılabilir (158-175, sonra 157) ya da komut ayrı FC06 ile verilir.
+ *
+ * Fiyat panosu (mode 7): 8 ürünlük tablo, girdi başına 5 register
+ * (girdi i = HR 216 + i*5):
+ * - +0: Ad (0 = yok, 1 = BENZIN, 2 = DIZEL, 3 = LPG, 4 = EKMEK, 5 = SUT,
+ *   6 = SEKER, 7 = UN, 8 = YAG; 100-103 = yazı slotu 0-3)
+ * - +1-2: Fiyat, 32 bit işaretli (üst kelime önce; HR208-209 gibi
+ *   HR210-211 biçiminde)
+ * - +3: Birim (0 = yok, 1 = TL, 2 = TL/L, 3 = TL/KG, 4 = TL/AD; sığmazsa yazılmaz)
+ * - +4: Gösterim süresi (s, 0 = girdi atlanır)
+ * Ad üst bantta, fiyat alt bantta çizilir. Her girdi yazıldığında kendi
+ * karesine bir kez çizilir; sırası gelince sadece kopyalanır.
+ *
+ * Trafik kaydı hattaki tüm çerçeveleri ve yanıtları us zaman damgasıyla
+ * RAM'de tutar (bkz. TrafficRecorder.h). Kayıt durdurulduktan sonra FC20
+ * ile dosya 100'den okunur ve host'ta tekrar oynatılabilir
+ * (src/host/replay.cpp). Kayıt sürerken okuma 06 (Slave Busy) istisnası
+ * döner.
+ *
+ * Dosya içeriği FC21 (Write File Record) ile yazılır, FC20 ile okunur
+ * (kayıt = 2 bayt, dosya başına en fazla 10000 kayıt).
+ *
+ * Hat tanılama: FC08 (bus/CRC/istisna/slave mesaj sayaçları, dinleme modu)
+ * ve FC11/12 (haberleşme olay sayacı ve kaydı) desteklenir.
+ *
+ * Ekran bölgeleri (mode 5): panel üst ve alt iki banda bölünür. Her bölge
+ * ayrı bir slave adresidir (ID 2 = üst, ID 3 = alt) ve kendi register
+ * bankası vardır; bir bölgeye yazmak sadece o bölgeyi yeniden çizer:
+ * - Holding Register 0: İçerik (0 = kapalı, 1 = yazı, 2 = fiyat, 3 = zaman,
+ *   4 = kayan yazı)
+ * - Holding Register 1: Değer (fiyat / zaman)
+ * - Holding Register 2-9: Yazı (2 karakter / register, en fazla 16 karakter)
+ * - Holding Register 10-11: Bölgenin efekti ve periyodu (ana slave'in HR214-215'i
+ *   gibi; 0 = ana slave'in efekti). Efekt yazmak bölgeyi yeniden çizmez.
+ * - Holding Register 12: Kayan yazının adım aralığı (ms, 20-1000, 0 = ana
+ *   slave'in HR1'i)
+ * Aralıklar ana slave'deki gibi yazılınca kırpılır (SignRegisters.h'deki
+ * ZONE_REGISTERS tablosu).
+ *
+ * Input Registers (bellek havuzu istatistikleri, bkz. Arena.h):
+ * - Input Register 0-7: Sınıf başına kullanılan blok / en yüksek kullanım
+ *   (sınıf 0 kullanılan, sınıf 0 en yüksek, sınıf 1 kullanılan, ...; 2 sınıf
+ *   vardır, IR4-7 ayrılmıştır ve 0 okunur)
+ * - Input Register 8: Başarısız ayırma sayısı
+ *
+ * Input Registers (RS485 port, bkz. Rs485Port.h):
+ * - Input Register 9: RX halkası / UART FIFO taşması
+ * - Input Register 10: Çerçeve (stop bit) hatası
+ * - Input Register 11-12: Son / en büyük turnaround (us)
+ * - Input Register 13: Son stop bitinden DE bırakılmasına en büyük gecikme (us)
+ *
+ * İstekler önceliklidir: yazmalar (FC06/16/21) bekleyen okuma ve tanılama
+ * isteklerinden önce uygulanır. Kuyruk gecikmesi (0.1 ms):
+ * - Input Register 14-15: Yazma (son / en büyük)
+ * - Input Register 16-17: Okuma ve tanılama (son / en büyük)
+ *
+ * Hat çözümleyici (HR154 = 1; boştaki bir tabela tüm hattı dinler, bkz.
+ * BusAnalyzer.h). Pencere son 10 s, süreler 0.1 ms:
+ * - Input Register 18: Hat doluluğu (binde)
+ * - Input Register 19: Penceredeki çerçeve sayısı
+ * - Input Register 20-21: En uzun boşluk (pencerede) / ortalama boşluk
+ * - Input Register 22: CRC hatalı çerçeve
+ * - Input Register 23: İzlenen slave sayısı
+ * - Input Register 24-32: HR155'teki slave için istek, yanıt, zaman aşımı,
+ *   tekrar, istisna, son / ortalama / en büyük yanıt süresi, geç yanıt
  */
 
 #include <Arduino.h>
-#include <SPI.h>
-#include <DMD2.h>
 #include <fonts/SystemFont5x7.h>
-#include <SoftwareSerial.h>
-#include <ModbusRTU.h>
 
-// Panel boyutları (1 panel = 32x16 piksel)
-SPIDMD dmd(1, 1);  // genişlik, yükseklik (panel sayısı)
+#include "Arena.h"
+#include "BusAnalyzer.h"
+#include "DisplayVm.h"
+#include "EspFlash.h"
+#include "Marquee.h"
+#include "PanelDriver.h"
+#include "ProgressBar.h"
+#include "Rs485Port.h"
+#include "RtuSlave.h"
+#include "Scheduler.h"
+#include "SignRegisters.h"
+#include "SlideDeck.h"
+#include "Sparkline.h"
+#include "TextFormat.h"
+#include "TextRenderer.h"
+#include "TickerFeed.h"
 
-// Modbus RTU yapılandırması
-#define MODBUS_SLAVE_ID 1
-#define RS485_TX_PIN 0   // D3
-#define RS485_RX_PIN 2   // D4  
+// Panel boyutları (1 panel = 32x16 piksel), geometri derleme zamanında sabit
+PanelDriver<P10Single> dmd;
+
+// RS485 bağlantısı UART0'dadır (slave adresi ve hız SignRegisters.h'de)
 #define RS485_DE_PIN 15  // D8
 
-SoftwareSerial modbusSerial(RS485_RX_PIN, RS485_TX_PIN);
-ModbusRTU mb;
+
+// Bölge bandı yüksekliği (piksel)
+#define ZONE_HEIGHT 8
+
+// Kayan yazı şeridi: 32 karakter x 6 piksel + en fazla 64 piksel boşluk
+#define MARQUEE_COLUMNS 256
+#define MARQUEE_ROWS    8
+
+// Bölge şeridi: 16 karakter x 6 piksel + boşluk, bant yüksekliğinde
+#define ZONE_MARQUEE_COLUMNS 160
+
+// Tüm kayan yazıları süren ortak görevin aralığı (ms)
+#define MARQUEE_TICK_MS 10
+
+// Haber bandı halkası: ekran + bir ekranlık kayma payı
+#define FEED_RING_COLUMNS 128
+
+// Fiyat panosunda sıranın kontrol aralığı (ms)
+#define BOARD_TICK_MS 100
+
+// Geri sayım çubuğunun kontrol aralığı (ms)
+#define COUNTDOWN_TICK_MS 50
+
+Rs485Port rs485(RS485_DE_PIN);
+
+// Register bankaları (banka 0 = ana slave, 1.. = bölgeler)
+SignRegisters regs;
+uint16_t (&hregs)[SignRegisters::HOLDING_COUNT] = regs.holding;
+uint16_t (&iregs)[SignRegisters::INPUT_COUNT] = regs.input;
+ZoneRegisters zones[ZONE_COUNT];
+
+RtuSlave mb(rs485, hregs, SignRegisters::HOLDING_COUNT, iregs, SignRegisters::INPUT_COUNT);
+
+// Flash işlemi sırasında panel taraması durur
+void flashGuard(bool busy) {
+    if (busy) {
+        dmd.pause();
+    } else {
+        dmd.resume();
+    }
+}
+
+EspFlash flash(flashGuard);
+ContentStore content(flash);
+TrafficRecorder recorder;
+BusAnalyzer analyzer(MODBUS_BAUD);
+
+// RtuSlave tek dinleyici alır: kayıt ve hat çözümleyici buradan beslenir
+class TrafficTap : public TrafficSink {
+public:
+    TrafficTap() : recording(false), analyzing(false) {}
+
+    void record(uint8_t dir, uint32_t stampUs, const uint8_t *data, uint16_t len) override {
+        if (recording) {
+            recorder.record(dir, stampUs, data, len);
+        }
+        if (analyzing) {
+            analyzer.record(dir, stampUs, data, len);
+        }
+    }
+
+    bool recording;
+    bool analyzing;
+};
+
+TrafficTap tap;
+
+// FC20/21: RECORDER_FILE trafik kaydıdır (salt okunur), diğerleri içerik deposu
+class SignFileStore : public FileRecordStore {
+public:
+    uint8_t readRecords(uint16_t file, uint32_t offset, uint8_t *dst, uint16_t len) override {
+        if (file != RECORDER_FILE) {
+            return content.readRecords(file, offset, dst, len);
+        }
+        // Kayıt sürerken halka her istekte kayar; parçalı okuma tutarsız olur
+        if (tap.recording) {
+            return RtuSlave::EX_SLAVE_BUSY;
+        }
+        return recorder.read(offset, dst, len) ? 0 : RtuSlave::EX_ILLEGAL_ADDRESS;
+    }
+    uint8_t writeRecords(uint16_t file, uint32_t offset, const uint8_t *src, uint16_t len) override {
+        if (file != RECORDER_FILE) {
+            return content.writeRecords(file, offset, src, len);
+        }
+        return RtuSlave::EX_ILLEGAL_ADDRESS;
+    }
+};
+
+SignFileStore fileStore;
+
+// Register'ı uygulama tarafında güncelle; sadece değer değişirse yanıt
+// önbelleği bozulur
+void setHreg(uint16_t addr, uint16_t value) {
+    if (hregs[addr] != value) {
+        hregs[addr] = value;
+        mb.holdingChanged(addr);
+    }
+}
+
+void setIreg(uint16_t addr, uint16_t value) {
+    if (iregs[addr] != value) {
+        iregs[addr] = value;
+        mb.inputChanged(addr);
+    }
+}
+
+
+// Yazı slotları (slot 0 = karşılama yazısı). Modbus'tan gelen yazılar
+// bellek havuzunda tutulur; heap String kullanılmaz.
+const char *texts[TEXT_SLOTS] = { "Welcome", "", "", "" };
 
 // Display değişkenleri
-String welcomeText = "Welcome";
-int displayMode = 1;  // 0=Off, 1=Welcome Text, 2=Price Display, 3=Time Display
+int displayMode = 1;  // 0=Off, 1=Welcome Text, 2=Price Display, 3=Time Display, 4=Program, 5=Zones
 int scrollSpeed = 100;
-int scrollX = 32;
-unsigned long lastScrollTime = 0;
+int scrollGap = 16;
+
+// Ekranda o an çizilen içerik (program modunda programa göre değişir)
+#define CONTENT_TEXT 10
+int contentMode = 0;
+uint8_t contentSlot = 0;
 
 // Price display değişkenleri
-int16_t priceValue = 0;
+int32_t priceValue = 0;
+uint8_t priceGraph = PRICE_GRAPH_OFF;
+Sparkline<PRICE_HISTORY> priceHistory;
 
 // Time display değişkenleri
 int16_t timeValue = 0;
 
+// Geri sayım (HR213 > 0 iken mod 3): HR3 yazıldığı andan itibaren
+uint16_t timeTotal = 0;
+uint32_t countdownStartMs = 0;
+uint32_t countdownMs = 0;
+ProgressBar timeBar;
+int8_t countdownTask = -1;
+
 // Sabit pozisyon değerleri
 const int TEXT_POS_X = 2;
 const int TEXT_POS_Y = 4;
 
-// Modbus register'larından display parametrelerini güncelle
-void updateDisplayFromModbus() {
-    // Display mode (Register 0)
-    displayMode = mb.Hreg(0);
-    
-    // Scroll speed (Register 1)
-    if (mb.Hreg(1) >= 50 && mb.Hreg(1) <= 500) {
-        scrollSpeed = mb.Hreg(1);
+Scheduler scheduler;
+Marquee<MARQUEE_COLUMNS, MARQUEE_ROWS> marquee;
+Marquee<ZONE_MARQUEE_COLUMNS, ZONE_HEIGHT> zoneMarquees[ZONE_COUNT];
+char zoneScrollText[ZONE_COUNT][ZONE_TEXT_REGS * 2 + 1];
+TickerFeed<FEED_ITEMS, FEED_TEXT_REGS * 2, FEED_RING_COLUMNS, MARQUEE_ROWS> feed;
+SlideDeck<PanelFrame<P10Single>, BOARD_ENTRIES> board;
+int8_t marqueeTask = -1;
+int8_t boardTask = -1;
+
+// Register yazıldığında loop() içinde bir kez işlenir
+volatile bool registersDirty = false;
+volatile bool programDirty = false;
+volatile bool textsDirty = false;
+
+// Yazılan bölgeler (bit z = bölge z), sadece bunlar yeniden çizilir
+volatile uint8_t zonesDirty = 0;
+
+// Efekt register'ları yazıldı: sadece tarama ayarı değişir
+volatile bool effectsDirty = false;
+
+// Yazılan ürün tablosu girdileri (bit i = girdi i)
+volatile uint8_t boardDirty = 0;
+
+// Sayı metinleri için sabit tampon (String yerine)
+char textBuffer[24];
+
+// Register bloğundaki yazıyı çöz: register başına 2 karakter (üst bayt
+// önce); 'out' en az count * 2 + 1 bayt olmalı
+void decodeText(const uint16_t *regs, uint8_t count, char *out) {
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        out[n++] = regs[i] >> 8;
+        out[n++] = regs[i] & 0xFF;
     }
-    
-    // Price değeri (Register 2)
-    priceValue = (int16_t)mb.Hreg(2);
-    
-    // Time değeri (Register 3)
-    timeValue = (int16_t)mb.Hreg(3);
-    
-    // Welcome modunda scroll pozisyonunu sıfırla
-    if (displayMode == 1) {
-        scrollX = 32;
+    out[n] = '\0';
+}
+
+// Bölgeyi kendi bankasından çiz; diğer bölgelere dokunulmaz
+void renderZone(uint8_t zone) {
+    const uint16_t *regs = zones[zone].holding;
+    int y = zone * ZONE_HEIGHT;
+    char text[ZONE_TEXT_REGS * 2 + 1];
+
+    switch (regs[ZREG_CONTENT]) {
+        case 1:
+        case ZONE_CONTENT_SCROLL:
+            decodeText(regs + ZREG_TEXT, ZONE_TEXT_REGS, text);
+            break;
+        case 2:
+            formatInt(text, sizeof(text), (int16_t)regs[ZREG_VALUE], " TL");
+            break;
+        case 3:
+            formatInt(text, sizeof(text), (int16_t)regs[ZREG_VALUE], " sn");
+            break;
+        default:
+            text[0] = '\0';
+            break;
+    }
+
+    Marquee<ZONE_MARQUEE_COLUMNS, ZONE_HEIGHT> &m = zoneMarquees[zone];
+    if (regs[ZREG_CONTENT] == ZONE_CONTENT_SCROLL) {
+        // Metin ya da boşluk değişmediyse konum korunur (ör. sadece hız yazıldı)
+        if (!m.active() || m.gapColumns() != scrollGap || strcmp(text, zoneScrollText[zone]) != 0) {
+            strcpy(zoneScrollText[zone], text);
+            m.start(dmd, text, scrollGap);
+        }
+        m.setInterval(regs[ZREG_SPEED] ? regs[ZREG_SPEED] : scrollSpeed);
+        m.draw(dmd, 0, y, dmd.width());
+        return;
     }
+    m.stop();
+
+    dmd.clearRect(0, y, dmd.width(), ZONE_HEIGHT);
+    int x = (dmd.width() - dmd.stringWidth(text)) / 2;
+    dmd.drawString(x < 0 ? 0 : x, y, text);
 }
 
-// Modbus callback fonksiyonu
-bool modbusCallback(Modbus::ResultCode event, uint16_t transactionId, void* data) {
-    if (event == Modbus::EX_SUCCESS) {
-        // Register değerleri güncellendi
-        updateDisplayFromModbus();
+const char *productName(uint16_t id) {
+    if (id >= PRODUCT_NAME_SLOT && id < PRODUCT_NAME_SLOT + TEXT_SLOTS) {
+        return texts[id - PRODUCT_NAME_SLOT];
     }
-    return true;
+    return id < sizeof(PRODUCT_NAMES) / sizeof(PRODUCT_NAMES[0]) ? PRODUCT_NAMES[id] : "";
 }
 
-void setup() {
-    Serial.begin(115200);
-    Serial.println("P10 LED Panel + Modbus RTU Test Başladı");
-    
-    // DMD2'yi başlat
-    dmd.begin();
-    dmd.selectFont(SystemFont5x7);
-    dmd.clearScreen();
-    
-    // Modbus RTU setup
-    modbusSerial.begin(9600);
-    mb.begin(&modbusSerial, RS485_DE_PIN);
-    mb.slave(MODBUS_SLAVE_ID);
-    
-    // Holding register'ları ekle (0-3)
-    for (int i = 0; i < 4; i++) {
-        mb.addHreg(i);
+// Ürün girdisini kendi karesine çiz: ad üst bantta, fiyat alt bantta
+void renderBoardEntry(uint8_t i, PanelFrame<P10Single> &frame) {
+    const uint16_t *e = &hregs[REG_BOARD_BASE + i * BOARD_ENTRY_REGS];
+    char text[24];
+    frame.clearScreen();
+
+    const char *name = productName(e[BOARD_NAME]);
+    int x = (frame.width() - frame.stringWidth(name)) / 2;
+    frame.drawString(x < 0 ? 0 : x, 0, name);
+
+    uint16_t unit = e[BOARD_UNIT];
+    const char *suffix = unit < sizeof(PRODUCT_UNITS) / sizeof(PRODUCT_UNITS[0]) ? PRODUCT_UNITS[unit] : "";
+    FixedFormat format = priceFormat(regs);
+    formatFixed(text, sizeof(text), boardPrice(e), format, suffix);
+    if (frame.stringWidth(text) > frame.width()) {
+        formatFixed(text, sizeof(text), boardPrice(e), format);
     }
-    
-    // Başlangıç değerleri
-    mb.Hreg(0, 1);        // Welcome mode
-    mb.Hreg(1, 100);      // 100ms scroll speed
-    mb.Hreg(2, 1500);     // 1500 TL örnek fiyat
-    mb.Hreg(3, 60);       // 60 sn örnek zaman
-    
-    updateDisplayFromModbus();
-    
-    Serial.println("Panel hazır, Modbus RTU Slave ID: " + String(MODBUS_SLAVE_ID));
-    Serial.println("Baud Rate: 9600, Parity: None, Stop Bits: 1");
+    x = (frame.width() - frame.stringWidth(text)) / 2;
+    frame.drawString(x < 0 ? 0 : x, ZONE_HEIGHT, text);
 }
 
-void loop() {
-    // Modbus iletişimini işle
-    mb.task();
-    
-    // Register'ları güncelle
-    displayMode = mb.Hreg(0);
-    scrollSpeed = mb.Hreg(1);
-    priceValue = (int16_t)mb.Hreg(2);
-    timeValue = (int16_t)mb.Hreg(3);
-    
-    // Display mode'a göre işlem yap
-    switch (displayMode) {
+// Yazılan girdileri uygula: sadece onların kareleri yeniden çizilir
+void loadBoard(uint8_t entries) {
+    for (uint8_t i = 0; i < BOARD_ENTRIES; i++) {
+        if (entries & (1 << i)) {
+            board.setDwell(i, hregs[REG_BOARD_BASE + i * BOARD_ENTRY_REGS + BOARD_DWELL] * 1000UL);
+            board.invalidate(i);
+        }
+    }
+    if (board.refresh(renderBoardEntry) && contentMode == MODE_BOARD) {
+        board.show(dmd);
+    }
+}
+
+// Adı yazı slotundan gelen girdiler (slotlar değişince yeniden çizilir)
+uint8_t boardSlotEntries() {
+    uint8_t entries = 0;
+    for (uint8_t i = 0; i < BOARD_ENTRIES; i++) {
+        if (hregs[REG_BOARD_BASE + i * BOARD_ENTRY_REGS + BOARD_NAME] >= PRODUCT_NAME_SLOT) {
+            entries |= 1 << i;
+        }
+    }
+    return entries;
+}
+
+// Grafik açıkken fiyat üst bantta; sadece bu bant yeniden çizilir
+void renderPriceLine() {
+    formatFixed(textBuffer, sizeof(textBuffer), priceValue, priceFormat(regs), " TL");
+    dmd.clearRect(0, 0, dmd.width(), ZONE_HEIGHT);
+    dmd.drawString(TEXT_POS_X, 0, textBuffer);
+}
+
+uint32_t countdownRemaining() {
+    uint32_t elapsed = millis() - countdownStartMs;
+    return elapsed < countdownMs ? countdownMs - elapsed : 0;
+}
+
+// Geri sayımda kalan saniye üst bantta; sadece bu bant yeniden çizilir
+void renderTimeLine() {
+    formatInt(textBuffer, sizeof(textBuffer), timeValue, " sn");
+    dmd.clearRect(0, 0, dmd.width(), ZONE_HEIGHT);
+    dmd.drawString(TEXT_POS_X, 0, textBuffer);
+}
+
+// Bant başına efekt: bölge modunda bölgenin kendi efekti, yoksa ana slave'inki
+void applyEffects() {
+    for (uint8_t z = 0; z < ZONE_COUNT; z++) {
+        uint16_t effect = hregs[REG_EFFECT];
+        uint16_t period = hregs[REG_EFFECT_PERIOD];
+        if (contentMode == MODE_ZONES && zones[z].holding[ZREG_EFFECT]) {
+            effect = zones[z].holding[ZREG_EFFECT];
+            period = zones[z].holding[ZREG_EFFECT_PERIOD];
+        }
+        dmd.setEffect(z * ZONE_HEIGHT, ZONE_HEIGHT, (PanelEffect)effect, period);
+    }
+}
+
+// Geçerli içeriği bir kez çiz (sabit modlar sadece değişince çizilir)
+void renderContent() {
+    switch (contentMode) {
         case 0: // Off
             dmd.clearScreen();
             break;
-            
+
         case 1: // Welcome Text (scrolling)
-            if (millis() - lastScrollTime >= (unsigned long)scrollSpeed) {
-                dmd.clearScreen();
-                dmd.drawString(scrollX, TEXT_POS_Y, welcomeText.c_str());
-                scrollX--;
-                if (scrollX < -((int)welcomeText.length() * 6)) {  // Metin tamamen soldan çıktığında
-                    scrollX = 32;  // Sağdan başlat
-                }
-                lastScrollTime = millis();
-            }
+            renderMarquee(dmd, marquee, TEXT_POS_Y);
             break;
-            
+
         case 2: // Price Display
-            {
-                String priceStr = String(priceValue) + " TL";
+            if (priceGraph == PRICE_GRAPH_OFF) {
+                formatFixed(textBuffer, sizeof(textBuffer), priceValue, priceFormat(regs), " TL");
+                renderText(dmd, TEXT_POS_X, TEXT_POS_Y, textBuffer);
+            } else {
                 dmd.clearScreen();
-                dmd.drawString(TEXT_POS_X, TEXT_POS_Y, priceStr.c_str());
+                renderPriceLine();
+                priceHistory.draw(dmd);
             }
             break;
-            
+
         case 3: // Time Display
-            {
-                String timeStr = String(timeValue) + " sn";
+            if (timeTotal == 0) {
+                formatInt(textBuffer, sizeof(textBuffer), timeValue, " sn");
+                renderText(dmd, TEXT_POS_X, TEXT_POS_Y, textBuffer);
+            } else {
                 dmd.clearScreen();
-                dmd.drawString(TEXT_POS_X, TEXT_POS_Y, timeStr.c_str());
+                renderTimeLine();
+                timeBar.draw(dmd, countdownRemaining());
+            }
+            break;
+
+        case CONTENT_TEXT:
+            renderCentered(dmd, texts[contentSlot]);
+            break;
+
+        case MODE_ZONES:
+            for (uint8_t z = 0; z < ZONE_COUNT; z++) {
+                renderZone(z);
             }
             break;
-            
+
+        case MODE_FEED:
+            dmd.clearScreen();
+            feed.draw(dmd, 0, TEXT_POS_Y, dmd.width());
+            break;
+
+        case MODE_BOARD:
+            board.show(dmd);
+            break;
+
         default:
             // Geçersiz mode, hata göster
-            dmd.clearScreen();
-            dmd.drawString(2, 4, "MODE ERROR");
-            delay(1000);
+            renderText(dmd, 2, 4, "MODE ERROR");
+            break;
+    }
+}
+
+// Slotun güncel metnini şeride çiz, baştan başlat
+void startMarquee(uint8_t slot) {
+    marquee.start(dmd, texts[slot], scrollGap);
+}
+
+// İçeriği değiştir: 0-3 hazır modlar, CONTENT_TEXT sabit yazı
+void showContent(int mode, uint8_t slot, uint16_t speed) {
+    // Aynı slot zaten kayıyorsa konum korunur
+    if (mode == 1 && (contentMode != 1 || contentSlot != slot)) {
+        contentSlot = slot;
+        startMarquee(slot);
+    }
+    // Haber bandı sadece moda girerken boş ekranla başlar
+    if (mode == MODE_FEED && contentMode != MODE_FEED) {
+        feed.start(dmd.width());
+    }
+    // Pano moda girerken ilk gösterilebilir girdiden başlar
+    if (mode == MODE_BOARD && contentMode != MODE_BOARD) {
+        board.restart();
+        board.update(millis());
+    }
+    contentMode = mode;
+    contentSlot = slot;
+    marquee.setInterval(speed);
+    feed.setInterval(speed);
+    feed.setGap(scrollGap);
+    scheduler.setEnabled(marqueeTask, mode == 1 || mode == MODE_ZONES || mode == MODE_FEED);
+    scheduler.setEnabled(boardTask, mode == MODE_BOARD);
+    scheduler.setEnabled(countdownTask, mode == 3 && timeTotal > 0);
+    applyEffects();
+    renderContent();
+}
+
+// Ekran programının panele erişimi
+class SignVmHost : public DisplayVmHost {
+public:
+    void vmShowText(uint8_t slot) override {
+        showContent(CONTENT_TEXT, slot, scrollSpeed);
+    }
+    void vmScrollText(uint8_t slot, uint16_t speedMs) override {
+        showContent(1, slot, speedMs);
+    }
+    void vmShowMode(uint8_t mode) override {
+        showContent(mode, 0, scrollSpeed);
+    }
+    void vmSetBrightness(uint8_t level) override {
+        dmd.setBrightness(level);
+    }
+    uint16_t vmReadRegister(uint8_t reg) override {
+        return hregs[reg];
+    }
+};
+
+SignVmHost vmHost;
+DisplayVm vm(vmHost, TEXT_SLOTS, VM_REGISTER_COUNT);
+int8_t vmTask = -1;
+
+// Program bloğunu doğrula ve yükle, sonucu durum register'ına yaz
+void loadProgram() {
+    uint16_t words[DisplayVm::MAX_WORDS];
+    uint16_t count = hregs[REG_PROGRAM_LENGTH];
+    uint8_t errorAddr = 0;
+
+    if (count > DisplayVm::MAX_WORDS) {
+        count = DisplayVm::MAX_WORDS + 1;  // load() LOAD_TOO_LONG döndürür
+    }
+    for (uint16_t i = 0; i < count && i < DisplayVm::MAX_WORDS; i++) {
+        words[i] = hregs[REG_PROGRAM_BASE + i];
+    }
+    DisplayVm::LoadStatus status = vm.load(words, count, &errorAddr);
+    setHreg(REG_PROGRAM_STATUS, status == DisplayVm::LOAD_OK ? 0 : (status << 8) | errorAddr);
+    vm.restart(millis());
+}
+
+// Yazı slotlarını register'lardan çöz (2 karakter / register).
+// Değişen slot havuzdan yazının boyuna uygun yeni bir blok alır; havuz
+// doluysa eski yazı kalır.
+void loadTexts() {
+    for (uint8_t slot = 0; slot < TEXT_SLOTS; slot++) {
+        char decoded[TEXT_SLOT_REGS * 2 + 1];
+        decodeText(&hregs[REG_TEXT_BASE + slot * TEXT_SLOT_REGS], TEXT_SLOT_REGS, decoded);
+
+        if (strcmp(decoded, texts[slot]) == 0) {
+            continue;
+        }
+        size_t len = strlen(decoded);
+        char *block = (char *)arena.alloc(len + 1);
+        if (block == nullptr) {
+            continue;
+        }
+        memcpy(block, decoded, len + 1);
+        arena.free((void *)texts[slot]);
+        texts[slot] = block;
+    }
+
+    // Kayan yazının metni değişmiş olabilir, şeridi yeniden çiz
+    if (contentMode == 1) {
+        startMarquee(contentSlot);
+    }
+}
+
+// Yazıyı slot register'larına yaz (başlangıç değerleri için)
+void storeText(uint8_t slot, const char *text) {
+    for (uint8_t i = 0; i < TEXT_SLOT_REGS; i++) {
+        uint16_t hi = *text ? (uint8_t)*text++ : 0;
+        uint16_t lo = *text ? (uint8_t)*text++ : 0;
+        hregs[REG_TEXT_BASE + slot * TEXT_SLOT_REGS + i] = (hi << 8) | lo;
+    }
+}
+
+// Modbus register'larından display parametrelerini güncelle
+void updateDisplayFromModbus() {
+    // Değerler yazma sırasında haritadaki aralıklara kırpılmıştır
+    int newMode = regs.value(0);
+    scrollSpeed = regs.value(1);
+    if (regs.value(4) != scrollGap) {
+        scrollGap = regs.value(4);
+        if (contentMode == 1) {
+            startMarquee(contentSlot);
+        }
+    }
+    // Geçmişe sadece değişen fiyat girer
+    int32_t price = fixedPrice(regs);
+    if (price != priceValue) {
+        priceValue = price;
+        priceHistory.push(price);
+    }
+    bool graphChanged = regs.value(REG_PRICE_GRAPH) != priceGraph;
+    if (graphChanged) {
+        priceGraph = regs.value(REG_PRICE_GRAPH);
+        priceHistory.setFilled(priceGraph == PRICE_GRAPH_BARS);
+    }
+    timeTotal = regs.value(REG_TIME_TOTAL);
+    timeBar.setTotal(timeTotal * 1000UL);
+    timeValue = timeTotal ? (countdownRemaining() + 999) / 1000 : regs.value(3);
+
+    // Program moduna geçişte program baştan başlar
+    if (newMode == MODE_PROGRAM && displayMode != MODE_PROGRAM) {
+        vm.restart(millis());
+    }
+    displayMode = newMode;
+    scheduler.setEnabled(vmTask, displayMode == MODE_PROGRAM);
+
+    if (displayMode == MODE_PROGRAM) {
+        // İçeriği program seçer, burada sadece mevcut içerik tazelenir
+        renderContent();
+    } else if (displayMode == 2 && contentMode == 2 && priceGraph != PRICE_GRAPH_OFF && !graphChanged) {
+        // Grafik kaydırılıp yeni sütun eklenir, sadece fiyat satırı yeniden çizilir
+        renderPriceLine();
+        priceHistory.update(dmd);
+    } else {
+        showContent(displayMode, 0, scrollSpeed);
+    }
+}
+
+// Dosya aktarım durumunu register'lara yansıt
+void updateFileStatus() {
+    setHreg(REG_FILE_STATUS, content.status());
+    setHreg(REG_FILE_RECEIVED, content.received() >> 16);
+    setHreg(REG_FILE_RECEIVED + 1, content.received() & 0xFFFF);
+}
+
+// Dosya komutu hemen uygulanır: yanıt gittiğinde aktarım hazırdır
+void handleFileCommand() {
+    switch (hregs[REG_FILE_COMMAND]) {
+        case FILE_CMD_BEGIN:
+            content.beginTransfer(hregs[REG_FILE_NUMBER],
+                                  ((uint32_t)hregs[REG_FILE_SIZE] << 16) | hregs[REG_FILE_SIZE + 1],
+                                  hregs[REG_FILE_CRC]);
+            break;
+        case FILE_CMD_COMMIT:
+            content.commitTransfer();
+            break;
+        case FILE_CMD_ABORT:
+            content.abortTransfer();
+            break;
+    }
+    setHreg(REG_FILE_COMMAND, 0);
+    updateFileStatus();
+}
+
+void updateTap() {
+    mb.setRecorder(tap.recording || tap.analyzing ? &tap : nullptr);
+}
+
+// Kayıt komutu: okuma sırasında kayıt değişmesin diye önce durdurulmalı
+void handleRecorderCommand() {
+    switch (hregs[REG_RECORDER_CONTROL]) {
+        case RECORDER_STOP:
+            tap.recording = false;
+            break;
+        case RECORDER_RUN:
+            tap.recording = true;
+            break;
+        case RECORDER_CLEAR:
+            tap.recording = false;
+            recorder.clear();
+            setHreg(REG_RECORDER_CONTROL, RECORDER_STOP);
+            break;
+    }
+    updateTap();
+}
+
+void handleAnalyzerCommand() {
+    analyzer.setResponseLimit(hregs[REG_ANALYZER_TIMEOUT] * 1000UL);
+    switch (hregs[REG_ANALYZER_CONTROL]) {
+        case ANALYZER_OFF:
+            tap.analyzing = false;
+            break;
+        case ANALYZER_RUN:
+            tap.analyzing = true;
+            break;
+        case ANALYZER_RESET:
+            analyzer.reset();
+            setHreg(REG_ANALYZER_CONTROL, tap.analyzing ? ANALYZER_RUN : ANALYZER_OFF);
+            break;
+    }
+    updateTap();
+}
+
+// Mesaj eklenir ya da çıkarılır; akış kaymaya devam eder
+void handleFeedCommand() {
+    switch (hregs[REG_FEED_COMMAND]) {
+        case FEED_CMD_APPEND: {
+            char text[FEED_TEXT_REGS * 2 + 1];
+            decodeText(&hregs[REG_FEED_TEXT], FEED_TEXT_REGS, text);
+            feed.append(text, millis(), hregs[REG_FEED_TTL] * 1000UL);
+            break;
+        }
+        case FEED_CMD_EXPIRE:
+            feed.expireOldest();
             break;
+        case FEED_CMD_CLEAR:
+            feed.clear();
+            break;
+    }
+    setHreg(REG_FEED_COMMAND, 0);
+    setHreg(REG_FEED_COUNT, feed.prune(millis()));
+}
+
+// Modbus yazma callback'i: değerler zaten yazılmıştır, işleme loop()'ta yapılır
+void onRegistersWritten(uint8_t bank, uint16_t start, uint16_t count) {
+    // Kırpılan değerler okuma önbelleğinde kalmasın diye RtuSlave önbelleği
+    // callback'ten önce bozmuştur
+    if (bank > 0) {
+        uint32_t actions = zones[bank - 1].applyWrite(start, count);
+        if (actions & (1UL << ACT_DISPLAY)) {
+            zonesDirty |= 1 << (bank - 1);
+        }
+        if (actions & (1UL << ACT_EFFECT)) {
+            effectsDirty = true;
+        }
+        return;
+    }
+    uint32_t actions = regs.applyWrite(start, count);
+
+    if (actions & (1UL << ACT_DISPLAY)) {
+        registersDirty = true;
+    }
+    if (actions & (1UL << ACT_PRICE)) {
+        int32_t price = legacyPrice(regs);
+        setHreg(REG_PRICE_VALUE, (uint32_t)price >> 16);
+        setHreg(REG_PRICE_VALUE + 1, (uint32_t)price & 0xFFFF);
+        registersDirty = true;
+    }
+    if (actions & (1UL << ACT_EFFECT)) {
+        effectsDirty = true;
+    }
+    if (actions & (1UL << ACT_TIME)) {
+        int32_t seconds = regs.value(3);
+        countdownStartMs = millis();
+        countdownMs = seconds > 0 ? seconds * 1000UL : 0;
+        registersDirty = true;
+    }
+    // Biçim değişince panodaki fiyatlar da yeniden çizilir
+    if (actions & (1UL << ACT_PRICE_FORMAT)) {
+        boardDirty = (1 << BOARD_ENTRIES) - 1;
+        registersDirty = true;
+    }
+    // Sadece uzunluk register'ı yüklemeyi tetikler
+    if (actions & (1UL << ACT_PROGRAM)) {
+        programDirty = true;
+    }
+    if (actions & (1UL << ACT_TEXTS)) {
+        textsDirty = true;
+    }
+    if (actions & (1UL << ACT_FILE_COMMAND)) {
+        handleFileCommand();
+    }
+    if (actions & (1UL << ACT_RECORDER)) {
+        handleRecorderCommand();
+    }
+    if (actions & (1UL << ACT_ANALYZER)) {
+        handleAnalyzerCommand();
+    }
+    if (actions & (1UL << ACT_FEED)) {
+        handleFeedCommand();
     }
+    if (actions & (1UL << ACT_RESPONSE_LIMIT)) {
+        mb.setResponseLimit(hregs[REG_RESPONSE_LIMIT] * 1000UL);
+    }
+    if (actions & (1UL << ACT_BOARD)) {
+        // Sadece yazılan aralığa düşen girdiler
+        uint16_t end = REG_BOARD_BASE + BOARD_ENTRIES * BOARD_ENTRY_REGS;
+        uint16_t first = start > REG_BOARD_BASE ? start : REG_BOARD_BASE;
+        uint16_t last = start + count < end ? start + count - 1 : end - 1;
+        for (uint16_t i = (first - REG_BOARD_BASE) / BOARD_ENTRY_REGS;
+             i <= (last - REG_BOARD_BASE) / BOARD_ENTRY_REGS; i++) {
+            boardDirty |= 1 << i;
+        }
+    }
+}
+
+void modbusTaskFn() {
+    // Modbus iletişimini işle: kesmenin doldurduğu baytlar geliş zamanlarıyla
+    // RX halkasına, çerçeveler yerinde işlenir
+    uint8_t b;
+    uint32_t stampUs;
+    while (rs485.read(b, stampUs)) {
+        mb.receive(b, stampUs);
+    }
+    mb.task(micros());
+    updateFileStatus();
+
+    if (programDirty) {
+        programDirty = false;
+        loadProgram();
+    }
+    if (textsDirty) {
+        textsDirty = false;
+        loadTexts();
+        boardDirty |= boardSlotEntries();
+        registersDirty = true;
+    }
+    if (boardDirty) {
+        uint8_t dirty = boardDirty;
+        boardDirty = 0;
+        loadBoard(dirty);
+    }
+    if (registersDirty) {
+        registersDirty = false;
+        zonesDirty = 0;
+        updateDisplayFromModbus();
+    }
+    if (zonesDirty) {
+        uint8_t dirty = zonesDirty;
+        zonesDirty = 0;
+        if (contentMode == MODE_ZONES) {
+            for (uint8_t z = 0; z < ZONE_COUNT; z++) {
+                if (dirty & (1 << z)) {
+                    renderZone(z);
+                }
+            }
+        }
+    }
+    if (effectsDirty) {
+        effectsDirty = false;
+        applyEffects();
+    }
+}
+
+void vmTaskFn() {
+    vm.run(millis());
+}
+
+// 32 bit sayacı register'a sığdır
+static uint16_t saturate16(uint32_t v) {
+    return v > 0xFFFF ? 0xFFFF : v;
+}
+
+// Hat çözümleyici sonuçları; süreler 0.1 ms biriminde
+void updateAnalyzerStats() {
+    analyzer.tick(micros());
+    const BusAnalyzer::BusStats &bus = analyzer.bus();
+    setIreg(IREG_BUS_UTILIZATION, analyzer.utilizationPermille());
+    setIreg(IREG_BUS_FRAMES, saturate16(analyzer.windowFrames()));
+    setIreg(IREG_BUS_GAP_MAX, saturate16(analyzer.windowMaxGapUs() / 100));
+    setIreg(IREG_BUS_GAP_AVG, saturate16(bus.averageGapUs() / 100));
+    setIreg(IREG_BUS_CRC_ERRORS, saturate16(bus.crcErrors));
+    setIreg(IREG_BUS_SLAVES, analyzer.slaveCount());
+
+    const BusAnalyzer::SlaveStats *s = analyzer.slave(hregs[REG_ANALYZER_SLAVE]);
+    BusAnalyzer::SlaveStats none = {};
+    if (!s) {
+        s = &none;
+    }
+    setIreg(IREG_SLAVE_BASE + SLAVE_REQUESTS, saturate16(s->requests));
+    setIreg(IREG_SLAVE_BASE + SLAVE_RESPONSES, saturate16(s->responses));
+    setIreg(IREG_SLAVE_BASE + SLAVE_TIMEOUTS, saturate16(s->timeouts));
+    setIreg(IREG_SLAVE_BASE + SLAVE_RETRIES, saturate16(s->retries));
+    setIreg(IREG_SLAVE_BASE + SLAVE_EXCEPTIONS, saturate16(s->exceptions));
+    setIreg(IREG_SLAVE_BASE + SLAVE_RESPONSE_LAST, saturate16(s->lastResponseUs / 100));
+    setIreg(IREG_SLAVE_BASE + SLAVE_RESPONSE_AVG, saturate16(s->averageResponseUs() / 100));
+    setIreg(IREG_SLAVE_BASE + SLAVE_RESPONSE_MAX, saturate16(s->maxResponseUs / 100));
+    setIreg(IREG_SLAVE_BASE + SLAVE_LATE, saturate16(s->late));
+}
+
+// Bellek havuzu ve RS485 istatistiklerini input register'lara yaz
+void statsTaskFn() {
+    for (uint8_t c = 0; c < Arena::CLASS_COUNT; c++) {
+        Arena::ClassStats st = arena.stats(c);
+        setIreg(IREG_ARENA_BASE + c * 2, st.used);
+        setIreg(IREG_ARENA_BASE + c * 2 + 1, st.highWater);
+    }
+    setIreg(IREG_ARENA_FAILURES, arena.failures());
+
+    setIreg(IREG_RX_OVERRUNS, saturate16(rs485.overruns()));
+    setIreg(IREG_RX_FRAMING, saturate16(rs485.framingErrors()));
+    setIreg(IREG_TURNAROUND, saturate16(rs485.lastTurnaroundUs()));
+    setIreg(IREG_TURNAROUND_MAX, saturate16(rs485.maxTurnaroundUs()));
+    setIreg(IREG_DE_RELEASE_MAX, saturate16(rs485.maxReleaseUs()));
+
+    for (uint8_t c = 0; c < RtuSlave::CLASS_COUNT; c++) {
+        const RtuSlave::QueueStats &q = mb.queueStats(c);
+        setIreg(IREG_QUEUE_DELAY + c * 2, saturate16(q.lastDelayUs / 100));
+        setIreg(IREG_QUEUE_DELAY + c * 2 + 1, saturate16(q.maxDelayUs / 100));
+    }
+
+    setHreg(REG_RECORDER_SIZE, saturate16(recorder.size()));
+    setHreg(REG_FEED_COUNT, feed.prune(millis()));
+
+    if (tap.analyzing) {
+        updateAnalyzerStats();
+    }
+}
+
+// Kayan yazıların ortak adımı: her şerit kendi aralığında ilerler, sadece
+// zamanı gelenler kendi bandına çizilir (bölgeler birbirine dokunmaz)
+void marqueeTaskFn() {
+    uint32_t now = millis();
+    if (contentMode == 1) {
+        if (marquee.update(now)) {
+            renderMarquee(dmd, marquee, TEXT_POS_Y);
+        }
+        return;
+    }
+    if (contentMode == MODE_FEED) {
+        if (feed.update(dmd, now)) {
+            feed.draw(dmd, 0, TEXT_POS_Y, dmd.width());
+        }
+        return;
+    }
+    for (uint8_t z = 0; z < ZONE_COUNT; z++) {
+        if (zoneMarquees[z].update(now)) {
+            zoneMarquees[z].draw(dmd, 0, z * ZONE_HEIGHT, dmd.width());
+        }
+    }
+}
+
+// Geri sayım: saniye değişince üst bant, çubukta sadece değişen sütunlar çizilir
+void countdownTaskFn() {
+    uint32_t remaining = countdownRemaining();
+    int16_t seconds = (remaining + 999) / 1000;
+    if (seconds != timeValue) {
+        timeValue = seconds;
+        renderTimeLine();
+    }
+    timeBar.update(dmd, remaining);
+}
+
+// Pano sırası: süresi dolan girdi yerine sıradakinin karesi kopyalanır
+void boardTaskFn() {
+    if (board.update(millis())) {
+        board.show(dmd);
+    }
+}
+
+void setup() {
+    Serial1.begin(115200);
+    Serial1.println("P10 LED Panel + Modbus RTU Test Başladı");
+    
+    // Paneli başlat
+    dmd.begin();
+    dmd.selectFont(SystemFont5x7);
+    dmd.clearScreen();
+    board.selectFont(SystemFont5x7);
+    priceHistory.place(0, ZONE_HEIGHT, dmd.width(), ZONE_HEIGHT);
+    timeBar.place(0, ZONE_HEIGHT + 1, dmd.width(), ZONE_HEIGHT - 2);
+    
+    // Modbus RTU setup
+    rs485.begin(MODBUS_BAUD);
+    mb.begin(MODBUS_SLAVE_ID, MODBUS_BAUD);
+    for (uint8_t z = 0; z < ZONE_COUNT; z++) {
+        zones[z].reset();
+        mb.addBank(ZONE_SLAVE_BASE + z, zones[z].holding, ZONE_REG_COUNT, nullptr, 0);
+    }
+    
+    // Başlangıç değerleri register haritasından (mod 1, 100 ms, 1500 TL, 60 sn, 16 piksel boşluk)
+    regs.reset();
+    storeText(0, texts[0]);
+    loadBoard(0xFF);
+
+    mb.onWrite(onRegistersWritten);
+    mb.setResponseLimit(hregs[REG_RESPONSE_LIMIT] * 1000UL);
+
+    // İçerik deposu (FC20/21)
+    content.begin();
+    mb.setFileStore(&fileStore);
+
+    scheduler.add(modbusTaskFn, 0);
+    marqueeTask = scheduler.add(marqueeTaskFn, MARQUEE_TICK_MS, false);
+    boardTask = scheduler.add(boardTaskFn, BOARD_TICK_MS, false);
+    countdownTask = scheduler.add(countdownTaskFn, COUNTDOWN_TICK_MS, false);
+    vmTask = scheduler.add(vmTaskFn, 0, false);
+    scheduler.add(statsTaskFn, 1000);
+
+    updateDisplayFromModbus();
+    
+    Serial1.println("Panel hazır, Modbus RTU Slave ID: " + String(MODBUS_SLAVE_ID) +
+                   " (bölgeler: " + String(ZONE_SLAVE_BASE) + "-" +
+                   String(ZONE_SLAVE_BASE + ZONE_COUNT - 1) + ")");
+    Serial1.println("Baud Rate: 9600, Parity: None, Stop Bits: 1");
+}
+
+void loop() {
+    scheduler.run(millis());
     
     delay(10); // CPU yükünü azalt
 }
@@ -18,10 +18,15 @@
  * Bu versiyon Modbus haberleşmesi kullanmadan sabit yazı gösterir.
  */
 
+
 #include <Arduino.h>
-#include <DMD2.h>
 #include <fonts/SystemFont5x7.h>
-#include <fonts/Arial_Black_16.h>
+
+#include "Marquee.h"
+#include "PanelDriver.h"
+#include "Scheduler.h"
+#include "TextFormat.h"
+#include "TextRenderer.h"
 
 // P10 Panel Pin Tanımlamaları
 #define DMD_PIN_A      16  // D0 - Row Address A
@@ -35,20 +40,30 @@
 #define DISPLAYS_WIDE 2   // Yatayda kaç panel (32x16 için 2 panel = 64 piksel genişlik)
 #define DISPLAYS_HIGH 1   // Dikeyde kaç panel (16 piksel yükseklik)
 
-// DMD2 Objesi
-SPIDMD dmd(DISPLAYS_WIDE, DISPLAYS_HIGH, DMD_PIN_nOE, DMD_PIN_A, DMD_PIN_B, DMD_PIN_STB);
+// Panel sürücüsü (geometri derleme zamanında sabit)
+PanelDriver<PanelGeometry<DISPLAYS_WIDE, DISPLAYS_HIGH> > dmd(DMD_PIN_nOE, DMD_PIN_A, DMD_PIN_B, DMD_PIN_STB);
+
+// Kayan yazı: kuyruk ile baş arası boşluk (piksel) ve şerit boyutu
+#define SCROLL_GAP       24
+#define MARQUEE_COLUMNS  384
+#define MARQUEE_ROWS     8
+
+// İki satır modu: üst ve alt 8 piksellik bantta ayrı hızda iki şerit
+#define ROW_MARQUEE_COLUMNS 192
+#define ROW_HEIGHT          8
+
+// Tüm kayan yazıları süren ortak görevin aralığı (ms)
+#define MARQUEE_TICK_MS 10
 
 // Global değişkenler
-String currentText = "MERHABA DUNYA!";
-String scrollText = "*** PlatformIO ESP8266 P10 LED Panel Projesi *** ";
-bool isScrolling = false;
-unsigned long lastUpdate = 0;
-unsigned long textChangeTimer = 0;
-int scrollPosition = 0;
-int textMode = 0;  // 0: Sabit yazı, 1: Kayan yazı, 2: Saat
+const char *scrollText = "*** PlatformIO ESP8266 P10 LED Panel Projesi ***";
+const char *topRowText = "HOSGELDINIZ";
+const char *bottomRowText = "ESP8266 + P10 LED PANEL";
+int textMode = 0;  // 0: Sabit yazı, 1: Kayan yazı, 2: Saat, 3: İki satır kayan yazı
+int cycleCount = 0;
 
 // Sabit yazılar listesi
-String staticTexts[] = {
+const char *const staticTexts[] = {
     "MERHABA",
     "DUNYA!",
     "ESP8266",
@@ -56,148 +71,59 @@ String staticTexts[] = {
     "PANEL",
     "PROJESI"
 };
-int staticTextCount = 6;
+const int staticTextCount = sizeof(staticTexts) / sizeof(staticTexts[0]);
 int currentStaticIndex = 0;
 
-void setup() {
-    Serial.begin(115200);
-    Serial.println();
-    Serial.println("P10 LED Panel - Sabit Yazı Versiyonu Başlatılıyor...");
-    
-    // DMD2 başlatma
-    dmd.setBrightness(50);  // Parlaklık ayarı (0-255)
-    dmd.selectFont(SystemFont5x7);  // Varsayılan font
-    dmd.begin();
-    
-    // Başlangıç ekranı
-    dmd.clearScreen();
-    dmd.drawString(0, 0, "BASLIYOR...");
-    delay(2000);
-    
-    Serial.println("P10 LED Panel hazır!");
-    Serial.println("Gösterilecek sabit yazılar:");
-    for(int i = 0; i < staticTextCount; i++) {
-        Serial.println("- " + staticTexts[i]);
-    }
-}
+Scheduler scheduler;
+Marquee<MARQUEE_COLUMNS, MARQUEE_ROWS> marquee;
+Marquee<ROW_MARQUEE_COLUMNS, ROW_HEIGHT> rowMarquees[2];
+int8_t scrollTask = -1;
 
-void loop() {
-    unsigned long currentTime = millis();
-    
-    // Her 3 saniyede bir yazıyı değiştir
-    if(currentTime - textChangeTimer >= 3000) {
-        textChangeTimer = currentTime;
-        
-        switch(textMode) {
-            case 0: // Sabit yazı modu
-                showStaticText();
-                break;
-                
-            case 1: // Kayan yazı modu
-                if(!isScrolling) {
-                    startScrolling();
-                }
-                break;
-                
-            case 2: // Saat modu
-                showTime();
-                break;
-        }
-        
-        // 5 cycle sonra modu değiştir
-        static int cycleCount = 0;
-        cycleCount++;
-        if(cycleCount >= 5) {
-            cycleCount = 0;
-            textMode = (textMode + 1) % 3;
-            isScrolling = false;
-            scrollPosition = 0;
-        }
-    }
-    
-    // Kayan yazı güncelleme
-    if(isScrolling && (currentTime - lastUpdate >= 100)) {
-        lastUpdate = currentTime;
-        updateScrolling();
-    }
-    
-    // Panel güncelleme
-    dmd.scanDisplayBySPI();
-    
-    // Serial monitor için bilgi
-    if(currentTime % 5000 < 50) {  // Her 5 saniyede bir
-        Serial.println("Aktif mod: " + String(textMode) + 
-                      " | Yazı: " + getCurrentDisplayText());
-    }
-    
-    delay(10);
-}
+char timeBuffer[12];
 
 void showStaticText() {
-    dmd.clearScreen();
-    
-    String text = staticTexts[currentStaticIndex];
-    
-    // Yazıyı ortalamak için pozisyon hesapla
-    int textWidth = text.length() * 6;  // Yaklaşık karakter genişliği
-    int x = (dmd.width() - textWidth) / 2;
-    int y = (dmd.height() - 7) / 2;  // Font yüksekliği 7
-    
-    if(x < 0) x = 0;
-    if(y < 0) y = 0;
-    
-    dmd.drawString(x, y, text);
-    
+    const char *text = staticTexts[currentStaticIndex];
+    renderCentered(dmd, text);
+
     // Sıradaki yazıya geç
     currentStaticIndex = (currentStaticIndex + 1) % staticTextCount;
-    
-    Serial.println("Sabit yazı gösteriliyor: " + text);
+
+    Serial.print("Sabit yazı gösteriliyor: ");
+    Serial.println(text);
 }
 
 void startScrolling() {
-    isScrolling = true;
-    scrollPosition = dmd.width();
-    dmd.clearScreen();
-    Serial.println("Kayan yazı başlatıldı: " + scrollText);
+    marquee.start(dmd, scrollText, SCROLL_GAP, 2);
+    marquee.setInterval(100);
+    scheduler.setEnabled(scrollTask, true);
+    renderMarquee(dmd, marquee, 4);
+    Serial.print("Kayan yazı başlatıldı: ");
+    Serial.println(scrollText);
 }
 
-void updateScrolling() {
-    dmd.clearScreen();
-    
-    // Yazıyı kayan pozisyonda göster
-    dmd.drawString(scrollPosition, 4, scrollText);
-    
-    // Pozisyonu güncelle
-    scrollPosition -= 2;
-    
-    // Yazı tamamen kaybolduğunda döngüyü başlat
-    int textWidth = scrollText.length() * 6;
-    if(scrollPosition < -textWidth) {
-        scrollPosition = dmd.width();
+// Üst satır hızlı, alt satır yavaş; ikisi de aynı görevden sürülür
+void startRowScrolling() {
+    rowMarquees[0].start(dmd, topRowText, SCROLL_GAP);
+    rowMarquees[0].setInterval(50);
+    rowMarquees[1].start(dmd, bottomRowText, SCROLL_GAP);
+    rowMarquees[1].setInterval(120);
+    scheduler.setEnabled(scrollTask, true);
+    for (uint8_t i = 0; i < 2; i++) {
+        rowMarquees[i].draw(dmd, 0, i * ROW_HEIGHT, dmd.width());
     }
+    Serial.println("İki satır kayan yazı başlatıldı");
 }
 
 void showTime() {
-    dmd.clearScreen();
-    
     // Basit bir saat simülasyonu (gerçek RTC olmadan)
-    unsigned long seconds = millis() / 1000;
-    int hours = (seconds / 3600) % 24;
-    int minutes = (seconds / 60) % 60;
-    int secs = seconds % 60;
-    
-    String timeStr = String(hours) + ":" + 
-                    (minutes < 10 ? "0" : "") + String(minutes) + ":" +
-                    (secs < 10 ? "0" : "") + String(secs);
-    
-    // Saati ortalayarak göster
-    int x = (dmd.width() - (timeStr.length() * 6)) / 2;
-    dmd.drawString(x, 4, timeStr);
-    
-    Serial.println("Saat gösteriliyor: " + timeStr);
+    formatClock(timeBuffer, sizeof(timeBuffer), millis() / 1000);
+    renderCentered(dmd, timeBuffer);
+
+    Serial.print("Saat gösteriliyor: ");
+    Serial.println(timeBuffer);
 }
 
-String getCurrentDisplayText() {
+const char *getCurrentDisplayText() {
     switch(textMode) {
         case 0:
             return staticTexts[currentStaticIndex];
@@ -205,27 +131,122 @@ String getCurrentDisplayText() {
             return scrollText;
         case 2:
             return "SAAT";
+        case 3:
+            return topRowText;
         default:
             return "BILINMEYEN";
     }
 }
 
+// Her 3 saniyede bir yazıyı değiştir, 5 cycle sonra modu değiştir
+void rotateTaskFn() {
+    switch(textMode) {
+        case 0: // Sabit yazı modu
+            showStaticText();
+            break;
+
+        case 1: // Kayan yazı modu
+            if(!marquee.active()) {
+                startScrolling();
+            }
+            break;
+
+        case 2: // Saat modu
+            showTime();
+            break;
+
+        case 3: // İki satır kayan yazı
+            if(!rowMarquees[0].active()) {
+                startRowScrolling();
+            }
+            break;
+    }
+
+    cycleCount++;
+    if(cycleCount >= 5) {
+        cycleCount = 0;
+        textMode = (textMode + 1) % 4;
+        marquee.stop();
+        rowMarquees[0].stop();
+        rowMarquees[1].stop();
+        scheduler.setEnabled(scrollTask, false);
+    }
+}
+
+// Kayan yazı güncelleme: tek görev tüm şeritleri kendi aralıklarında
+// ilerletir, sadece zamanı gelen şeridin bandı yeniden çizilir
+void scrollTaskFn() {
+    uint32_t now = millis();
+    if (marquee.update(now)) {
+        renderMarquee(dmd, marquee, 4);
+    }
+    for (uint8_t i = 0; i < 2; i++) {
+        if (rowMarquees[i].update(now)) {
+            rowMarquees[i].draw(dmd, 0, i * ROW_HEIGHT, dmd.width());
+        }
+    }
+}
+
+// Serial monitor için bilgi
+void statusTaskFn() {
+    Serial.print("Aktif mod: ");
+    Serial.print(textMode);
+    Serial.print(" | Yazı: ");
+    Serial.println(getCurrentDisplayText());
+}
+
+void setup() {
+    Serial.begin(115200);
+    Serial.println();
+    Serial.println("P10 LED Panel - Sabit Yazı Versiyonu Başlatılıyor...");
+    
+    // Panel başlatma
+    dmd.setBrightness(50);  // Parlaklık ayarı (0-255)
+    dmd.selectFont(SystemFont5x7);  // Varsayılan font
+    dmd.begin();
+    
+    // Başlangıç ekranı
+    dmd.clearScreen();
+    dmd.drawString(0, 0, "BASLIYOR...");
+    delay(2000);
+    
+    Serial.println("P10 LED Panel hazır!");
+    Serial.println("Gösterilecek sabit yazılar:");
+    for(int i = 0; i < staticTextCount; i++) {
+        Serial.print("- ");
+        Serial.println(staticTexts[i]);
+    }
+
+    scheduler.add(rotateTaskFn, 3000);
+    scrollTask = scheduler.add(scrollTaskFn, MARQUEE_TICK_MS, false);
+    scheduler.add(statusTaskFn, 5000);
+}
+
+void loop() {
+    scheduler.run(millis());
+    
+    delay(10);
+}
+
 /*
  * KULLANIM TALİMATLARI:
  * 
  * 1. Bu kod sabit yazıları döngüsel olarak gösterir
- * 2. 3 farklı mod vardır:
+ * 2. 4 farklı mod vardır:
  *    - Sabit yazı modu: Önceden tanımlı yazıları sırayla gösterir
  *    - Kayan yazı modu: Uzun bir yazıyı kayar şekilde gösterir
  *    - Saat modu: Basit bir saat gösterir
+ *    - İki satır modu: Üst ve alt satırda farklı hızda iki kayan yazı
  * 
  * 3. Yazıları değiştirmek için:
  *    - staticTexts[] dizisini düzenleyin
- *    - scrollText değişkenini değiştirin
+ *    - scrollText değişkenini değiştirin (kuyruk ile baş arası boşluk SCROLL_GAP)
+ *    - İki satır modu için topRowText ve bottomRowText
  * 
  * 4. Zamanlamaları ayarlamak için:
- *    - textChangeTimer kontrolündeki 3000 değerini değiştirin (ms)
- *    - scrolling update süresini 100ms'den farklı yapmak için değiştirin
+ *    - setup() içindeki rotateTaskFn aralığını (3000 ms) değiştirin
+ *    - Kayan yazı hızları setInterval() değerleridir (marquee 100 ms,
+ *      üst satır 50 ms, alt satır 120 ms)
  * 
  * 5. Panel boyutlarını ayarlamak için:
  *    - DISPLAYS_WIDE ve DISPLAYS_HIGH değerlerini değiştirin
@@ -0,0 +1,75 @@
+/*
+ * Arena birim testleri (host): geçersiz serbest bırakmalar reddedilir ve
+ * sayılır, blok iki sahibe verilmez.
+ *
+ *   pio test -e native_modbus
+ */
+
+#include <unity.h>
+
+#include <stdint.h>
+
+#include <new>
+
+#include "Arena.h"
+
+void setUp() {
+    // Her test boş bir havuzla başlar
+    new (&arena) Arena();
+}
+
+void tearDown() {}
+
+void test_double_free_is_rejected() {
+    void *a = arena.alloc(10);
+    TEST_ASSERT_NOT_NULL(a);
+    arena.free(a);
+    TEST_ASSERT_EQUAL_UINT16(0, arena.badFrees());
+
+    arena.free(a);
+    TEST_ASSERT_EQUAL_UINT16(1, arena.badFrees());
+    TEST_ASSERT_EQUAL_UINT8(0, arena.stats(0).used);
+
+    // İkinci free yığına girmediyse blok iki kez verilmez
+    void *b = arena.alloc(10);
+    void *c = arena.alloc(10);
+    TEST_ASSERT_TRUE(b != c);
+    TEST_ASSERT_EQUAL_UINT8(2, arena.stats(0).used);
+}
+
+void test_interior_pointer_is_rejected() {
+    uint8_t *a = (uint8_t *)arena.alloc(40);
+    TEST_ASSERT_NOT_NULL(a);
+    arena.free(a + 1);
+    TEST_ASSERT_EQUAL_UINT16(1, arena.badFrees());
+    TEST_ASSERT_EQUAL_UINT8(1, arena.stats(1).used);
+
+    arena.free(a);
+    TEST_ASSERT_EQUAL_UINT8(0, arena.stats(1).used);
+    TEST_ASSERT_EQUAL_UINT16(1, arena.badFrees());
+}
+
+void test_foreign_pointers_are_ignored() {
+    int local;
+    arena.free(nullptr);
+    arena.free(&local);
+    TEST_ASSERT_EQUAL_UINT16(0, arena.badFrees());
+}
+
+void test_pool_size_matches_classes() {
+    size_t total = 0;
+    for (uint8_t c = 0; c < Arena::CLASS_COUNT; c++) {
+        Arena::ClassStats s = arena.stats(c);
+        total += (size_t)s.blockSize * s.blocks;
+    }
+    TEST_ASSERT_EQUAL_UINT32(total, Arena::totalBytes());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_double_free_is_rejected);
+    RUN_TEST(test_interior_pointer_is_rejected);
+    RUN_TEST(test_foreign_pointers_are_ignored);
+    RUN_TEST(test_pool_size_matches_classes);
+    return UNITY_END();
+}
@@ -0,0 +1,322 @@
+/*
+ * RtuSlave birim testleri (host): CRC tablosu, t3.5 çerçeveleme,
+ * istisna yanıtları, halka sonunu aşan çerçeveler ve yanıt sınırı;
+ * BusAnalyzer'ın istek / yanıt ayrımı.
+ *
+ *   pio test -e native_modbus
+ */
+
+#include <unity.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#include <new>
+#include <vector>
+
+#include "BusAnalyzer.h"
+#include "FrameRing.h"
+#include "ModbusCrc.h"
+#include "RtuSlave.h"
+
+// Gönderilen son yanıt
+struct CaptureTransport : RtuTransport {
+    std::vector<uint8_t> last;
+    uint32_t sent = 0;
+
+    void send(const uint8_t *data, uint16_t len) override {
+        last.assign(data, data + len);
+        sent++;
+    }
+};
+
+static const uint32_t BAUD = 9600;
+static const uint32_t CHAR_US = 11000000UL / BAUD;  // 11 bit
+
+static CaptureTransport transport;
+static uint16_t holding[16];
+static uint16_t input[4];
+static RtuSlave *slave;
+static uint8_t slaveMemory[sizeof(RtuSlave)] __attribute__((aligned(8)));
+static uint32_t now;
+
+void setUp() {
+    transport.last.clear();
+    transport.sent = 0;
+    memset(holding, 0, sizeof(holding));
+    memset(input, 0, sizeof(input));
+    // Her test temiz bir slave ile başlar (sayaçlar, halka, önbellek)
+    slave = new (slaveMemory) RtuSlave(transport, holding, 16, input, 4);
+    slave->begin(1, BAUD);
+    now = 1000;
+}
+
+void tearDown() {
+    slave->~RtuSlave();
+}
+
+// Bit bit CRC (tablonun doğrulandığı referans)
+static uint16_t crcBitwise(const uint8_t *data, size_t len) {
+    uint16_t crc = MODBUS_CRC_INIT;
+    while (len--) {
+        crc ^= *data++;
+        for (uint8_t i = 0; i < 8; i++) {
+            crc = crc & 1 ? (crc >> 1) ^ 0xA001 : crc >> 1;
+        }
+    }
+    return crc;
+}
+
+// CRC eklenmiş çerçeve
+static std::vector<uint8_t> frame(std::vector<uint8_t> body) {
+    uint16_t crc = modbusCrc(body.data(), body.size());
+    body.push_back(crc & 0xFF);
+    body.push_back(crc >> 8);
+    return body;
+}
+
+// Baytları karakter süresi aralıkla gönder
+static void sendBytes(const std::vector<uint8_t> &bytes) {
+    for (uint8_t b : bytes) {
+        slave->receive(b, now);
+        now += CHAR_US;
+    }
+}
+
+// Çerçeveyi gönder, sessizliği bekleyip işlet
+static void request(const std::vector<uint8_t> &body) {
+    sendBytes(frame(body));
+    now += slave->silenceUs();
+    slave->task(now);
+}
+
+static bool replyIs(const std::vector<uint8_t> &body) {
+    return transport.last == frame(body);
+}
+
+void test_crc_table_matches_bitwise() {
+    uint8_t buf[256];
+    for (int i = 0; i < 256; i++) {
+        buf[i] = (uint8_t)i;
+        TEST_ASSERT_EQUAL_HEX16(crcBitwise(buf + i, 1), modbusCrc(buf + i, 1));
+    }
+    uint32_t seed = 1;
+    for (int i = 0; i < 256; i++) {
+        seed = seed * 1664525 + 1013904223;
+        buf[i] = seed >> 24;
+    }
+    for (size_t len = 0; len <= sizeof(buf); len += 17) {
+        TEST_ASSERT_EQUAL_HEX16(crcBitwise(buf, len), modbusCrc(buf, len));
+    }
+}
+
+void test_crc_known_vector_and_chaining() {
+    // Spesifikasyon örneği: 01 03 00 00 00 0A -> C5 CD
+    const uint8_t req[] = { 0x01, 0x03, 0x00, 0x00, 0x00, 0x0A };
+    TEST_ASSERT_EQUAL_HEX16(0xCDC5, modbusCrc(req, sizeof(req)));
+    // Parçalı hesap tek seferlikle aynı
+    TEST_ASSERT_EQUAL_HEX16(modbusCrc(req, 6), modbusCrc(req + 2, 4, modbusCrc(req, 2)));
+}
+
+void test_silence_threshold() {
+    TEST_ASSERT_EQUAL_UINT32(38500000UL / 9600, slave->silenceUs());
+    slave->begin(1, 115200);
+    TEST_ASSERT_EQUAL_UINT32(1750, slave->silenceUs());
+}
+
+void test_frame_closes_only_after_t35() {
+    holding[0] = 0x1234;
+    sendBytes(frame({ 1, 3, 0, 0, 0, 1 }));
+    // Sessizlik t3.5'ten kısa: çerçeve henüz kapanmaz
+    slave->task(now + slave->silenceUs() - CHAR_US - 1);
+    TEST_ASSERT_EQUAL_UINT32(0, transport.sent);
+    slave->task(now + slave->silenceUs());
+    TEST_ASSERT_EQUAL_UINT32(1, transport.sent);
+    TEST_ASSERT_TRUE(replyIs({ 1, 3, 2, 0x12, 0x34 }));
+}
+
+void test_gap_shorter_than_t35_keeps_frame() {
+    // t1.5 ile t3.5 arasındaki boşluk çerçeveyi bölmez
+    std::vector<uint8_t> f = frame({ 1, 3, 0, 0, 0, 1 });
+    sendBytes(std::vector<uint8_t>(f.begin(), f.begin() + 3));
+    now += slave->silenceUs() - 2 * CHAR_US;
+    sendBytes(std::vector<uint8_t>(f.begin() + 3, f.end()));
+    now += slave->silenceUs();
+    slave->task(now);
+    TEST_ASSERT_EQUAL_UINT32(1, transport.sent);
+    TEST_ASSERT_EQUAL_UINT16(0, slave->diagnostics().crcErrors);
+}
+
+void test_gap_of_t35_splits_frames() {
+    // Toplu okunan baytlarda iki çerçeve zaman damgasındaki sessizlikle ayrılır
+    sendBytes(frame({ 1, 6, 0, 2, 0, 7 }));
+    now += slave->silenceUs();
+    sendBytes(frame({ 1, 3, 0, 2, 0, 1 }));
+    now += slave->silenceUs();
+    slave->task(now);
+    TEST_ASSERT_EQUAL_UINT32(2, transport.sent);
+    TEST_ASSERT_EQUAL_UINT16(7, holding[2]);
+    TEST_ASSERT_TRUE(replyIs({ 1, 3, 2, 0, 7 }));
+}
+
+void test_bad_crc_is_ignored() {
+    std::vector<uint8_t> f = frame({ 1, 3, 0, 0, 0, 1 });
+    f.back() ^= 1;
+    sendBytes(f);
+    now += slave->silenceUs();
+    slave->task(now);
+    TEST_ASSERT_EQUAL_UINT32(0, transport.sent);
+    TEST_ASSERT_EQUAL_UINT16(1, slave->diagnostics().crcErrors);
+}
+
+void test_exception_illegal_function() {
+    request({ 1, 0x2B, 0, 0 });
+    TEST_ASSERT_TRUE(replyIs({ 1, 0xAB, RtuSlave::EX_ILLEGAL_FUNCTION }));
+}
+
+void test_exception_illegal_address() {
+    request({ 1, 3, 0, 15, 0, 2 });
+    TEST_ASSERT_TRUE(replyIs({ 1, 0x83, RtuSlave::EX_ILLEGAL_ADDRESS }));
+    request({ 1, 6, 0, 16, 0, 1 });
+    TEST_ASSERT_TRUE(replyIs({ 1, 0x86, RtuSlave::EX_ILLEGAL_ADDRESS }));
+}
+
+void test_exception_illegal_value() {
+    request({ 1, 3, 0, 0, 0, 0 });
+    TEST_ASSERT_TRUE(replyIs({ 1, 0x83, RtuSlave::EX_ILLEGAL_VALUE }));
+    // Bayt sayısı register sayısıyla uyuşmuyor
+    request({ 1, 16, 0, 0, 0, 2, 3, 0, 1, 0 });
+    TEST_ASSERT_TRUE(replyIs({ 1, 0x90, RtuSlave::EX_ILLEGAL_VALUE }));
+    TEST_ASSERT_EQUAL_UINT16(2, slave->diagnostics().exceptions);
+}
+
+void test_no_reply_to_broadcast_or_other_unit() {
+    request({ 0, 6, 0, 1, 0, 5 });
+    request({ 0, 0x2B, 0, 0 });
+    request({ 9, 3, 0, 0, 0, 1 });
+    TEST_ASSERT_EQUAL_UINT32(0, transport.sent);
+    TEST_ASSERT_EQUAL_UINT16(5, holding[1]);
+}
+
+void test_frame_view_wraparound() {
+    FrameRing ring;
+    // Yazma indeksini halka sonuna yaklaştır
+    for (uint16_t i = 0; i < FRAME_RING_SIZE - 3; i++) {
+        ring.push(0);
+    }
+    ring.consume(FRAME_RING_SIZE - 3);
+    std::vector<uint8_t> f = frame({ 1, 3, 0x12, 0x34, 0, 1 });
+    uint16_t start = ring.writeIndex();
+    for (uint8_t b : f) {
+        TEST_ASSERT_TRUE(ring.push(b));
+    }
+    TEST_ASSERT_TRUE(ring.writeIndex() < start);
+
+    FrameView view(ring, start, f.size());
+    TEST_ASSERT_EQUAL_UINT16(f.size(), view.length());
+    for (uint16_t i = 0; i < f.size(); i++) {
+        TEST_ASSERT_EQUAL_HEX8(f[i], view[i]);
+    }
+    // u16 ve CRC halka sınırının iki yanındaki baytları birleştirir
+    TEST_ASSERT_EQUAL_HEX16(0x1234, view.u16(2));
+    TEST_ASSERT_TRUE(view.crcValid());
+    ring.push(0);
+    FrameView shifted(ring, start + 1, f.size());
+    TEST_ASSERT_FALSE(shifted.crcValid());
+}
+
+void test_slave_across_ring_end() {
+    // Halkayı birkaç kez dolaşan istekler doğru yanıtlanır
+    holding[3] = 0xBEEF;
+    for (uint16_t i = 0; i < 3 * FRAME_RING_SIZE / 8; i++) {
+        request({ 1, 3, 0, 3, 0, 1 });
+        TEST_ASSERT_TRUE(replyIs({ 1, 3, 2, 0xBE, 0xEF }));
+        request({ 1, 6, 0, 4, (uint8_t)(i >> 8), (uint8_t)i });
+        TEST_ASSERT_EQUAL_UINT16(i, holding[4]);
+    }
+    TEST_ASSERT_EQUAL_UINT16(0, slave->diagnostics().crcErrors);
+    TEST_ASSERT_EQUAL_UINT32(0, slave->rxRing().overrunCount());
+}
+
+void test_late_request_gets_no_reply() {
+    slave->setResponseLimit(10000);
+    holding[0] = 0x1234;
+    // Sınır içinde işlenen istek yanıtlanır
+    request({ 1, 3, 0, 0, 0, 1 });
+    TEST_ASSERT_EQUAL_UINT32(1, transport.sent);
+
+    // Kuyrukta sınırdan uzun bekleyen okuma: yanıt yok
+    sendBytes(frame({ 1, 3, 0, 0, 0, 1 }));
+    now += 10001;
+    slave->task(now);
+    TEST_ASSERT_EQUAL_UINT32(1, transport.sent);
+    TEST_ASSERT_EQUAL_UINT32(1, slave->queueStats(RtuSlave::CLASS_READ).late);
+
+    // Geç yazma yine uygulanır, yanıtı gönderilmez
+    sendBytes(frame({ 1, 6, 0, 5, 0, 9 }));
+    now += 10001;
+    slave->task(now);
+    TEST_ASSERT_EQUAL_UINT32(1, transport.sent);
+    TEST_ASSERT_EQUAL_UINT16(9, holding[5]);
+    TEST_ASSERT_EQUAL_UINT32(1, slave->queueStats(RtuSlave::CLASS_WRITE).late);
+    TEST_ASSERT_EQUAL_UINT16(2, slave->diagnostics().noResponses);
+}
+
+// Okuma isteği (8 bayt) ve 1 register'lık yanıtı, arada 5 ms
+static void poll(BusAnalyzer &analyzer, uint16_t address) {
+    std::vector<uint8_t> req = frame({ 5, 3, (uint8_t)(address >> 8), (uint8_t)address, 0, 1 });
+    std::vector<uint8_t> rsp = frame({ 5, 3, 2, 0x12, 0x34 });
+    now += req.size() * CHAR_US;
+    analyzer.record(TrafficSink::DIR_RX, now, req.data(), req.size());
+    now += 5000 + rsp.size() * CHAR_US;
+    analyzer.record(TrafficSink::DIR_RX, now, rsp.data(), rsp.size());
+    now += 50000;
+}
+
+// 0x03xx adresli okuma isteği yanıt biçimine de uyar (5 + 3 = 8 bayt)
+void test_analyzer_read_request_at_0x0300() {
+    BusAnalyzer analyzer(BAUD);
+    for (uint8_t i = 0; i < 5; i++) {
+        poll(analyzer, 0x0300);
+    }
+    const BusAnalyzer::SlaveStats *s = analyzer.slave(5);
+    TEST_ASSERT_NOT_NULL(s);
+    TEST_ASSERT_EQUAL_UINT32(5, s->requests);
+    TEST_ASSERT_EQUAL_UINT32(5, s->responses);
+    TEST_ASSERT_EQUAL_UINT32(0, s->late);
+    TEST_ASSERT_EQUAL_UINT32(0, s->timeouts);
+}
+
+// Sınırdan sonra gelen okuma yanıtı yine geç yanıttır
+void test_analyzer_stray_read_response_is_late() {
+    BusAnalyzer analyzer(BAUD);
+    analyzer.setResponseLimit(100000);
+    poll(analyzer, 0x0010);
+    std::vector<uint8_t> rsp = frame({ 5, 3, 2, 0x12, 0x34 });
+    now += 200000;
+    analyzer.record(TrafficSink::DIR_RX, now, rsp.data(), rsp.size());
+    const BusAnalyzer::SlaveStats *s = analyzer.slave(5);
+    TEST_ASSERT_EQUAL_UINT32(1, s->requests);
+    TEST_ASSERT_EQUAL_UINT32(1, s->late);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_crc_table_matches_bitwise);
+    RUN_TEST(test_crc_known_vector_and_chaining);
+    RUN_TEST(test_silence_threshold);
+    RUN_TEST(test_frame_closes_only_after_t35);
+    RUN_TEST(test_gap_shorter_than_t35_keeps_frame);
+    RUN_TEST(test_gap_of_t35_splits_frames);
+    RUN_TEST(test_bad_crc_is_ignored);
+    RUN_TEST(test_exception_illegal_function);
+    RUN_TEST(test_exception_illegal_address);
+    RUN_TEST(test_exception_illegal_value);
+    RUN_TEST(test_no_reply_to_broadcast_or_other_unit);
+    RUN_TEST(test_frame_view_wraparound);
+    RUN_TEST(test_slave_across_ring_end);
+    RUN_TEST(test_late_request_gets_no_reply);
+    RUN_TEST(test_analyzer_read_request_at_0x0300);
+    RUN_TEST(test_analyzer_stray_read_response_is_late);
+    return UNITY_END();
+}